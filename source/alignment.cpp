@@ -91,6 +91,12 @@ alignment::alignment(void) {
   /* Minimum block size in the new alignment */
   blockSize = 0;
 
+  /* Pairwise matrices are computed by a single thread by default */
+  threadsNumber = 1;
+
+  /* Trimming methods build the trimmed alignment by default */
+  selectionOnly = false;
+
   /* Is this alignmnet new? */
   oldAlignment  = false;
 
@@ -114,6 +120,8 @@ alignment::alignment(void) {
   sgaps =     NULL;
   scons =     NULL;
   seqMatrix = NULL;
+  packedSeqs = NULL;
+  residueColumns = NULL;
 
   identities = NULL;
   overlaps = NULL;
@@ -130,11 +138,10 @@ alignment::alignment(string o_filename, string o_aligInfo, string *o_sequences,
                      bool o_shortNames, int o_dataType, int o_isAligned, bool o_reverse, bool o_terminalGapOnly,
                      int o_left_boundary, int o_right_boundary,
                      bool o_keepSeqs, bool o_keepHeader, int OldSequences, int OldResidues, int *o_residuesNumber,
-                     int *o_saveResidues, int *o_saveSequences, int o_ghWindow, int o_shWindow, int o_blockSize,
-                     float **o_identities, float **o_overlaps) {
+                     int *o_saveResidues, int *o_saveSequences, int o_ghWindow, int o_shWindow, int o_blockSize) {
 
   /* ***** ***** ***** ***** ***** ***** ***** ***** */
-  int i, j, k, ll;
+  int i, j;
   /* ***** ***** ***** ***** ***** ***** ***** ***** */
 
   oldAlignment = true;
@@ -155,6 +162,9 @@ alignment::alignment(string o_filename, string o_aligInfo, string *o_sequences,
 
   blockSize = o_blockSize;
 
+  threadsNumber = 1;
+  selectionOnly = false;
+
   isAligned = o_isAligned;
   reverse   = o_reverse;
 
@@ -177,14 +187,18 @@ alignment::alignment(string o_filename, string o_aligInfo, string *o_sequences,
 
 
   /* ***** ***** ***** ***** ***** ***** ***** ***** */
-  /* Basic information for the new alignment */
+  /* Basic information for the new alignment. The
+   * trimming methods fill the sequences and their
+   * names in place, so they do not give them */
   sequences = new string[sequenNumber];
-  for(i = 0; i < sequenNumber; i++)
-    sequences[i] = o_sequences[i];
+  if(o_sequences != NULL)
+    for(i = 0; i < sequenNumber; i++)
+      sequences[i] = o_sequences[i];
 
   seqsName = new string[sequenNumber];
-  for(i = 0; i < sequenNumber; i++)
-    seqsName[i] = o_seqsName[i];
+  if(o_seqsName != NULL)
+    for(i = 0; i < sequenNumber; i++)
+      seqsName[i] = o_seqsName[i];
   /* ***** ***** ***** ***** ***** ***** ***** ***** */
 
   /* ***** ***** ***** ***** ***** ***** ***** ***** */
@@ -226,42 +240,6 @@ alignment::alignment(string o_filename, string o_aligInfo, string *o_sequences,
   }
   /* ***** ***** ***** ***** ***** ***** ***** ***** */
 
-  /* ***** ***** ***** ***** ***** ***** ***** ***** */
-  identities = NULL;
-  if(o_identities != NULL) {
-    identities = new float*[sequenNumber];
-    for(i = 0, j = 0; i < OldSequences; i++) {
-      if(o_saveSequences[i] != -1) {
-        identities[j] = new float[sequenNumber];
-        for(k = 0, ll = 0; k < OldSequences; k++) {
-          if(o_saveSequences[k] != -1) {
-            identities[j][ll] = o_identities[i][k];
-            ll++;
-          }
-        }
-        j++;
-      }
-    }
-  }
-
-  overlaps = NULL;
-  if(o_overlaps != NULL) {
-    overlaps = new float*[sequenNumber];
-    for(i = 0, j = 0; i < OldSequences; i++) {
-      if(o_saveSequences[i] != -1) {
-        overlaps[j] = new float[sequenNumber];
-        for(k = 0, ll = 0; k < OldSequences; k++) {
-          if(o_saveSequences[k] != -1) {
-            overlaps[j][ll] = o_overlaps[i][k];
-            ll++;
-          }
-        }
-        j++;
-      }
-    }
-  }
-  /* ***** ***** ***** ***** ***** ***** ***** ***** */
-
   /* ***** ***** ***** ***** ***** ***** ***** ***** */
   /* Any structure associated to the new alignment is
    * initialize to NULL. In this way, these structure,
@@ -269,7 +247,10 @@ alignment::alignment(string o_filename, string o_aligInfo, string *o_sequences,
   sgaps  =     NULL;
   scons  =     NULL;
   seqMatrix =  NULL;
+  packedSeqs = NULL;
+  residueColumns = NULL;
   identities = NULL;
+  overlaps = NULL;
   /* ***** ***** ***** ***** ***** ***** ***** ***** */
 }
 
@@ -278,7 +259,7 @@ alignment::alignment(string o_filename, string o_aligInfo, string *o_sequences,
 /* ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** */
 
 alignment &alignment::operator=(const alignment &old) {
-  int i, j;
+  int i;
 
   if(this != &old) {
 
@@ -307,6 +288,9 @@ alignment &alignment::operator=(const alignment &old) {
 
     blockSize = old.blockSize;
 
+    threadsNumber = old.threadsNumber;
+    selectionOnly = old.selectionOnly;
+
     filename = old.filename;
     aligInfo = old.aligInfo;
     /* ***** ***** ***** ***** ***** ***** ***** ***** */
@@ -321,10 +305,12 @@ alignment &alignment::operator=(const alignment &old) {
     gapSymbol = old.gapSymbol;
 
     /* ***** ***** ***** ***** ***** ***** ***** ***** */
+    delete [] sequences;
     sequences = new string[sequenNumber];
     for(i = 0; i < sequenNumber; i++)
       sequences[i] = old.sequences[i];
 
+    delete [] seqsName;
     seqsName = new string[sequenNumber];
     for(i = 0; i < sequenNumber; i++)
       seqsName[i] = old.seqsName[i];
@@ -336,7 +322,7 @@ alignment &alignment::operator=(const alignment &old) {
       residuesNumber = new int[sequenNumber];
       for(i = 0; i < sequenNumber; i++)
         residuesNumber[i] = old.residuesNumber[i];
-    } residuesNumber = NULL;
+    } else residuesNumber = NULL;
     /* ***** ***** ***** ***** ***** ***** ***** ***** */
 
     /* ***** ***** ***** ***** ***** ***** ***** ***** */
@@ -363,27 +349,15 @@ alignment &alignment::operator=(const alignment &old) {
     /* ***** ***** ***** ***** ***** ***** ***** ***** */
 
     /* ***** ***** ***** ***** ***** ***** ***** ***** */
-    delete [] identities;
-    if(old.identities) {
-      identities = new float*[sequenNumber];
-      for(i = 0; i < sequenNumber; i++) {
-        identities[i] = new float[sequenNumber];
-        for(j = 0; j < sequenNumber; j++)
-          identities[i][j] = old.identities[i][j];
-      }
-    } else identities = NULL;
+    /* Identities are computed again, if needed, from the copied sequences */
+    delete identities;
+    identities = NULL;
     /* ***** ***** ***** ***** ***** ***** ***** ***** */
 
     /* ***** ***** ***** ***** ***** ***** ***** ***** */
-    delete [] overlaps;
-    if(old.overlaps) {
-      overlaps = new float*[sequenNumber];
-      for(i = 0; i < sequenNumber; i++) {
-        overlaps[i] = new float[sequenNumber];
-        for(j = 0; j < sequenNumber; j++)
-          overlaps[i][j] = old.overlaps[i][j];
-      }
-    } else overlaps = NULL;
+    /* As well as the overlaps */
+    delete overlaps;
+    overlaps = NULL;
     /* ***** ***** ***** ***** ***** ***** ***** ***** */
 
     /* ***** ***** ***** ***** ***** ***** ***** ***** */
@@ -393,8 +367,16 @@ alignment &alignment::operator=(const alignment &old) {
     delete scons;
     scons = NULL;
 
+    /* The sequences matrix is built again from the copied sequences as well,
+     * since it can not be owned by both alignments */
     delete seqMatrix;
-    seqMatrix = old.seqMatrix;
+    seqMatrix = NULL;
+
+    delete packedSeqs;
+    packedSeqs = NULL;
+
+    delete[] residueColumns;
+    residueColumns = NULL;
     /* ***** ***** ***** ***** ***** ***** ***** ***** */
   }
   /* ***** ***** ***** ***** ***** ***** ***** ***** */
@@ -406,7 +388,6 @@ alignment &alignment::operator=(const alignment &old) {
 /* ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** */
 
 alignment::~alignment(void) {
-  int i;
 
   /* ***** ***** ***** ***** ***** ***** ***** ***** */
   if(sequences != NULL)
@@ -439,20 +420,14 @@ alignment::~alignment(void) {
   /* ***** ***** ***** ***** ***** ***** ***** ***** */
 
   /* ***** ***** ***** ***** ***** ***** ***** ***** */
-  if(identities != NULL) {
-    for(i = 0; i < sequenNumber; i++)
-      delete [] identities[i];
-    delete [] identities;
-  }
+  if(identities != NULL)
+    delete identities;
   identities = NULL;
   /* ***** ***** ***** ***** ***** ***** ***** ***** */
 
   /* ***** ***** ***** ***** ***** ***** ***** ***** */
-  if(overlaps != NULL) {
-    for(i = 0; i < sequenNumber; i++)
-      delete [] overlaps[i];
-    delete [] overlaps;
-  }
+  if(overlaps != NULL)
+    delete overlaps;
   overlaps = NULL;
   /* ***** ***** ***** ***** ***** ***** ***** ***** */
 
@@ -468,6 +443,14 @@ alignment::~alignment(void) {
   if(seqMatrix != NULL)
     delete seqMatrix;
   seqMatrix = NULL;
+
+  if(packedSeqs != NULL)
+    delete packedSeqs;
+  packedSeqs = NULL;
+
+  if(residueColumns != NULL)
+    delete[] residueColumns;
+  residueColumns = NULL;
   /* ***** ***** ***** ***** ***** ***** ***** ***** */
 
   /* ***** ***** ***** ***** ***** ***** ***** ***** */
@@ -502,30 +485,59 @@ alignment::~alignment(void) {
 // Try to load current alignment and inform otherwise
 bool alignment::loadAlignment(char *alignmentFile) {
 
-  // Detect input alignment format - it is an strict detection procedure
-  iformat = formatInputAlignment(alignmentFile);
+  lineReader file;
+
+  return readAlignment(file, file.open(alignmentFile), alignmentFile);
+}
+
+// Load an alignment whose content is already in memory
+bool alignment::loadAlignment(char *alignmentName, const char *data, long size) {
+
+  lineReader file;
+
+  return readAlignment(file, file.openMemory(data, size), alignmentName);
+}
+
+// Detect the format of an opened alignment and load it
+bool alignment::readAlignment(lineReader &file, bool opened, char *alignmentFile) {
+
+  // Check the file and its content. The same reader is used for both, format
+  // detection and alignment loading
+  iformat = 0;
+  if(opened)
+    // Detect input alignment format - it is an strict detection procedure
+    iformat = formatInputAlignment(file);
   // Unless it is indicated somewhere else, output alignment format will be
   // the same as the input one
   oformat = iformat;
 
+  // Move the reader back to the beginning of the input file
+  if((iformat != 0) && (!file.rewind()))
+    return false;
+
+  // Only clustal, mega and NBRF/PIR loaders read the input file twice. For
+  // the rest of formats, streamed input is read exactly once
+  if((iformat == 8) || (iformat == 11) || (iformat == 12) || (iformat == 17))
+    file.forgetHistory();
+
   // Use the appropiate function to read input alignment
   switch(iformat) {
     case 1:
-      return loadClustalAlignment(alignmentFile);
+      return loadClustalAlignment(file, alignmentFile);
     case 3:
-      return loadNBRF_PirAlignment(alignmentFile);
+      return loadNBRF_PirAlignment(file, alignmentFile);
     case 8:
-      return loadFastaAlignment(alignmentFile);
+      return loadFastaAlignment(file, alignmentFile);
     case 11:
-      return loadPhylip3_2Alignment(alignmentFile);
+      return loadPhylip3_2Alignment(file, alignmentFile);
     case 12:
-      return loadPhylipAlignment(alignmentFile);
+      return loadPhylipAlignment(file, alignmentFile);
     case 17:
-      return loadNexusAlignment(alignmentFile);
+      return loadNexusAlignment(file, alignmentFile);
     case 21:
-      return loadMegaInterleavedAlignment(alignmentFile);
+      return loadMegaInterleavedAlignment(file, alignmentFile);
     case 22:
-      return loadMegaNonInterleavedAlignment(alignmentFile);
+      return loadMegaNonInterleavedAlignment(file, alignmentFile);
   // Return a FALSE value - meaning the input alignment was not loaded
     default:
       return false;
@@ -554,6 +566,13 @@ int alignment::typeInputFile(void) {
  * appropiate function depending on the output format */
 /* ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** */
 bool alignment::printAlignment(void){
+  return printAlignment(cout);
+}
+
+/* ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** */
+/* This function writes the alignment to a given stream */
+/* ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** */
+bool alignment::printAlignment(ostream &output){
 
   /* ***** ***** ***** ***** ***** ***** ***** ***** */
   if(sequences == NULL)
@@ -569,34 +588,34 @@ bool alignment::printAlignment(void){
   /* ***** ***** ***** ***** ***** ***** ***** ***** */
   switch(oformat) {
     case 1:
-      alignmentClustalToFile(cout);
+      alignmentClustalToFile(output);
       break;
     case 3:
-      alignmentNBRF_PirToFile(cout);
+      alignmentNBRF_PirToFile(output);
       break;
     case 8:
-      alignmentFastaToFile(cout);
+      alignmentFastaToFile(output);
       break;
     case 11:
-      alignmentPhylip3_2ToFile(cout);
+      alignmentPhylip3_2ToFile(output);
       break;
     case 12:
-      alignmentPhylipToFile(cout);
+      alignmentPhylipToFile(output);
       break;
     case 13:
-      alignmentPhylip_PamlToFile(cout);
+      alignmentPhylip_PamlToFile(output);
       break;
     case 17:
-      alignmentNexusToFile(cout);
+      alignmentNexusToFile(output);
       break;
     case 21: case 22:
-      alignmentMegaToFile(cout);
+      alignmentMegaToFile(output);
       break;
     case 99:
-      getSequences(cout);
+      getSequences(output);
       break;
     case 100:
-      alignmentColourHTML(cout);
+      alignmentColourHTML(output);
       break;
     default:
       return false;
@@ -610,7 +629,10 @@ bool alignment::printAlignment(void){
 /* ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** */
 bool alignment::saveAlignment(char *destFile) {
 
+  compressedBuffer packedFile;
+  ostream output(NULL);
   ofstream file;
+  int compression;
   /* ***** ***** ***** ***** ***** ***** ***** ***** */
   if(sequences == NULL)
     return false;
@@ -635,10 +657,29 @@ bool alignment::saveAlignment(char *destFile) {
     }
   }
 
+  /* A single dash stands for the standard output */
+  if(!strcmp(destFile, "-"))
+    return printAlignment();
+
   /* ***** ***** ***** ***** ***** ***** ***** ***** */
-  /* File open and correct open check */
-  file.open(destFile);
-  if(!file) return false;
+  /* File open and correct open check. Compressed output is chosen depending
+   * on the output file extension */
+  compression = compressedBuffer::compressionByName(destFile);
+  if(compression != NOCOMPRESSION) {
+    if(!compressedBuffer::isSupported(compression)) {
+      cerr << endl << "ERROR: This build does not support "
+           << (compression == GZIPFILE ? "gzip" : "zstd")
+           << " compressed output files." << endl << endl;
+      return false;
+    }
+    if(!packedFile.open(destFile, compression)) return false;
+    output.rdbuf(&packedFile);
+  }
+  else {
+    file.open(destFile);
+    if(!file) return false;
+    output.rdbuf(file.rdbuf());
+  }
   /* ***** ***** ***** ***** ***** ***** ***** ***** */
 
   /* ***** ***** ***** ***** ***** ***** ***** ***** */
@@ -646,34 +687,34 @@ bool alignment::saveAlignment(char *destFile) {
    * appropiate function */
   switch(oformat) {
     case 1:
-      alignmentClustalToFile(file);
+      alignmentClustalToFile(output);
       break;
     case 3:
-      alignmentNBRF_PirToFile(file);
+      alignmentNBRF_PirToFile(output);
       break;
     case 8:
-      alignmentFastaToFile(file);
+      alignmentFastaToFile(output);
       break;
     case 11:
-      alignmentPhylip3_2ToFile(file);
+      alignmentPhylip3_2ToFile(output);
       break;
     case 12:
-      alignmentPhylipToFile(file);
+      alignmentPhylipToFile(output);
       break;
     case 13:
-      alignmentPhylip_PamlToFile(file);
+      alignmentPhylip_PamlToFile(output);
       break;
     case 17:
-      alignmentNexusToFile(file);
+      alignmentNexusToFile(output);
       break;
     case 21: case 22:
-      alignmentMegaToFile(file);
+      alignmentMegaToFile(output);
       break;
     case 99:
-      getSequences(file);
+      getSequences(output);
       break;
     case 100:
-      alignmentColourHTML(file);
+      alignmentColourHTML(output);
       break;
     default:
       return false;
@@ -682,7 +723,11 @@ bool alignment::saveAlignment(char *destFile) {
 
   /* ***** ***** ***** ***** ***** ***** ***** ***** */
   /* Close the output file */
-  file.close();
+  if(compression != NOCOMPRESSION) {
+    if(!packedFile.close()) return false;
+  }
+  else
+    file.close();
 
   /* ***** ***** ***** ***** ***** ***** ***** ***** */
   /* All is OK, return true */
@@ -1131,7 +1176,7 @@ alignment *alignment::cleanNoAllGaps(bool complementarity) {
 /* ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** */
 bool alignment::calculateSpuriousVector(float overlap, float *spuriousVector) {
 
-  int i, j, k, seqValue, ovrlap, hit;
+  int i, j, k, seqValue, ovrlap, *hits;
   float floatOverlap;
   char indet;
 
@@ -1161,63 +1206,29 @@ bool alignment::calculateSpuriousVector(float overlap, float *spuriousVector) {
 
   /* ***** ***** ***** ***** ***** ***** ***** ***** */
   /* For each alignment's sequence, computes its overlap */
-  for(i = 0, seqValue = 0; i < sequenNumber; i++, seqValue = 0) {
+  hits = new int[residNumber];
+  for(i = 0; i < sequenNumber; i++) {
 
     /* ***** ***** ***** ***** ***** ***** ***** ***** */
-    /* For each alignment's column, computes the overlap
-     * between the selected sequence and the other ones */
-    for(j = 0; j < residNumber; j++) {
-
-      /* ***** ***** ***** ***** ***** ***** ***** ***** */
-      /* For sequences are before the sequence selected */
-      for(k = 0, hit = 0; k < i; k++) {
-
-        /* ***** ***** ***** ***** ***** ***** ***** ***** */
-        /* If the element of sequence selected is the same
-         * that the element of sequence considered, computes
-         * a hit */
-        if(sequences[i][j] == sequences[k][j])
-          hit++;
-
-        /* If the element of sequence selected isn't a 'X' nor
-         * 'N' (indetermination) or a '-' (gap) and the element
-         * of sequence considered isn't a  a 'X' nor 'N'
-         * (indetermination) or a '-' (gap), computes a hit */
-        else if((sequences[i][j] != indet) && (sequences[i][j] != '-')
-          && (sequences[k][j] != indet) && (sequences[k][j] != '-'))
-          hit++;
-      }
-      /* ***** ***** ***** ***** ***** ***** ***** ***** */
-
-      /* ***** ***** ***** ***** ***** ***** ***** ***** */
-      /* For sequences are after the sequence selected */
-      for(k = (i + 1); k < sequenNumber; k++) {
-
-        /* ***** ***** ***** ***** ***** ***** ***** ***** */
-        /* If the element of sequence selected is the same
-         * that the element of sequence considered, computes
-         * a hit */
-        if(sequences[i][j] == sequences[k][j])
-          hit++;
-
-        /* If the element of sequence selected isn't a 'X' nor
-         * 'N' (indetermination) or a '-' (gap) and the element
-         * of sequence considered isn't a  a 'X' nor 'N'
-         * (indetermination) or a '-' (gap), computes a hit */
-        else if((sequences[i][j] != indet) && (sequences[i][j] != '-')
-          && (sequences[k][j] != indet) && (sequences[k][j] != '-'))
-          hit++;
-      }
-      /* ***** ***** ***** ***** ***** ***** ***** ***** */
+    /* For each alignment's column, counts the hits between
+     * the selected sequence and the other ones. There is a
+     * hit when both elements are the same or when none of
+     * them is a 'X' nor 'N' (indetermination) or a '-' (gap).
+     * Sequences are compared a whole row at a time */
+    utils::initlVect(hits, residNumber, 0);
+    for(k = 0; k < sequenNumber; k++)
+      if(k != i)
+        simdKernels::addSpuriousHits(sequences[i].data(), sequences[k].data(), residNumber, indet, hits);
+    /* ***** ***** ***** ***** ***** ***** ***** ***** */
 
-      /* ***** ***** ***** ***** ***** ***** ***** ***** */
-      /* Finally, if the hit's number divided by number of
-       * sequences minus one is greater or equal than
-       * overlap's value, computes a column's hit. */
-      if(hit >= ovrlap)
+    /* ***** ***** ***** ***** ***** ***** ***** ***** */
+    /* Finally, if the hit's number divided by number of
+     * sequences minus one is greater or equal than
+     * overlap's value, computes a column's hit. */
+    for(j = 0, seqValue = 0; j < residNumber; j++)
+      if(hits[j] >= ovrlap)
         seqValue++;
-      /* ***** ***** ***** ***** ***** ***** ***** ***** */
-    }
+    /* ***** ***** ***** ***** ***** ***** ***** ***** */
 
     /* ***** ***** ***** ***** ***** ***** ***** ***** */
     /* For each alignment's sequence, computes its spurious's
@@ -1226,6 +1237,7 @@ bool alignment::calculateSpuriousVector(float overlap, float *spuriousVector) {
     spuriousVector[i] = ((float) seqValue / residNumber);
     /* ***** ***** ***** ***** ***** ***** ***** ***** */
   }
+  delete [] hits;
 
   /* ***** ***** ***** ***** ***** ***** ***** ***** */
   /* If there is not problem in the method, return true */
@@ -1250,13 +1262,12 @@ int *alignment::calculateRepresentativeSeq(float maximumIdent) {
 
   int i, j, pos, clusterNum, **seqs;
   int *cluster;
-  static int *repres;
+  int *repres;
   float max;
 
   /* ***** ***** ***** ***** ***** ***** ***** ***** */
   /* Ask for the sequence identities assesment */
-  if(identities == NULL)
-    calculateSeqIdentity();
+  calculateSeqIdentity();
   /* ***** ***** ***** ***** ***** ***** ***** ***** */
 
   /* ***** ***** ***** ***** ***** ***** ***** ***** */
@@ -1281,9 +1292,9 @@ int *alignment::calculateRepresentativeSeq(float maximumIdent) {
 
     /* ***** ***** ***** ***** ***** ***** ***** ***** */
     for(j = 0, max = 0, pos = -1; j < clusterNum; j++) {
-      if(identities[seqs[i][1]][cluster[j]] > maximumIdent) {
-        if(identities[seqs[i][1]][cluster[j]] > max) {
-          max = identities[seqs[i][1]][cluster[j]];
+      if(identities -> getIdentity(seqs[i][1], cluster[j]) > maximumIdent) {
+        if(identities -> getIdentity(seqs[i][1], cluster[j]) > max) {
+          max = identities -> getIdentity(seqs[i][1], cluster[j]);
           pos = j;
         }
       }
@@ -1341,8 +1352,7 @@ float alignment::getCutPointClusters(int clusterNumber) {
 
   /* ***** ***** ***** ***** ***** ***** ***** ***** */
   /* Ask for the sequence identities assesment */
-  if(identities == NULL)
-    calculateSeqIdentity();
+  calculateSeqIdentity();
   /* ***** ***** ***** ***** ***** ***** ***** ***** */
 
   /* ***** ***** ***** ***** ***** ***** ***** ***** */
@@ -1351,20 +1361,20 @@ float alignment::getCutPointClusters(int clusterNumber) {
   for(i = 0,gMax = 0, gMin = 1, startingPoint = 0; i < sequenNumber; i++) {
     /* ***** ***** ***** ***** ***** ***** ***** ***** */
     for(j = 0, max = 0, avg = 0, min = 1; j < i; j++) {
-      if(max < identities[i][j])
-        max  = identities[i][j];
-      if(min > identities[i][j])
-        min  = identities[i][j];
-      avg += identities[i][j];
+      if(max < identities -> getIdentity(i, j))
+        max  = identities -> getIdentity(i, j);
+      if(min > identities -> getIdentity(i, j))
+        min  = identities -> getIdentity(i, j);
+      avg += identities -> getIdentity(i, j);
     }
     /* ***** ***** ***** ***** ***** ***** ***** ***** */
     /* ***** ***** ***** ***** ***** ***** ***** ***** */
     for(j = i + 1; j < sequenNumber; j++) {
-      if(max < identities[i][j])
-        max  = identities[i][j];
-      if(min > identities[i][j])
-        min  = identities[i][j];
-      avg += identities[i][j];
+      if(max < identities -> getIdentity(i, j))
+        max  = identities -> getIdentity(i, j);
+      if(min > identities -> getIdentity(i, j))
+        min  = identities -> getIdentity(i, j);
+      avg += identities -> getIdentity(i, j);
     }
     /* ***** ***** ***** ***** ***** ***** ***** ***** */
     startingPoint += avg / (sequenNumber - 1);
@@ -1414,7 +1424,7 @@ float alignment::getCutPointClusters(int clusterNumber) {
     for(i = sequenNumber - 2; i >= 0; i--) {
       /* ***** ***** ***** ***** ***** ***** ***** ***** */
       for(j = 0; j < clusterNum; j++)
-        if(identities[seqs[i][1]][cluster[j]] > startingPoint)
+        if(identities -> getIdentity(seqs[i][1], cluster[j]) > startingPoint)
           break;
       /* ***** ***** ***** ***** ***** ***** ***** ***** */
 
@@ -1481,7 +1491,6 @@ float alignment::getCutPointClusters(int clusterNumber) {
 /* ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** */
 alignment *alignment::getClustering(float identityThreshold) {
 
-  string *matrixAux, *newSeqsName;
   int i, j, *clustering;
   alignment *newAlig;
 
@@ -1501,36 +1510,30 @@ alignment *alignment::getClustering(float identityThreshold) {
     saveSequences[clustering[i]] = clustering[i];
   /* ***** ***** ***** ***** ***** ***** ***** ***** */
 
-  /* ***** ***** ***** ***** ***** ***** ***** ***** */
-  /* We allocate memory to save the sequences selected */
-  matrixAux = new string[clustering[0]];
-  newSeqsName = new string[clustering[0]];
-
-  /* Copy to new structures the information that have
-   * been selected previously. */
-  for(i = 0, j = 0; i < sequenNumber; i++)
-    if(saveSequences[i] != -1) {
-       newSeqsName[j] = seqsName[i];
-       matrixAux[j] = sequences[i];
-       j++;
-    }
-  /* ***** ***** ***** ***** ***** ***** ***** ***** */
-
   /* ***** ***** ***** ***** ***** ***** ***** ***** */
   /* When we have all parameters, we create the new
    * alignment */
-  newAlig = new alignment(filename, aligInfo, matrixAux, newSeqsName, seqsInfo,
+  newAlig = new alignment(filename, aligInfo, NULL, NULL, seqsInfo,
     clustering[0], residNumber, iformat, oformat, shortNames, dataType, isAligned,
     reverse, terminalGapOnly, left_boundary, right_boundary,
     keepSequences, keepHeader, sequenNumber, residNumber, residuesNumber,
-    saveResidues, saveSequences, ghWindow, shWindow, blockSize, identities,
-    overlaps);
+    saveResidues, saveSequences, ghWindow, shWindow, blockSize);
   /* ***** ***** ***** ***** ***** ***** ***** ***** */
 
   /* ***** ***** ***** ***** ***** ***** ***** ***** */
-  /* Deallocated auxiliar memory */
-  delete [] matrixAux;
-  delete [] newSeqsName;
+  /* Copy straight to the new alignment the sequences
+   * that have been selected previously. */
+  for(i = 0, j = 0; i < sequenNumber; i++)
+    if(saveSequences[i] != -1) {
+       newAlig -> seqsName[j] = seqsName[i];
+       newAlig -> sequences[j] = sequences[i];
+       j++;
+    }
+  /* ***** ***** ***** ***** ***** ***** ***** ***** */
+
+  /* ***** ***** ***** ***** ***** ***** ***** ***** */
+  /* Deallocate local memory */
+  delete [] clustering;
   /* ***** ***** ***** ***** ***** ***** ***** ***** */
 
   /* ***** ***** ***** ***** ***** ***** ***** ***** */
@@ -1552,17 +1555,14 @@ alignment *alignment::getTranslationCDS(int newResidues, int newSequences, int *
   alignment *newAlig;
   int i, j, k, l, oldResidues;
   int *mappedSeqs, *tmpSequence, *selectedRes;
+  namesIndex codingNames(seqsName, sequenNumber);
 
   /* ***** ***** ***** ***** ***** ***** ***** ***** */
   /* Map the selected protein sequences to the input
    * coding sequences */
   mappedSeqs = new int[newSequences];
-  for(i = 0; i < sequenNumber; i++)
-    for(j = 0; j < newSequences; j++)
-    if(!seqsName[i].compare(oldSeqsName[j])) {
-      mappedSeqs[j] = i;
-      break;
-    }
+  for(j = 0; j < newSequences; j++)
+    mappedSeqs[j] = codingNames.find(oldSeqsName[j]);
   /* ***** ***** ***** ***** ***** ***** ***** ***** */
 
   /* ***** ***** ***** ***** ***** ***** ***** ***** */
@@ -1572,17 +1572,20 @@ alignment *alignment::getTranslationCDS(int newResidues, int newSequences, int *
   selectedRes = new int[oldResidues];
 
   for(i = 0; i < oldResidues; i++)
-    selectedRes[i] = i;
+    selectedRes[i] = (newResidues == 0) ? -1 : i;
 
-  for(j = 0; j < ColumnsToKeep[0]; j++)
-    selectedRes[j] = -1;
-
-  for(i = 0; i < newResidues - 1; i++)
-    for(j = ColumnsToKeep[i] + 1; j < ColumnsToKeep[i+1]; j++)
+  /* An empty trimmed alignment does not keep any column to look at */
+  if(newResidues != 0) {
+    for(j = 0; j < ColumnsToKeep[0]; j++)
       selectedRes[j] = -1;
 
-  for(j = ColumnsToKeep[newResidues - 1] + 1; j < oldResidues; j++)
-    selectedRes[j] = -1;
+    for(i = 0; i < newResidues - 1; i++)
+      for(j = ColumnsToKeep[i] + 1; j < ColumnsToKeep[i+1]; j++)
+        selectedRes[j] = -1;
+
+    for(j = ColumnsToKeep[newResidues - 1] + 1; j < oldResidues; j++)
+      selectedRes[j] = -1;
+  }
   /* ***** ***** ***** ***** ***** ***** ***** ***** */
 
   /* ***** ***** ***** ***** ***** ***** ***** ***** */
@@ -1630,7 +1633,7 @@ alignment *alignment::getTranslationCDS(int newResidues, int newSequences, int *
     ProtAlig -> getShortNames(), DNAType, true, ProtAlig -> getReverse(),
     terminalGapOnly, left_boundary, right_boundary,
     keepSequences, keepHeader, sequenNumber, oldResidues * 3, NULL, NULL,
-    NULL, 0, 0, ProtAlig -> getBlockSize(), NULL, NULL);
+    NULL, 0, 0, ProtAlig -> getBlockSize());
   /* ***** ***** ***** ***** ***** ***** ***** ***** */
 
   /* ***** ***** ***** ***** ***** ***** ***** ***** */
@@ -1662,7 +1665,8 @@ bool alignment::calculateGapStats(void) {
   /* If sgaps object is not created, we create them
      and calculate the statistics */
   if(sgaps == NULL) {
-    sgaps = new statisticsGaps(sequences, sequenNumber, residNumber, dataType);
+    sgaps = new statisticsGaps(getPackedSequences(dataType == AAType ? 'X' : 'N'),
+      sequenNumber, residNumber, dataType);
     sgaps -> applyWindow(ghWindow);
   }
   /* ***** ***** ***** ***** ***** ***** ***** ***** */
@@ -1672,6 +1676,58 @@ bool alignment::calculateGapStats(void) {
   /* ***** ***** ***** ***** ***** ***** ***** ***** */
 }
 
+/* ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** */
+/* Return the encoded sequences, building them the first time they are
+ * requested. Indeterminations bitmasks are rebuilt if a different symbol is
+ * asked for, since it depends on the alignment datatype */
+/* ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** */
+packedSequences *alignment::getPackedSequences(char indet) {
+
+  if(packedSeqs == NULL)
+    packedSeqs = new packedSequences(sequences, sequenNumber, residNumber, indet);
+  else
+    packedSeqs -> setIndetermination(indet);
+
+  return packedSeqs;
+}
+
+/* ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** */
+/* Return the alignment residues stored column by column, building them the
+ * first time they are requested. The transposition is done in square tiles
+ * of sequences and columns, so the tile being read and the tile being
+ * written both stay in cache. Positions beyond a sequence end are
+ * considered as gaps */
+/* ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** */
+string *alignment::getResidueColumns(void) {
+
+  int i, j, k, l, lastSeq, lastCol, length;
+  const char *residues;
+
+  if(residueColumns != NULL)
+    return residueColumns;
+
+  residueColumns = new string[residNumber];
+  for(i = 0; i < residNumber; i++)
+    residueColumns[i].assign(sequenNumber, '-');
+
+  for(j = 0; j < sequenNumber; j += TRANSPOSEBLOCK) {
+    lastSeq = utils::min(j + TRANSPOSEBLOCK, sequenNumber);
+
+    for(l = 0; l < residNumber; l += TRANSPOSEBLOCK) {
+      lastCol = utils::min(l + TRANSPOSEBLOCK, residNumber);
+
+      for(k = j; k < lastSeq; k++) {
+        residues = sequences[k].data();
+        length = utils::min((int) sequences[k].size(), lastCol);
+        for(i = l; i < length; i++)
+          residueColumns[i][k] = residues[i];
+      }
+    }
+  }
+
+  return residueColumns;
+}
+
 /* ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** */
 /* Print the gaps value for each column in the alignment */
 /* ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** */
@@ -1698,6 +1754,18 @@ void alignment::printStatisticsGapsTotal(void) {
   /* ***** ***** ***** ***** ***** ***** ***** ***** */
 }
 
+/* ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** */
+/* Return the summary values for the gaps distribution from the alignment */
+/* ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** */
+bool alignment::getGapsSummary(float *gapFreeColumns, float *averageGaps, float *maxGaps) {
+
+  if(!calculateGapStats())
+    return false;
+
+  sgaps -> getGapsSummary(gapFreeColumns, averageGaps, maxGaps);
+  return true;
+}
+
 /* ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** */
 /* Set the similarity matrix. This matrix is necessary for some methods in
  * the program */
@@ -1707,7 +1775,7 @@ bool alignment::setSimilarityMatrix(similarityMatrix *sm) {
   /* ***** ***** ***** ***** ***** ***** ***** ***** */
   /* If scons object is not created, we create them */
   if(scons == NULL)
-    scons = new statisticsConservation(sequences, sequenNumber, residNumber, dataType);
+    scons = new statisticsConservation(sequenNumber, residNumber, dataType);
   /* ***** ***** ***** ***** ***** ***** ***** ***** */
 
   /* ***** ***** ***** ***** ***** ***** ***** ***** */
@@ -1751,8 +1819,10 @@ bool alignment::calculateConservationStats(void) {
 
   /* ***** ***** ***** ***** ***** ***** ***** ***** */
   /* Compute the similarity statistics from the input
-   * alignment */
-  if(!scons -> calculateVectors(sequences, sgaps->getGapsWindow()))
+   * alignment. Sequences identities are shared with
+   * any other method that needs them */
+  if(!scons -> calculateVectors(getResidueColumns(), sgaps->getGapsWindow(),
+       getPairwiseIdentities(scons -> getIndetermination())))
     return false;
 
   /* ***** ***** ***** ***** ***** ***** ***** ***** */
@@ -1793,6 +1863,19 @@ void alignment::printStatisticsConservationTotal(void) {
   /* ***** ***** ***** ***** ***** ***** ***** ***** */
 }
 
+/* ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** */
+/* Return the summary values for the similarity distribution from the
+ * alignment */
+/* ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** */
+bool alignment::getConservationSummary(float *minimum, float *average, float *maximum) {
+
+  if(!calculateConservationStats())
+    return false;
+
+  scons -> getConservationSummary(minimum, average, maximum);
+  return true;
+}
+
 /* ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** */
 /* This method prints the correspondece between the columns in the original
  * and in the trimmed alignment */
@@ -1894,6 +1977,16 @@ void alignment::setKeepSequencesFlag(bool flag) {
 void alignment::setKeepSeqsHeaderFlag(bool flag) {
   keepHeader = flag;
 }
+
+/* Set how many threads share the computation of the pairwise matrices */
+void alignment::setThreadsNumber(int threads) {
+  threadsNumber = threads;
+}
+
+/* Set whether trimming methods should only update the selection */
+void alignment::setSelectionOnly(bool selection) {
+  selectionOnly = selection;
+}
 /* ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** */
 /* Return the block size value */
 /* ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** */
@@ -1934,17 +2027,16 @@ void alignment::getSequences(string *Names, string *Sequences, int *Lengths) {
 /* ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** */
 bool alignment::getSeqNameOrder(string *names, int *orderVector) {
   int i, j, numNames;
+  namesIndex inputNames(names, sequenNumber);
 
   /* ***** ***** ***** ***** ***** ***** ***** ***** */
   /* For each name in the current alignment, we look
    * for its correspondence in the input set */
   for(i = 0, numNames = 0; i < sequenNumber; i++) {
-    for(j = 0; j < sequenNumber; j++) {
-      if(seqsName[i] == names[j]) {
-        orderVector[i] = j;
-        numNames++;
-        break;
-      }
+    j = inputNames.find(seqsName[i]);
+    if(j != -1) {
+      orderVector[i] = j;
+      numNames++;
     }
   }
   /* ***** ***** ***** ***** ***** ***** ***** ***** */
@@ -2072,8 +2164,6 @@ alignment *alignment::cleanByCutValue(double cut, float baseLine,
   const int *gInCol, bool complementary) {
 
   int i, j, k, jn, oth, pos, block, *vectAux;
-  string *matrixAux, *newSeqsName;
-  alignment *newAlig;
   newValues counter;
 
   /* ***** ***** ***** ***** ***** ***** ***** ***** */
@@ -2122,14 +2212,14 @@ alignment *alignment::cleanByCutValue(double cut, float baseLine,
 
       /* ***** ***** ***** ***** ***** ***** ***** ***** */
       /* Left side. Here, we compute the block's size. */
-      for(jn = i; ((saveResidues[jn] != -1) && (jn >= 0) && (oth > 0)); jn--) ;
+      for(jn = i; ((jn >= 0) && (saveResidues[jn] != -1) && (oth > 0)); jn--) ;
 
       /* ***** ***** ***** ***** ***** ***** ***** ***** */
       /* if block's size is greater or equal than the fixed
        * size then we save all columns that have not been
        * saved previously. */
       if((i - jn) >= k) {
-        for( ; ((saveResidues[jn] == -1) && (jn >= 0) && (oth > 0)); jn--) {
+        for( ; ((jn >= 0) && (saveResidues[jn] == -1) && (oth > 0)); jn--) {
           if(gInCol[jn] <= cut) {
             saveResidues[jn] = jn;
             oth--;
@@ -2142,14 +2232,14 @@ alignment *alignment::cleanByCutValue(double cut, float baseLine,
 
       /* ***** ***** ***** ***** ***** ***** ***** ***** */
       /* Right side. Here, we compute the block's size. */
-      for(jn = j; ((saveResidues[jn] != -1) && (jn < residNumber) && (oth > 0)); jn++) ;
+      for(jn = j; ((jn < residNumber) && (saveResidues[jn] != -1) && (oth > 0)); jn++) ;
 
       /* ***** ***** ***** ***** ***** ***** ***** ***** */
       /* if block's size is greater or equal than the fixed
        * size then we save all columns that have not been
        * saved previously. */
       if((jn - j) >= k) {
-        for( ; ((saveResidues[jn] == -1) && (jn < residNumber) && (oth > 0)); jn++) {
+        for( ; ((jn < residNumber) && (saveResidues[jn] == -1) && (oth > 0)); jn++) {
           if(gInCol[jn] <= cut) {
             saveResidues[jn] = jn;
             oth--;
@@ -2200,31 +2290,9 @@ alignment *alignment::cleanByCutValue(double cut, float baseLine,
   if(complementary == true)
     computeComplementaryAlig(true, false);
 
-  /* Check for any additional column/sequence to be removed */
-  /* Compute new sequences and columns numbers */
-  counter = removeCols_SeqsAllGaps();
-
-  /* Allocate memory  for selected sequences/columns */
-  matrixAux = new string[counter.sequences];
-  newSeqsName = new string[counter.sequences];
-
-  /* Fill local allocated memory with previously selected data */
-  fillNewDataStructure(matrixAux, newSeqsName);
-
-  /* When we have all parameters, we create the new alignment */
-  newAlig = new alignment(filename, aligInfo, matrixAux, newSeqsName, seqsInfo,
-    counter.sequences, counter.residues, iformat, oformat, shortNames, dataType,
-    isAligned, reverse, terminalGapOnly, left_boundary, right_boundary,
-    keepSequences, keepHeader, sequenNumber, residNumber,
-    residuesNumber, saveResidues, saveSequences, ghWindow, shWindow, blockSize,
-    identities, overlaps);
-
-  /* Deallocate local memory */
-  delete[] matrixAux;
-  delete[] newSeqsName;
-
-  /* Return the new alignment reference */
-  return newAlig;
+  /* Check for any additional column/sequence to be removed and build the
+   * new alignment from the selection */
+  return getSelectedAlignment();
 }
 
 /* This method removes those columns that not achieve a given threshold. If the
@@ -2238,8 +2306,6 @@ alignment *alignment::cleanByCutValue(float cut, float baseLine,
   const float *ValueVect, bool complementary) {
 
   int i, j, k, jn, oth, pos, block;
-  string *matrixAux, *newSeqsName;
-  alignment *newAlig;
   newValues counter;
 
   /* ***** ***** ***** ***** ***** ***** ***** ***** */
@@ -2270,7 +2336,7 @@ alignment *alignment::cleanByCutValue(float cut, float baseLine,
 
       /* ***** ***** ***** ***** ***** ***** ***** ***** */
       /* Left side. Here, we compute the block's size. */
-      for(jn = i; ((saveResidues[jn] != -1) && (jn >= 0) && (oth > 0)); jn--) ;
+      for(jn = i; ((jn >= 0) && (saveResidues[jn] != -1) && (oth > 0)); jn--) ;
 
        /* ***** ***** ***** ***** ***** ***** ***** ***** */
       /* if block's size is greater or equal than the fixed
@@ -2279,7 +2345,7 @@ alignment *alignment::cleanByCutValue(float cut, float baseLine,
       /* Here, we only accept column with a conservation's
        * value equal to conservation cut point. */
       if((i - jn) >= k) {
-        for( ; ((saveResidues[jn] == -1) && (jn >= 0) && (oth > 0)); jn--) {
+        for( ; ((jn >= 0) && (saveResidues[jn] == -1) && (oth > 0)); jn--) {
           if(ValueVect[jn] == cut) {
             saveResidues[jn] = jn;
             oth--;
@@ -2292,7 +2358,7 @@ alignment *alignment::cleanByCutValue(float cut, float baseLine,
 
       /* ***** ***** ***** ***** ***** ***** ***** ***** */
       /* Right side. Here, we compute the block's size. */
-      for(jn = j; ((saveResidues[jn] != -1) && (jn < residNumber) && (oth > 0)); jn++) ;
+      for(jn = j; ((jn < residNumber) && (saveResidues[jn] != -1) && (oth > 0)); jn++) ;
 
       /* ***** ***** ***** ***** ***** ***** ***** ***** */
       /* if block's size is greater or equal than the fixed
@@ -2302,7 +2368,7 @@ alignment *alignment::cleanByCutValue(float cut, float baseLine,
      /* Here, we only accept column with a conservation's
       * value equal to conservation cut point. */
       if((jn - j) >= k) {
-        for( ; ((saveResidues[jn] == -1) && (jn < residNumber) && (oth > 0)); jn++) {
+        for( ; ((jn < residNumber) && (saveResidues[jn] == -1) && (oth > 0)); jn++) {
           if(ValueVect[jn] == cut) {
             saveResidues[jn] = jn;
             oth--;
@@ -2353,31 +2419,9 @@ alignment *alignment::cleanByCutValue(float cut, float baseLine,
   if(complementary == true)
     computeComplementaryAlig(true, false);
 
-  /* Check for any additional column/sequence to be removed */
-  /* Compute new sequences and columns numbers */
-  counter = removeCols_SeqsAllGaps();
-
-  /* Allocate memory  for selected sequences/columns */
-  matrixAux = new string[counter.sequences];
-  newSeqsName = new string[counter.sequences];
-
-  /* Fill local allocated memory with previously selected data */
-  fillNewDataStructure(matrixAux, newSeqsName);
-
-  /* When we have all parameters, we create the new alignment */
-  newAlig = new alignment(filename, aligInfo, matrixAux, newSeqsName, seqsInfo,
-    counter.sequences, counter.residues, iformat, oformat, shortNames, dataType,
-    isAligned, reverse, terminalGapOnly, left_boundary, right_boundary,
-    keepSequences, keepHeader, sequenNumber, residNumber,
-    residuesNumber, saveResidues, saveSequences, ghWindow, shWindow, blockSize,
-    identities, overlaps);
-
-  /* Deallocate local memory */
-  delete[] matrixAux;
-  delete[] newSeqsName;
-
-  /* Return the new alignment reference */
-  return newAlig;
+  /* Check for any additional column/sequence to be removed and build the
+   * new alignment from the selection */
+  return getSelectedAlignment();
 }
 
 /* This method removes those columns that not achieve the similarity threshond,
@@ -2395,9 +2439,7 @@ alignment *alignment::cleanByCutValue(double cutGaps, const int *gInCol,
   float baseLine, float cutCons, const float *MDK_Win, bool complementary) {
 
   int i, j, k, oth, pos, block, jn, blGaps, *vectAuxGaps;
-  string *matrixAux, *newSeqsName;
   float blCons, *vectAuxCons;
-  alignment *newAlig;
   newValues counter;
 
   /* ***** ***** ***** ***** ***** ***** ***** ***** */
@@ -2461,7 +2503,7 @@ alignment *alignment::cleanByCutValue(double cutGaps, const int *gInCol,
 
       /* ***** ***** ***** ***** ***** ***** ***** ***** */
       /* Left side. Here, we compute the block's size. */
-      for(jn = i; ((saveResidues[jn] != -1) && (jn >= 0) && (oth > 0)); jn--) ;
+      for(jn = i; ((jn >= 0) && (saveResidues[jn] != -1) && (oth > 0)); jn--) ;
 
       /* ***** ***** ***** ***** ***** ***** ***** ***** */
       /* if block's size is greater or equal than the fixed
@@ -2472,7 +2514,7 @@ alignment *alignment::cleanByCutValue(double cutGaps, const int *gInCol,
        * greater or equal than the conservation cut point OR
        * less or equal than the gap cut point. */
       if((i - jn) >= k) {
-        for( ; ((saveResidues[jn] == -1) && (jn >= 0) && (oth > 0)); jn--) {
+        for( ; ((jn >= 0) && (saveResidues[jn] == -1) && (oth > 0)); jn--) {
           if((MDK_Win[jn] >= blCons) || (gInCol[jn] <= blGaps)) {
             saveResidues[jn] = jn;
             oth--;
@@ -2485,7 +2527,7 @@ alignment *alignment::cleanByCutValue(double cutGaps, const int *gInCol,
 
       /* ***** ***** ***** ***** ***** ***** ***** ***** */
       /* Right side. Here, we compute the block's size. */
-      for(jn = j; ((saveResidues[jn] != -1) && (jn < residNumber) && (oth > 0)); jn++) ;
+      for(jn = j; ((jn < residNumber) && (saveResidues[jn] != -1) && (oth > 0)); jn++) ;
 
       /* ***** ***** ***** ***** ***** ***** ***** ***** */
       /* if block's size is greater or equal than the fixed
@@ -2496,7 +2538,7 @@ alignment *alignment::cleanByCutValue(double cutGaps, const int *gInCol,
        * greater or equal than the conservation cut point OR
        * less or equal than the gap cut point. */
       if((jn - j) >= k) {
-        for( ; ((saveResidues[jn] == -1) && (jn < residNumber) && (oth > 0)); jn++) {
+        for( ; ((jn < residNumber) && (saveResidues[jn] == -1) && (oth > 0)); jn++) {
           if((MDK_Win[jn] >= blCons) || (gInCol[jn] <= blGaps)) {
             saveResidues[jn] = jn;
             oth--;
@@ -2547,31 +2589,9 @@ alignment *alignment::cleanByCutValue(double cutGaps, const int *gInCol,
   if(complementary == true)
     computeComplementaryAlig(true, false);
 
-  /* Check for any additional column/sequence to be removed */
-  /* Compute new sequences and columns numbers */
-  counter = removeCols_SeqsAllGaps();
-
-  /* Allocate memory  for selected sequences/columns */
-  matrixAux = new string[counter.sequences];
-  newSeqsName = new string[counter.sequences];
-
-  /* Fill local allocated memory with previously selected data */
-  fillNewDataStructure(matrixAux, newSeqsName);
-
-  /* When we have all parameters, we create the new alignment */
-  newAlig = new alignment(filename, aligInfo, matrixAux, newSeqsName, seqsInfo,
-    counter.sequences, counter.residues, iformat, oformat, shortNames, dataType,
-    isAligned, reverse, terminalGapOnly, left_boundary, right_boundary,
-    keepSequences, keepHeader, sequenNumber, residNumber,
-    residuesNumber, saveResidues, saveSequences, ghWindow, shWindow, blockSize,
-    identities, overlaps);
-
-  /* Deallocate local memory */
-  delete[] matrixAux;
-  delete[] newSeqsName;
-
-  /* Return the new alignment reference */
-  return newAlig;
+  /* Check for any additional column/sequence to be removed and build the
+   * new alignment from the selection */
+  return getSelectedAlignment();
 }
 
 /* This method carries out the strict and strict plus method. To trim the
@@ -2588,7 +2608,6 @@ alignment *alignment::cleanStrict(int gapCut, const int *gInCol, float simCut,
   const float *MDK_W, bool complementary, bool variable) {
 
   int i, num, lenBlock;
-  alignment *newAlig;
 
   deque<int> neighboursBlock;
 
@@ -2699,38 +2718,9 @@ alignment *alignment::cleanStrict(int gapCut, const int *gInCol, float simCut,
   if(complementary == true)
     computeComplementaryAlig(true, false);
 
-  /* Check for any additional column/sequence to be removed */
-  /* Compute new sequences and columns numbers */
-
-  newValues counter;
-  counter = removeCols_SeqsAllGaps();
-
-  /* Allocate memory  for selected sequences/columns */
-  //~ matrixAux = new string[counter.sequences];
-  //~ newSeqsName = new string[counter.sequences];
-
-  /* Fill local allocated memory with previously selected data */
-  //~ fillNewDataStructure(matrixAux, newSeqsName);
-
-  fillNewDataStructure(&counter);
-
-  //~ cerr << counter -> seqsName[counter -> sequences - 1] << endl;
-
-  /* When we have all parameters, we create the new alignment */
-  //~ newAlig = new alignment(filename, aligInfo, matrixAux, newSeqsName, seqsInfo, counter.sequences, counter.residues,
-  newAlig = new alignment(filename, aligInfo, counter.matrix, counter.seqsName,
-    seqsInfo, counter.sequences, counter.residues, iformat, oformat, shortNames,
-    dataType, isAligned, reverse, terminalGapOnly, left_boundary, right_boundary,
-    keepSequences, keepHeader, sequenNumber,
-    residNumber, residuesNumber, saveResidues, saveSequences, ghWindow, shWindow,
-    blockSize, identities, overlaps);
-
-  /* Deallocate local memory */
-  //~ delete[] matrixAux;
-  //~ delete[] newSeqsName;
-
-  /* Return the new alignment reference */
-  return newAlig;
+  /* Check for any additional column/sequence to be removed and build the
+   * new alignment from the selection */
+  return getSelectedAlignment();
 }
 
 /* Remove those sequences with an overlap less than a given threshold. It can
@@ -2738,9 +2728,6 @@ alignment *alignment::cleanStrict(int gapCut, const int *gInCol, float simCut,
 alignment *alignment::cleanOverlapSeq(float minimumOverlap, float *overlapSeq,
   bool complementary) {
 
-  string *matrixAux, *newSeqsName;
-  alignment *newAlig;
-  newValues counter;
   int i;
 
   /* Keep only those sequences with an overlap value equal or greater than
@@ -2754,31 +2741,9 @@ alignment *alignment::cleanOverlapSeq(float minimumOverlap, float *overlapSeq,
   if(complementary == true)
     computeComplementaryAlig(false, true);
 
-  /* Check for any additional column/sequence to be removed */
-  /* Compute new sequences and columns numbers */
-  counter = removeCols_SeqsAllGaps();
-
-  /* Allocate memory  for selected sequences/columns */
-  matrixAux = new string[counter.sequences];
-  newSeqsName = new string[counter.sequences];
-
-  /* Fill local allocated memory with previously selected data */
-  fillNewDataStructure(matrixAux, newSeqsName);
-
-  /* When we have all parameters, we create the new alignment */
-  newAlig = new alignment(filename, aligInfo, matrixAux, newSeqsName, seqsInfo,
-    counter.sequences, counter.residues, iformat, oformat, shortNames, dataType,
-    isAligned, reverse, terminalGapOnly, left_boundary, right_boundary,
-    keepSequences, keepHeader, sequenNumber, residNumber,
-    residuesNumber, saveResidues, saveSequences, ghWindow, shWindow, blockSize,
-    identities, overlaps);
-
-  /* Deallocate local memory */
-  delete [] matrixAux;
-  delete [] newSeqsName;
-
-  /* Return the new alignment reference */
-  return newAlig;
+  /* Check for any additional column/sequence to be removed and build the
+   * new alignment from the selection */
+  return getSelectedAlignment();
 }
 
 /* Remove those columns, expressed as range, set by the user. It can return
@@ -2786,9 +2751,6 @@ alignment *alignment::cleanOverlapSeq(float minimumOverlap, float *overlapSeq,
 alignment *alignment::removeColumns(int *columns, int init, int size,
   bool complementary) {
 
-  string *matrixAux, *newSeqsName;
-  alignment *newAlig;
-  newValues counter;
   int i, j;
 
   /* Delete those range columns defines in the columns vector */
@@ -2801,31 +2763,9 @@ alignment *alignment::removeColumns(int *columns, int init, int size,
   if(complementary == true)
     computeComplementaryAlig(true, false);
 
-  /* Check for any additional column/sequence to be removed */
-  /* Compute new sequences and columns numbers */
-  counter = removeCols_SeqsAllGaps();
-
-  /* Allocate memory  for selected sequences/columns */
-  matrixAux = new string[counter.sequences];
-  newSeqsName = new string[counter.sequences];
-
-  /* Fill local allocated memory with previously selected data */
-  fillNewDataStructure(matrixAux, newSeqsName);
-
-  /* When we have all parameters, we create the new alignment */
-  newAlig = new alignment(filename, aligInfo, matrixAux, newSeqsName, seqsInfo,
-    counter.sequences, counter.residues, iformat, oformat, shortNames, dataType,
-    isAligned, reverse, terminalGapOnly, left_boundary, right_boundary,
-    keepSequences, keepHeader, sequenNumber, residNumber,
-    residuesNumber, saveResidues, saveSequences, ghWindow, shWindow, blockSize,
-    identities, overlaps);
-
-  /* Deallocate local memory */
-  delete[] matrixAux;
-  delete[] newSeqsName;
-
-  /* Return the new alignment reference */
-  return newAlig;
+  /* Check for any additional column/sequence to be removed and build the
+   * new alignment from the selection */
+  return getSelectedAlignment();
 }
 
 /* This method removes those sequences, expressed as range of sequences, set by
@@ -2834,9 +2774,6 @@ alignment *alignment::removeColumns(int *columns, int init, int size,
 alignment *alignment::removeSequences(int *seqs, int init, int size,
   bool complementary) {
 
-  string *matrixAux, *newSeqsName;
-  alignment *newAlig;
-  newValues counter;
   int i, j;
 
   /* Delete those range of sequences defines by the seqs vector */
@@ -2849,31 +2786,9 @@ alignment *alignment::removeSequences(int *seqs, int init, int size,
   if(complementary == true)
     computeComplementaryAlig(false, true);
 
-  /* Check for any additional column/sequence to be removed */
-  /* Compute new sequences and columns numbers */
-  counter = removeCols_SeqsAllGaps();
-
-  /* Allocate memory  for selected sequences/columns */
-  matrixAux = new string[counter.sequences];
-  newSeqsName = new string[counter.sequences];
-
-  /* Fill local allocated memory with previously selected data */
-  fillNewDataStructure(matrixAux, newSeqsName);
-
-  /* When we have all parameters, we create the new alignment */
-  newAlig = new alignment(filename, aligInfo, matrixAux, newSeqsName, seqsInfo,
-    counter.sequences, counter.residues, iformat, oformat, shortNames, dataType,
-    isAligned, reverse, terminalGapOnly, left_boundary, right_boundary,
-    keepSequences, keepHeader, sequenNumber, residNumber,
-    residuesNumber, saveResidues, saveSequences, ghWindow, shWindow, blockSize,
-    identities, overlaps);
-
-  /* Free local memory */
-  delete [] matrixAux;
-  delete [] newSeqsName;
-
-  /* Return the new alignment reference */
-  return newAlig;
+  /* Check for any additional column/sequence to be removed and build the
+   * new alignment from the selection */
+  return getSelectedAlignment();
 }
 
 /* Function for computing the complementary alignment. It just turn around the
@@ -2970,24 +2885,33 @@ void alignment::removeSmallerBlocks(int blockSize) {
  * Once these columns/sequences have been identified, they are removed from
  * final alignment. */
 newValues alignment::removeCols_SeqsAllGaps(void) {
-  int i, j, valid, gaps;
+  int i, j, valid, *gaps;
   bool warnings = false;
   newValues counter;
+  const char *sequence;
+
+  /* Count the gaps of every column among the selected sequences. They are
+   * counted sequence by sequence, which goes through the memory in order */
+  gaps = new int[residNumber];
+  utils::initlVect(gaps, residNumber, 0);
+
+  for(j = 0, valid = 0; j < sequenNumber; j++) {
+    if (saveSequences[j] == -1)
+      continue;
+    sequence = sequences[j].data();
+    for(i = 0; i < residNumber; i++)
+      if (sequence[i] == '-')
+        gaps[i] ++;
+    valid ++;
+  }
 
   /* Check all valid columns looking for those composed by only gaps */
   for(i = 0, counter.residues = 0; i < residNumber; i++) {
     if(saveResidues[i] == -1)
       continue;
 
-    for(j = 0, valid = 0, gaps = 0; j < sequenNumber; j++) {
-      if (saveSequences[j] == -1)
-        continue;
-      if (sequences[j][i] == '-')
-        gaps ++;
-      valid ++;
-    }
     /* Once a column has been identified, warm about it and remove it */
-    if(gaps == valid) {
+    if(gaps[i] == valid) {
       if(!warnings)
         cerr << endl;
       warnings = true;
@@ -2998,6 +2922,7 @@ newValues alignment::removeCols_SeqsAllGaps(void) {
       counter.residues ++;
     }
   }
+  delete [] gaps;
 
   /* Check for those selected sequences to see whether there is anyone with
    * only gaps */
@@ -3005,15 +2930,13 @@ newValues alignment::removeCols_SeqsAllGaps(void) {
     if(saveSequences[i] == -1)
       continue;
 
-    for(j = 0, valid = 0, gaps = 0; j < residNumber; j++) {
-      if(saveResidues[j] == -1)
-        continue;
-      if (sequences[i][j] == '-')
-        gaps ++;
-      valid ++;
-    }
+    sequence = sequences[i].data();
+    for(j = 0; j < residNumber; j++)
+      if((saveResidues[j] != -1) && (sequence[j] != '-'))
+        break;
+
     /* Warm about it and remove each sequence composed only by gaps */
-    if(gaps == valid) {
+    if(j == residNumber) {
       if(!warnings)
         cerr << endl;
       warnings = true;
@@ -3034,16 +2957,22 @@ newValues alignment::removeCols_SeqsAllGaps(void) {
   if(warnings)
     cerr << endl;
 
-  counter.matrix = new string[counter.sequences];
-  counter.seqsName = new string[counter.sequences];
-
   return counter;
 }
 
 /* Function for copying to previously allocated memory those data selected
  * for being in the final alignment */
 void alignment::fillNewDataStructure(string *newMatrix, string *newNames) {
-  int i, j, k;
+  int i, j, k, kept, *columns;
+  const char *sequence;
+  char *newSequence;
+
+  /* List the selected columns once, so every sequence is copied without
+   * checking them again nor growing it residue by residue */
+  columns = new int[residNumber];
+  for(k = 0, kept = 0; k < residNumber; k++)
+    if(saveResidues[k] != -1)
+      columns[kept++] = k;
 
   /* Copy only those sequences/columns selected */
   for(i = 0, j = 0; i < sequenNumber; i++) {
@@ -3051,34 +2980,44 @@ void alignment::fillNewDataStructure(string *newMatrix, string *newNames) {
       continue;
 
     newNames[j] = seqsName[i];
-    for(k = 0; k < residNumber; k++) {
-      if(saveResidues[k] == -1)
-        continue;
-      newMatrix[j].resize(newMatrix[j].size() + 1, sequences[i][k]);
+    if(kept == residNumber)
+      newMatrix[j] = sequences[i];
+    else if(kept != 0) {
+      newMatrix[j].resize(kept);
+      sequence = sequences[i].data();
+      newSequence = &newMatrix[j][0];
+      for(k = 0; k < kept; k++)
+        newSequence[k] = sequence[columns[k]];
     }
     j++;
   }
+
+  delete [] columns;
 }
 
-/* Function for copying to previously allocated memory those data selected
- * for being in the final alignment */
-void alignment::fillNewDataStructure(newValues *data) {
-  int i, j, k;
+/* Build the alignment kept by the current columns and sequences selection.
+ * Selected data is copied straight to the new alignment, once. Nothing is
+ * built when only the selection is wanted */
+alignment *alignment::getSelectedAlignment(void) {
+  alignment *newAlig;
+  newValues counter;
 
-  /* Copy only those sequences/columns selected */
-  for(i = 0, j = 0; i < sequenNumber; i++) {
-    if(saveSequences[i] == -1)
-      continue;
+  /* Compute new sequences and columns numbers */
+  counter = removeCols_SeqsAllGaps();
+  if(selectionOnly)
+    return NULL;
 
-    data -> seqsName[j] = seqsName[i];
-    for(k = 0; k < residNumber; k++) {
-      if(saveResidues[k] == -1)
-        continue;
-      data -> matrix[j].resize(data -> matrix[j].size() + 1, sequences[i][k]);
-    }
-    j++;
-  }
-  // cerr << data -> seqsName[j-1] << endl;
+  /* When we have all parameters, we create the new alignment */
+  newAlig = new alignment(filename, aligInfo, NULL, NULL, seqsInfo,
+    counter.sequences, counter.residues, iformat, oformat, shortNames, dataType,
+    isAligned, reverse, terminalGapOnly, left_boundary, right_boundary,
+    keepSequences, keepHeader, sequenNumber, residNumber,
+    residuesNumber, saveResidues, saveSequences, ghWindow, shWindow, blockSize);
+
+  /* Fill it with previously selected data */
+  fillNewDataStructure(newAlig -> sequences, newAlig -> seqsName);
+
+  return newAlig;
 }
 
 /* Check if CDS file is correct based on: Residues are DNA/RNA (at most). There
@@ -3105,6 +3044,7 @@ bool alignment::prepareCodingSequence(bool splitByStopCodon, bool ignStopCodon,\
   protSeqsLengths = new int[numbProtSeqs];
 
   proteinAlig -> getSequences(protSeqsNames, protSequences, protSeqsLengths);
+  namesIndex protNames(protSeqsNames, numbProtSeqs);
 
   /* Check read sequences are real DNA/RNA */
   if (getTypeAlignment() == AAType) {
@@ -3118,10 +3058,8 @@ bool alignment::prepareCodingSequence(bool splitByStopCodon, bool ignStopCodon,\
     /* Get protein sequence to compare against any potential stop codon in the
      * coding sequence. If there is not protein sequence for current coding
      * sequence, skip its analysis */
-    for(current_prot = 0; current_prot < numbProtSeqs; current_prot++)
-      if(protSeqsNames[current_prot] == seqsName[i])
-        break;
-    if(current_prot == numbProtSeqs)
+    current_prot = protNames.find(seqsName[i]);
+    if(current_prot == -1)
       continue;
 
     if(sequences[i].find("-") != string::npos) {
@@ -3302,6 +3240,7 @@ bool alignment::checkCorrespondence(string *names, int *lengths, int \
   int i, j, seqLength, indet;
   bool warnings = false;
   string tmp;
+  namesIndex inputNames(names, totalInputSeqs);
 
   /* For each sequence in the current protein alignment, look for its coding
    * DNA sequence checking that they have the same size. */
@@ -3315,63 +3254,56 @@ bool alignment::checkCorrespondence(string *names, int *lengths, int \
     indet = ((int) tmp.length() - utils::min((int) tmp.find_last_not_of("X"), \
       (int) tmp.find_last_not_of("x"))) - 1;
 
-    /* Go through all available CDS looking for the one with the same ID */
-    for(j = 0; j < totalInputSeqs; j++) {
+    /* Look for the CDS with the same ID */
+    j = inputNames.find(seqsName[i]);
 
-      /* Once both ID matchs, compare its lengths */
-      if(seqsName[i] == names[j]) {
-
-        /* If both sequences have the same length, stop the search */
-        if(seqLength == lengths[j])
-          break;
+    /* Warn about a mismatch a sequences name level */
+    if(j == -1) {
+      cerr << endl << "ERROR: Sequence \"" << seqsName[i] << "\" is not in "
+        << "CDS file." << endl << endl;
+      return false;
+    }
 
-        /* If nucleotide sequence is larger than protein sequence, warn about
-         * it and continue the verification process. It will used the 'Nth'
-         * first nucleotides for the conversion */
-        else if(seqLength < lengths[j]) {
-          if (!warnings)
-            cerr << endl;
-          warnings = true;
-          cerr << "WARNING: Sequence \"" << seqsName[i] << "\" will be cut at "
-            << "position " << seqLength << " (length: "<< lengths[j] << ")"
-            << endl;
-          break;
-        }
+    /* Once both ID matchs, compare its lengths. If both sequences have the
+     * same length, there is nothing to warn about */
+    if(seqLength == lengths[j])
+      continue;
 
-        /* It has been detected some indeterminations at the end of the protein
-         * sequence. That issue could be cause by some incomplete codons in the
-         * nucleotide sequences. This issue is solved adding as much 'N' symbols
-         * as it is needed to preserve the backtranslated alignment */
-        else if((indet > 0) && (indet > (seqLength - lengths[j])/3)) {
-          if (!warnings)
-            cerr << endl;
-          warnings = true;
-          cerr << "WARNING: Sequence \"" << seqsName[i] << "\" has some inde"
-            << "termination symbols 'X' at the end of sequence. They will be"
-            << " included in the final alignment." << endl;
-          break;
-        }
+    /* If nucleotide sequence is larger than protein sequence, warn about
+     * it and continue the verification process. It will used the 'Nth'
+     * first nucleotides for the conversion */
+    else if(seqLength < lengths[j]) {
+      if (!warnings)
+        cerr << endl;
+      warnings = true;
+      cerr << "WARNING: Sequence \"" << seqsName[i] << "\" will be cut at "
+        << "position " << seqLength << " (length: "<< lengths[j] << ")"
+        << endl;
+    }
 
-        /* If nucleotide sequence is shorter than protein sequence, return an
-         * error since it is not feasible to cut the input protein aligment to
-         * fit it into CDNA sequences size */
-        else {
-          if (!warnings)
-            cerr << endl;
-          warnings = true;
-          cerr << "WARNING: Sequence \"" << seqsName[i] << "\" has less nucleo"
-            << "tides (" << lengths[j] << ") than expected (" << seqLength
-            << "). It will be added N's to complete the sequence"  << endl;
-          break;
-        }
-      }
+    /* It has been detected some indeterminations at the end of the protein
+     * sequence. That issue could be cause by some incomplete codons in the
+     * nucleotide sequences. This issue is solved adding as much 'N' symbols
+     * as it is needed to preserve the backtranslated alignment */
+    else if((indet > 0) && (indet > (seqLength - lengths[j])/3)) {
+      if (!warnings)
+        cerr << endl;
+      warnings = true;
+      cerr << "WARNING: Sequence \"" << seqsName[i] << "\" has some inde"
+        << "termination symbols 'X' at the end of sequence. They will be"
+        << " included in the final alignment." << endl;
     }
 
-    /* Warn about a mismatch a sequences name level */
-    if(j == totalInputSeqs) {
-      cerr << endl << "ERROR: Sequence \"" << seqsName[i] << "\" is not in "
-        << "CDS file." << endl << endl;
-      return false;
+    /* If nucleotide sequence is shorter than protein sequence, return an
+     * error since it is not feasible to cut the input protein aligment to
+     * fit it into CDNA sequences size */
+    else {
+      if (!warnings)
+        cerr << endl;
+      warnings = true;
+      cerr << "WARNING: Sequence \"" << seqsName[i] << "\" has less nucleo"
+        << "tides (" << lengths[j] << ") than expected (" << seqLength
+        << "). It will be added N's to complete the sequence"  << endl;
     }
   }
 
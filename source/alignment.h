@@ -43,8 +43,16 @@
 
 #include "statisticsGaps.h"
 #include "sequencesMatrix.h"
+#include "namesIndex.h"
 #include "statisticsConservation.h"
 #include "similarityMatrix.h"
+#include "packedSequences.h"
+#include "pairwiseIdentities.h"
+#include "pairwiseOverlaps.h"
+#include "simdKernels.h"
+#include "threadPool.h"
+#include "lineReader.h"
+#include "compressedBuffer.h"
 #include "defines.h"
 #include "utils.h"
 
@@ -53,8 +61,6 @@ using namespace std;
 struct newValues {
   int residues;
   int sequences;
-  string *matrix;
-  string *seqsName;
 };
 
 /** \brief Class containing an alignment
@@ -98,6 +104,13 @@ class alignment {
 
   int blockSize;
 
+  /* Threads used to compute the pairwise sequences matrices */
+  int threadsNumber;
+
+  /* Should trimming methods only update the selection, without building
+   * the trimmed alignment? */
+  bool selectionOnly;
+
   string *sequences;
   string *seqsName;
   string *seqsInfo;
@@ -108,15 +121,21 @@ class alignment {
   /* Sequences */
   sequencesMatrix *seqMatrix;
 
+  /* Encoded sequences, built the first time they are needed */
+  packedSequences *packedSeqs;
+
+  /* Residues stored column by column, built the first time they are needed */
+  string *residueColumns;
+
   /* Statistics */
   statisticsGaps *sgaps;
   statisticsConservation *scons;
 
-  /* Sequences Identities */
-  float **identities;
+  /* Sequences Identities, shared by every method that needs them */
+  pairwiseIdentities *identities;
 
   /* Sequences Overlaps */
-  float **overlaps;
+  pairwiseOverlaps *overlaps;
 
   /* New Info */
   bool oldAlignment;
@@ -128,6 +147,21 @@ class alignment {
 
   /* ***** Fill the matrices from the input alignment ***** */
   bool fillMatrices(bool aligned);
+
+  /* ***** Grow the sequences storage used by the loaders ***** */
+  void growSequences(int newSize);
+
+  /* ***** Get the encoded sequences for a given indetermination ***** */
+  packedSequences *getPackedSequences(char indet);
+
+  /* ***** Get the identities between every pair of sequences ***** */
+  pairwiseIdentities *getPairwiseIdentities(char indet);
+
+  /* ***** Get the alignment residues stored column by column ***** */
+  string *getResidueColumns(void);
+
+  /* ***** Get the most similar sequence, in terms of identity, to each one ***** */
+  float **mostSimilarSequences(float *avgIdentity, float *avgMostSimilar);
   /* ***** ***** ***** ***** ***** ***** ***** ***** ***** */
 
   /* Alignment cleaning */
@@ -153,7 +187,7 @@ class alignment {
   alignment(string, string, string *, string *, string *, int, int, int, int,
     bool, int, int, bool, bool, int, int,
     bool, bool, int, int, int *, int *, int *, int,
-     int, int, float **, float **);
+     int, int);
 
   /* Overlap the operator = to use it as a constructor */
   alignment &operator=(const alignment &);
@@ -171,6 +205,16 @@ class alignment {
    */
   bool loadAlignment(char *alignmentFile);
 
+  /** \brief In-memory alignment loading method.
+   * \param alignmentName Name given to the alignment, as if it were its file.
+   * \param data Alignment content, in any of the input formats.
+   * \param size Alignment content size.
+   * \return \e true if the load is ok, \e false otherwise.
+   *
+   * Method that loads an alignment already read by somebody else.
+   */
+  bool loadAlignment(char *alignmentName, const char *data, long size);
+
   /** \brief Alignment storing method.
    * \param destFile Destination file name of the alignment.
    * \return \e true if all is ok, \e false if there were errors (i.e. the file doesn't exists).
@@ -186,6 +230,14 @@ class alignment {
    */
   bool printAlignment(void);
 
+  /** \brief Alignment writing method.
+   * \param output Stream where the alignment is written.
+   * \return \e true if all is ok, \e false if there were errors.
+   *
+   * Method that writes an alignment to a given stream, e.g. to keep it in memory.
+   */
+  bool printAlignment(ostream &output);
+
 
   /* Alignment trimming. */
 
@@ -410,25 +462,27 @@ class alignment {
 
   /* ********** NEW CODE ********** */
   /* ********** ******** ********** */
-  int formatInputAlignment(char *);
+  int formatInputAlignment(lineReader &);
+
+  bool readAlignment(lineReader &, bool, char *);
 
   int typeInputFile(void);
 
-  bool loadPhylipAlignment(char *);
+  bool loadPhylipAlignment(lineReader &, char *);
 
-  bool loadFastaAlignment(char *);
+  bool loadFastaAlignment(lineReader &, char *);
 
-  bool loadClustalAlignment(char *);
+  bool loadClustalAlignment(lineReader &, char *);
 
-  bool loadNexusAlignment(char *);
+  bool loadNexusAlignment(lineReader &, char *);
 
-  bool loadMegaInterleavedAlignment(char *);
+  bool loadMegaInterleavedAlignment(lineReader &, char *);
 
-  bool loadMegaNonInterleavedAlignment(char *);
+  bool loadMegaNonInterleavedAlignment(lineReader &, char *);
 
-  bool loadNBRF_PirAlignment(char *);
+  bool loadNBRF_PirAlignment(lineReader &, char *);
 
-  bool loadPhylip3_2Alignment(char *);
+  bool loadPhylip3_2Alignment(lineReader &, char *);
   /* ********** ******** ********** */
   /* ********** ******** ********** */
 
@@ -494,6 +548,10 @@ class alignment {
 
   void printSeqIdentity(void);
 
+  /* Maximum identity between any pair of sequences, average identity and
+   * average identity between the most similar sequences */
+  void getSeqIdentitySummary(float *, float *, float *);
+
   bool calculateSpuriousVector(float, float *);
 
   void checkTypeAlignment(void);
@@ -527,12 +585,23 @@ class alignment {
   void removeCols_SeqsAllGaps(newValues *);
 
   void fillNewDataStructure(string *, string *);
-  void fillNewDataStructure(newValues *);
+
+  alignment *getSelectedAlignment(void);
 
   // New Code: February/2012
   void calculateColIdentity(float *);
   void printColumnsIdentity_DescriptiveStats(void);
 
+  /* Maximum, minimum, average and standard deviation of the columns identity */
+  bool getColumnsIdentitySummary(float *, float *, float *, float *);
+
+  /* Fraction of columns without gaps, average and maximum fraction of gaps
+   * per column */
+  bool getGapsSummary(float *, float *, float *);
+
+  /* Minimum, average and maximum similarity values per column */
+  bool getConservationSummary(float *, float *, float *);
+
   // New Code: May/2012
   void setKeepSequencesFlag(bool);
 
@@ -543,6 +612,28 @@ class alignment {
 
   // Updated: June/2013
   bool prepareCodingSequence(bool, bool, alignment *);
+
+  /** \brief Threads number setting method.
+   * \param threads Number of threads to use.
+   *
+   * Method that sets how many threads share the computation of the pairwise
+   * matrices, i.e. sequences identities and overlaps as well as the identity
+   * matrix used by the similarity statistics. Results are the same whatever
+   * the number of threads is.
+   */
+  void setThreadsNumber(int);
+
+  /** \brief Selection-only trimming setting method.
+   * \param selection Whether trimming methods should only update the
+   * selection.
+   *
+   * Method that makes next trimming methods update the columns and sequences
+   * selection, removing those composed only by gaps as usual, and return NULL
+   * instead of building the trimmed alignment. It lets several methods be
+   * chained on the same alignment while the result is built once, by the
+   * last one.
+   */
+  void setSelectionOnly(bool);
 };
 
 #endif
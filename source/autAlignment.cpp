@@ -28,114 +28,161 @@
 #include "alignment.h"
 #include "defines.h"
 
+/* Data shared by all the tiles of the identities and overlaps matrices */
+struct scoresTiles {
+  packedSequences *packed;
+  int *residues;
+  pairwiseIdentities *identities;
+  pairwiseOverlaps *overlaps;
+  string *sequences;
+  int length;
+  char indet;
+};
+
 /* ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** */
-/* This function computes the identities values between the sequences from
- * the alignment */
+/* Compute the identity scores for the sequences pairs in a tile. Identity
+ * score between two sequences is the ratio of identical residues by the total
+ * length (common and no-common residues) among them */
 /* ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** */
-void alignment::calculateSeqIdentity(void) {
+static void identitiesTile(void *data, int firstRow, int lastRow, int firstColumn, int lastColumn) {
 
-  int i, j, k, hit, dst;
-  char indet;
+  scoresTiles *tiles = (scoresTiles *) data;
+  int i, j;
+#ifdef SIMD_KERNELS
+  int identical, joint;
+
+  for(i = firstRow; i < lastRow; i++)
+    for(j = utils::max(firstColumn, i + 1); j < lastColumn; j++) {
+      simdKernels::countIdentities(tiles -> sequences[i].data(), tiles -> sequences[j].data(), tiles -> length,
+        tiles -> indet, &identical, &joint);
+      tiles -> identities -> setIdentity(i, j, (float) identical/joint);
+    }
+#else
+  for(i = firstRow; i < lastRow; i++)
+    for(j = utils::max(firstColumn, i + 1); j < lastColumn; j++)
+      tiles -> identities -> setIdentity(i, j, (float) tiles -> packed -> countIdenticalResidues(i, j) /
+        (tiles -> residues[i] + tiles -> residues[j] - tiles -> packed -> countSharedResidues(i, j)));
+#endif
+}
 
-  /* Depending on alignment type, indetermination symbol will be one or other */
-  indet = getTypeAlignment() == AAType ? 'X' : 'N';
+/* ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** */
+/* Compute the overlap scores for the sequences pairs in a tile. Overlap
+ * score between two sequences is the ratio of shared valid residues divided
+ * by the sequence length taken as reference, so only the shared residues of
+ * each pair are needed for both scores */
+/* ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** */
+static void overlapsTile(void *data, int firstRow, int lastRow, int firstColumn, int lastColumn) {
 
-  /* Create identities matrix to store identities scores */
-  identities = new float*[sequenNumber];
+  scoresTiles *tiles = (scoresTiles *) data;
+  int i, j;
 
-  /* For each seq, compute its identity score against the others in the MSA */
-  for(i = 0; i < sequenNumber; i++) {
-    identities[i] = new float[sequenNumber];
+  for(i = firstRow; i < lastRow; i++)
+    for(j = utils::max(firstColumn, i + 1); j < lastColumn; j++)
+      tiles -> overlaps -> setShared(i, j, tiles -> packed -> countSharedResidues(i, j));
+}
 
-    /* It's a symmetric matrix, copy values that have been already computed */
-    for(j = 0; j < i; j++)
-      identities[i][j] = identities[j][i];
-    identities[i][i] = 0;
+/* ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** */
+/* This function computes the identities values between the sequences from
+ * the alignment, unless they are already available */
+/* ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** */
+void alignment::calculateSeqIdentity(void) {
 
-    /* Compute identity scores for the current sequence against the rest */
-    for(j = i + 1; j < sequenNumber; j++) {
-      for(k = 0, hit = 0, dst = 0; k < residNumber; k++) {
-      /* If one of the two positions is a valid residue,
-       * count it for the common length */
-        if(((sequences[i][k] != indet) && (sequences[i][k] != '-')) ||
-           ((sequences[j][k] != indet) && (sequences[j][k] != '-'))) {
-          dst++;
-          /* If both positions are the same, count a hit */
-          if(sequences[i][k] == sequences[j][k])
-            hit++;
-        }
-      }
+  /* Depending on alignment type, indetermination symbol will be one or other */
+  getPairwiseIdentities(getTypeAlignment() == AAType ? 'X' : 'N');
+}
 
-      /* Identity score between two sequences is the ratio of identical residues
-       * by the total length (common and no-common residues) among them */
-      identities[i][j] = (float) hit/dst;
-    }
+/* ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** */
+/* Return the identities between every pair of sequences, computing them the
+ * first time they are requested. The same scores are shared by the sequences
+ * identity statistics, the clustering methods and the similarity statistics,
+ * and they are only computed again if a different indetermination symbol is
+ * asked for */
+/* ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** */
+pairwiseIdentities *alignment::getPairwiseIdentities(char indet) {
+
+  scoresTiles tiles;
+
+  if(identities != NULL) {
+    if(identities -> getIndetermination() == indet)
+      return identities;
+    delete identities;
   }
+
+#ifdef SIMD_KERNELS
+  /* Vectorized kernels compare more residues at a time than the encoded
+   * sequences words hold, so sequences are compared as they are */
+  tiles.sequences = sequences;
+  tiles.length = residNumber;
+  tiles.indet = indet;
+  tiles.residues = NULL;
+#else
+  /* Sequences are compared a whole word of residues at a time */
+  tiles.packed = getPackedSequences(indet);
+
+  /* Count how many valid residues, i.e. neither gaps nor indeterminations,
+   * there are in each sequence */
+  tiles.residues = new int[sequenNumber];
+  for(int i = 0; i < sequenNumber; i++)
+    tiles.residues[i] = tiles.packed -> countResidues(i);
+#endif
+
+  /* Compute identity scores for each sequence against the following ones,
+   * splitting the pairs among the available threads. Since the scores are
+   * symmetric, there is no need to compute the other half */
+  identities = new pairwiseIdentities(sequenNumber, indet);
+  tiles.identities = identities;
+  threadPool::computePairs(sequenNumber, threadsNumber, identitiesTile, &tiles);
+
+  delete [] tiles.residues;
+
+  return identities;
 }
 
 void alignment::calculateSeqOverlap(void) {
   /* Compute the overlap between sequences taken each of them as the reference
    * to compute such scores. It will lead to a non-symmetric matrix. */
 
-  int i, j, k, shared, referenceLength;
+  scoresTiles tiles;
   char indet;
+  int i;
 
   /* Depending on alignment type, indetermination symbol will be one or other */
   indet = getTypeAlignment() == AAType ? 'X' : 'N';
 
-  /* Create overlap matrix to store overlap scores */
-  overlaps = new float*[sequenNumber];
+  /* Valid residues are compared a whole word at a time */
+  tiles.packed = getPackedSequences(indet);
 
-  /* For each seq, compute its overlap score against the others in the MSA */
-  for(i = 0; i < sequenNumber; i++) {
-    overlaps[i] = new float[sequenNumber];
-
-    for(j = 0; j < sequenNumber; j++) {
-      for(k = 0, shared = 0, referenceLength = 0; k < residNumber; k++) {
-        /* If there a valid residue for the reference sequence, then see if
-         * there is a valid residue for the other sequence. */
-        if((sequences[i][k] != indet) && (sequences[i][k] != '-')) {
-          referenceLength++;
-          if ((sequences[j][k] != indet) && (sequences[j][k] != '-'))
-            shared++;
-        }
-      }
-      /* Overlap score between two sequences is the ratio of shared valid
-       * residues divided by the sequence length taken as reference. The
-       * overlaps matrix, therefore, will be not symmetric. */
-      overlaps[i][j] = (float) shared/referenceLength;
-    }
-  }
+  /* Sequences lengths, without gaps and indeterminations, used as reference */
+  overlaps = new pairwiseOverlaps(sequenNumber, residNumber);
+  for(i = 0; i < sequenNumber; i++)
+    overlaps -> setResidues(i, tiles.packed -> countResidues(i));
+
+  /* The overlaps matrix will be not symmetric, although the shared residues
+   * only need to be computed once for each pair */
+  tiles.overlaps = overlaps;
+  threadPool::computePairs(sequenNumber, threadsNumber, overlapsTile, &tiles);
 }
 
 void alignment::calculateRelaxedSeqIdentity(void) {
   /* Raw approximation of sequence identity computation designed for reducing
    * comparisons for huge alignemnts */
 
-  int i, j, k, hit;
+  int i, j, hit;
 
-  /* Create identities matrix to store identities scores */
-  identities = new float*[sequenNumber];
+  /* Create identities matrix to store identities scores. They will be used
+   * instead of the exact ones for the alignment indetermination symbol */
+  delete identities;
+  identities = new pairwiseIdentities(sequenNumber, getTypeAlignment() == AAType ? 'X' : 'N');
 
-  /* For each seq, compute its identity score against the others in the MSA */
+  /* For each seq, compute its identity score against the following ones, the
+   * matrix is symmetric */
   for(i = 0; i < sequenNumber; i++) {
-    identities[i] = new float[sequenNumber];
-
-    /* It's a symmetric matrix, copy values that have been already computed */
-    for(j = 0; j < i; j++)
-      identities[i][j] = identities[j][i];
-    identities[i][i] = 0;
-
-    /* Compute identity score between the selected sequence and the others */
     for(j = i + 1; j < sequenNumber; j++) {
-      for(k = 0, hit = 0; k < residNumber; k++) {
-        /* If both positions are the same, count a hit */
-        if(sequences[i][k] == sequences[j][k])
-          hit++;
-      }
+      /* Count how many positions are the same in both sequences */
+      hit = simdKernels::countMatches(sequences[i].data(), sequences[j].data(), residNumber);
     /* Raw identity score is computed as the ratio of identical residues between
      * alignment length */
-      identities[i][j] = (float) hit/residNumber;
+      identities -> setIdentity(i, j, (float) hit/residNumber);
     }
   }
 }
@@ -154,8 +201,7 @@ int alignment::selectMethod(void) {
 
   /* ***** ***** ***** ***** ***** ***** ***** ***** */
   /* Ask for the sequence identities assesment */
-  if(identities == NULL)
-    calculateSeqIdentity();
+  calculateSeqIdentity();
   /* ***** ***** ***** ***** ***** ***** ***** ***** */
 
   /* ***** ***** ***** ***** ***** ***** ***** ***** */
@@ -167,8 +213,8 @@ int alignment::selectMethod(void) {
   for(i = 0; i < sequenNumber; i++) {
     for(j = 0, mx = 0, avg = 0; j < sequenNumber; j++) {
       if(i != j) {
-        mx  = mx < identities[i][j] ? identities[i][j] : mx;
-        avg += identities[i][j];
+        mx  = mx < identities -> getIdentity(i, j) ? identities -> getIdentity(i, j) : mx;
+        avg += identities -> getIdentity(i, j);
       }
     }
     avgSeq += avg/(sequenNumber - 1);
@@ -211,41 +257,11 @@ int alignment::selectMethod(void) {
 /* ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** */
 void alignment::printSeqIdentity(void) {
 
-  int i, j, k, pos, maxLongName;
-  float mx, avg, maxAvgSeq = 0, maxSeq = 0, avgSeq = 0, **maxs;
-
-  /* Ask for the sequence identities assesment */
-  if(identities == NULL)
-    calculateSeqIdentity();
+  int i, j, maxLongName;
+  float maxAvgSeq, maxSeq = 0, avgSeq, **maxs;
 
   /* For each sequence, we look for its most similar one */
-  maxs = new float*[sequenNumber];
-
-  for(i = 0; i < sequenNumber; i++) {
-    maxs[i] = new float[2];
-
-    /* Get the most similar sequence to the current one in term of identity */
-    for(k = 0, mx = 0, avg = 0, pos = i; k < sequenNumber; k++) {
-      if(i != k) {
-        avg += identities[i][k];
-        if(mx < identities[i][k]) {
-          mx = identities[i][k];
-          pos = k;
-        }
-      }
-    }
-    /* Update global average variables*/
-    avgSeq += avg/(sequenNumber - 1);
-    maxAvgSeq += mx;
-
-    /* Save the maximum average identity value for each sequence */
-    maxs[i][0] = mx;
-    maxs[i][1] = pos;
-  }
-
-  /* Compute general averages */
-  avgSeq = avgSeq/sequenNumber;
-  maxAvgSeq = maxAvgSeq/sequenNumber;
+  maxs = mostSimilarSequences(&avgSeq, &maxAvgSeq);
 
   /* Compute longest sequences name */
   for(i = 0, maxLongName = 0; i < sequenNumber; i++)
@@ -270,10 +286,10 @@ void alignment::printSeqIdentity(void) {
   for(i = 0; i < sequenNumber; i++) {
     cout << endl << setw(maxLongName + 2) << left << seqsName[i] << "\t";
     for(j = 0; j < i; j++)
-      cout << setiosflags(ios::left) << setw(10) << identities[i][j] << "\t";
+      cout << setiosflags(ios::left) << setw(10) << identities -> getIdentity(i, j) << "\t";
     cout << setiosflags(ios::left) << setw(10) << 1.00 << "\t";
     for(j = i + 1; j < sequenNumber; j++)
-      cout << setiosflags(ios::left) << setw(10) << identities[i][j] << "\t";
+      cout << setiosflags(ios::left) << setw(10) << identities -> getIdentity(i, j) << "\t";
   }
   cout << endl;
 
@@ -287,6 +303,74 @@ void alignment::printSeqIdentity(void) {
     cout << setw(maxLongName + 2) << left << seqsName[i]
       << "\t" << setiosflags(ios::left) << setw(5)
       << maxs[i][0] << "\t" << seqsName[(int) maxs[i][1]] << endl;
+
+  for(i = 0; i < sequenNumber; i++)
+    delete [] maxs[i];
+  delete [] maxs;
+}
+
+/* ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** */
+/* This method returns the summary values printed by printSeqIdentity */
+/* ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** */
+void alignment::getSeqIdentitySummary(float *maxIdentity, float *avgIdentity, float *avgMostSimilar) {
+
+  float **maxs;
+  int i;
+
+  maxs = mostSimilarSequences(avgIdentity, avgMostSimilar);
+
+  for(i = 0, *maxIdentity = 0; i < sequenNumber; i++) {
+    if(maxs[i][0] > *maxIdentity)
+      *maxIdentity = maxs[i][0];
+    delete [] maxs[i];
+  }
+  delete [] maxs;
+}
+
+/* ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** */
+/* This method looks for the most similar sequence, in terms of identity, to
+ * each sequence in the alignment. It returns the identity and the position
+ * of that sequence for each one, as well as the average identity between all
+ * sequences and between the most similar ones */
+/* ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** */
+float **alignment::mostSimilarSequences(float *avgIdentity, float *avgMostSimilar) {
+
+  int i, k, pos;
+  float mx, avg, maxAvgSeq = 0, avgSeq = 0, **maxs;
+
+  /* Ask for the sequence identities assesment */
+  calculateSeqIdentity();
+
+  /* For each sequence, we look for its most similar one */
+  maxs = new float*[sequenNumber];
+
+  for(i = 0; i < sequenNumber; i++) {
+    maxs[i] = new float[2];
+
+    /* Get the most similar sequence to the current one in term of identity */
+    for(k = 0, mx = 0, avg = 0, pos = i; k < sequenNumber; k++) {
+      if(i != k) {
+        avg += identities -> getIdentity(i, k);
+        if(mx < identities -> getIdentity(i, k)) {
+          mx = identities -> getIdentity(i, k);
+          pos = k;
+        }
+      }
+    }
+    /* Update global average variables*/
+    avgSeq += avg/(sequenNumber - 1);
+    maxAvgSeq += mx;
+
+    /* Save the maximum average identity value for each sequence */
+    maxs[i][0] = mx;
+    maxs[i][1] = pos;
+  }
+
+  /* Compute general averages */
+  *avgIdentity = avgSeq/sequenNumber;
+  *avgMostSimilar = maxAvgSeq/sequenNumber;
+
+  return maxs;
 }
 
 void alignment::printSeqOverlap(void) {
@@ -307,9 +391,9 @@ void alignment::printSeqOverlap(void) {
     /* Get the most similar sequence to the current one in term of overlap */
     for(k = 0, mx = 0, avg = 0, pos = i; k < sequenNumber; k++) {
       if(i != k) {
-        avg += overlaps[i][k];
-        if(mx < overlaps[i][k]) {
-          mx = overlaps[i][k];
+        avg += overlaps -> getOverlap(i, k);
+        if(mx < overlaps -> getOverlap(i, k)) {
+          mx = overlaps -> getOverlap(i, k);
           pos = k;
         }
       }
@@ -350,7 +434,7 @@ void alignment::printSeqOverlap(void) {
   for(i = 0; i < sequenNumber; i++) {
     cout << endl << setw(maxLongName + 2) << left << seqsName[i] << "\t";
     for(j = 0; j < sequenNumber; j++)
-      cout << setiosflags(ios::left) << setw(10) << overlaps[i][j] << "\t";
+      cout << setiosflags(ios::left) << setw(10) << overlaps -> getOverlap(i, j) << "\t";
   }
   cout << endl;
 }
@@ -362,44 +446,32 @@ void alignment::printSeqOverlap(void) {
 /* *** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** *** */
 void alignment::calculateColIdentity(float *ColumnIdentities) {
 
-  int i, j, counter, pos, max, columnLen;
-  char letter, indet, gapSymbol;
-  string column;
+  int i, j, max, columnLen, counter[256];
+  char indet, gapSymbol;
+  unsigned char letter;
+  string *columns;
 
   /* Initialize some data for make computation more precise */
   indet = getTypeAlignment() == AAType ? 'X' : 'N';
   gapSymbol = '-';
+  columns = getResidueColumns();
 
   /* Compute identity score for the most frequent residue, it can be as well
    * gaps and indeterminations, for each column */
-  for(i = 0, max = 0; i < residNumber; i++, max = 0, column.clear()) {
+  for(i = 0; i < residNumber; i++) {
 
-    /* Get residues from each column in capital letters */
-    for(j = 0; j < sequenNumber; j++)
-      /* Discard gaps and indeterminations from calculations */
-      if((toupper(sequences[j][i]) != indet) && (sequences[j][i] != gapSymbol))
-        column += toupper(sequences[j][i]);
-    columnLen = column.size();
-
-    /* Count letter frequency. It only matter the frequency. Use some shorcuts
-     * to speed-up the process */
-    while (!column.empty()) {
-      letter = column[0];
-      counter = 0;
-      pos = 0;
-
-      do {
-        counter += 1;
-        column.erase(pos, 1);
-        pos = column.find(letter, pos);
-      } while(pos != (int) string::npos);
+    /* Count residues frequency in capital letters. Gaps and indeterminations
+     * are discarded from calculations */
+    utils::initlVect(counter, 256, 0);
+    for(j = 0, max = 0, columnLen = 0; j < sequenNumber; j++) {
+      letter = toupper(columns[i][j]);
+      if((letter == indet) || (columns[i][j] == gapSymbol))
+        continue;
+      columnLen++;
 
       /* Keep only the most frequent residue */
-      if(counter > max)
-        max = counter;
-      /* If column size is smaller than the current max, stop the count */
-      if((int) column.size() < max)
-        break;
+      if(++counter[letter] > max)
+        max = counter[letter];
     }
 
     /* Store column identity values */
@@ -410,6 +482,23 @@ void alignment::calculateColIdentity(float *ColumnIdentities) {
 
 void alignment::printColumnsIdentity_DescriptiveStats(void) {
 
+  float avg, std, max, min;
+
+  getColumnsIdentitySummary(&max, &min, &avg, &std);
+
+  /* Print general descriptive stats */
+  cout << "#maxColIdentity\t" << max << endl;
+  cout << "#minColIdentity\t" << min << endl;
+  cout << "#avgColIdentity\t" << avg << endl;
+  cout << "#stdColIdentity\t" << std << endl;
+}
+
+/* ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** */
+/* This method computes the descriptive stats for the columns identity. It
+ * returns false when no column has any residue */
+/* ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** */
+bool alignment::getColumnsIdentitySummary(float *maxIdentity, float *minIdentity, float *avgIdentity, float *stdIdentity) {
+
   float *colIdentities, avg, std, max, min;
   int i, positions;
 
@@ -438,11 +527,13 @@ void alignment::printColumnsIdentity_DescriptiveStats(void) {
       std += pow((colIdentities[i] - avg), 2);
   std = sqrt(std/positions);
 
-  /* Print general descriptive stats */
-  cout << "#maxColIdentity\t" << max << endl;
-  cout << "#minColIdentity\t" << min << endl;
-  cout << "#avgColIdentity\t" << avg << endl;
-  cout << "#stdColIdentity\t" << std << endl;
+  delete [] colIdentities;
+
+  *maxIdentity = max;
+  *minIdentity = min;
+  *avgIdentity = avg;
+  *stdIdentity = std;
+  return (positions != 0);
 }
 
 
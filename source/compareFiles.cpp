@@ -28,21 +28,144 @@
 
 #include "compareFiles.h"
 #include "alignment.h"
+#include "threadPool.h"
+#include "defines.h"
 
 #define LONG 80
 
+/* Data shared by all the comparisons among alignments. hits[i][l][j] stores
+ * how many residue pairs from the column j of the alignment i are aligned as
+ * well in the alignment l */
+struct consistencyHits {
+  sequencesMatrix **matrices, *selected;
+  int *firsts, *seconds, *numResidues, ***hits, **selectedHits;
+  int numSeqs, numAlignments, blocks;
+};
+
+/* ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** */
+/* Count the residue pairs aligned in both alignments of a pair. Every pair
+ * aligned in both of them is a hit for the columns where it is at in each
+ * alignment, so the pair is only compared once instead of once from each
+ * side */
+/* ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** */
+static void comparePair(void *data, int pair) {
+
+  consistencyHits *pairs = (consistencyHits *) data;
+  int *columnSeqMatrix, *columnSeqMatrixAux;
+  int i, j, k, l, m, column, lastColumn, hits;
+
+  i = pairs -> firsts[pair];
+  l = pairs -> seconds[pair];
+
+  columnSeqMatrix = new int[pairs -> numSeqs];
+  columnSeqMatrixAux = new int[pairs -> numSeqs];
+
+  for(j = 0; j < pairs -> numResidues[i]; j++) {
+    pairs -> matrices[i] -> getColumn(j, columnSeqMatrix);
+
+    for(k = 0, lastColumn = -1; k < pairs -> numSeqs; k++) {
+      /* Look for the column of the other alignment with the same
+       * residue, if there is a residue, not a gap */
+      if(columnSeqMatrix[k] == 0)
+        continue;
+      column = pairs -> matrices[l] -> getResidueColumn(columnSeqMatrix[k], k);
+      if(column == -1)
+        continue;
+
+      /* Consecutive residues are usually at the same column */
+      if(column != lastColumn) {
+        pairs -> matrices[l] -> getColumn(column, columnSeqMatrixAux);
+        lastColumn = column;
+      }
+
+      /* and count the similar residue pairs */
+      for(m = k + 1, hits = 0; m < pairs -> numSeqs; m++)
+        if((columnSeqMatrix[m] != 0) && (columnSeqMatrix[m] == columnSeqMatrixAux[m]))
+          hits++;
+
+      pairs -> hits[i][l][j] += hits;
+      pairs -> hits[l][i][column] += hits;
+    }
+  }
+
+  delete [] columnSeqMatrix;
+  delete [] columnSeqMatrixAux;
+}
+
+/* ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** */
+/* Count, for a block of columns of the selected alignment, the residue pairs
+ * aligned as well in one of the alignments to compare */
+/* ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** */
+static void compareSelected(void *data, int item) {
+
+  consistencyHits *pairs = (consistencyHits *) data;
+  int *columnSeqMatrix, *columnSeqMatrixAux;
+  int i, j, k, ll, column, lastColumn, hit, last;
+
+  k = item % pairs -> numAlignments;
+  i = (item / pairs -> numAlignments) * COMPAREBLOCK;
+  last = utils::min(i + COMPAREBLOCK, pairs -> numResidues[0]);
+
+  columnSeqMatrix = new int[pairs -> numSeqs];
+  columnSeqMatrixAux = new int[pairs -> numSeqs];
+
+  for(; i < last; i++) {
+    pairs -> selected -> getColumn(i, columnSeqMatrix);
+
+    for(j = 0, lastColumn = -1, hit = 0; j < pairs -> numSeqs; j++) {
+      /* We look for the same residue in the same row in
+       * the alignment to compare */
+      if(columnSeqMatrix[j] == 0)
+        continue;
+      column = pairs -> matrices[k] -> getResidueColumn(columnSeqMatrix[j], j);
+      if(column == -1)
+        continue;
+
+      if(column != lastColumn) {
+        pairs -> matrices[k] -> getColumn(column, columnSeqMatrixAux);
+        lastColumn = column;
+      }
+
+      /* We count when we get the same residue pairs */
+      for(ll = j + 1; ll < pairs -> numSeqs; ll++)
+        if((columnSeqMatrix[ll] != 0) && (columnSeqMatrix[ll] == columnSeqMatrixAux[ll]))
+          hit++;
+    }
+    pairs -> selectedHits[k][i] = hit;
+  }
+
+  delete [] columnSeqMatrix;
+  delete [] columnSeqMatrixAux;
+}
+
+/* ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** */
+/* Count how many residue pairs a column has */
+/* ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** */
+static int columnPairs(int *columnSeqMatrix, int numSeqs) {
+
+  int i, residues;
+
+  for(i = 0, residues = 0; i < numSeqs; i++)
+    if(columnSeqMatrix[i] != 0)
+      residues++;
+
+  return residues * (residues - 1) / 2;
+}
+
 /* ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** */
 /* This method compares a set of alignment in order to select the most
  * consistent one respect of the other ones. To compute the consistency
  * values we use the proportion of residue pairs per column in the aligs
  * to compare */
 /* ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** */
-int compareFiles::algorithm(alignment **vectAlignments, char **fileNames, float *columnsValue, int numAlignments, bool verbosity) {
+int compareFiles::algorithm(alignment **vectAlignments, char **fileNames, float *columnsValue, int numAlignments, bool verbosity,
+  int threads) {
 
-  int *numResiduesAlig, *correspNames, *columnSeqMatrix, *columnSeqMatrixAux;
-  int i, j, k, l, m, numSeqs, pairRes, hits, alig = 0;
+  int *numResiduesAlig, *correspNames, *columnSeqMatrix;
+  int i, j, l, numSeqs, pairRes, hits, numPairs, alig = 0;
   float max = 0, value = 0, **vectHits;
   bool appearErrors = false;
+  consistencyHits pairs;
   string *names;
 
   /* ***** ***** ***** ***** ***** ***** ***** ***** */
@@ -58,7 +181,6 @@ int compareFiles::algorithm(alignment **vectAlignments, char **fileNames, float
   numResiduesAlig = new int[numAlignments];
   columnSeqMatrix = new int[numSeqs];
   vectHits = new float*[numAlignments];
-  columnSeqMatrixAux = new int[numSeqs];
   /* ***** ***** ***** ***** ***** ***** ***** ***** */
 
   /* ***** ***** ***** ***** ***** ***** ***** ***** */
@@ -102,6 +224,36 @@ int compareFiles::algorithm(alignment **vectAlignments, char **fileNames, float
     numResiduesAlig[i] =  vectAlignments[i] -> getNumAminos();
   /* ***** ***** ***** ***** ***** ***** ***** ***** */
 
+  /* ***** ***** ***** ***** ***** ***** ***** ***** */
+  /* Compare every pair of alignments once, sharing
+   * the pairs among the available threads */
+  if(!appearErrors) {
+    pairs.numSeqs = numSeqs;
+    pairs.numResidues = numResiduesAlig;
+    pairs.matrices = new sequencesMatrix*[numAlignments];
+    pairs.hits = new int**[numAlignments];
+    for(i = 0; i < numAlignments; i++) {
+      pairs.matrices[i] = vectAlignments[i] -> getSeqMatrix();
+      pairs.hits[i] = new int*[numAlignments];
+      for(l = 0; l < numAlignments; l++) {
+        pairs.hits[i][l] = new int[numResiduesAlig[i]];
+        utils::initlVect(pairs.hits[i][l], numResiduesAlig[i], 0);
+      }
+    }
+
+    numPairs = numAlignments * (numAlignments - 1) / 2;
+    pairs.firsts = new int[numPairs + 1];
+    pairs.seconds = new int[numPairs + 1];
+    for(i = 0, numPairs = 0; i < numAlignments; i++)
+      for(l = i + 1; l < numAlignments; l++, numPairs++) {
+        pairs.firsts[numPairs] = i;
+        pairs.seconds[numPairs] = l;
+      }
+
+    threadPool::computeItems(numPairs, threads, comparePair, &pairs);
+  }
+  /* ***** ***** ***** ***** ***** ***** ***** ***** */
+
   /* ***** ***** ***** ***** ***** ***** ***** ***** */
   /* Start the comparison among the alignments */
   for(i = 0; ((i < numAlignments) && (!appearErrors)); i++, value = 0) {
@@ -119,55 +271,16 @@ int compareFiles::algorithm(alignment **vectAlignments, char **fileNames, float
     /* ***** ***** ***** ***** ***** ***** ***** ***** */
 
     /* ***** ***** ***** ***** ***** ***** ***** ***** */
-    for(j = 0, pairRes = 0, hits = 0; j < numResiduesAlig[i]; j++, pairRes = 0, hits = 0) {
+    for(j = 0; j < numResiduesAlig[i]; j++) {
 
       /* ***** ***** ***** ***** ***** ***** ***** ***** */
-      /* Get back each column from the current selected
-       * alignment */
-      vectAlignments[i] -> getColumnSeqMatrix(j, columnSeqMatrix);
-      /* ***** ***** ***** ***** ***** ***** ***** ***** */
+      /* Every residue pair from the column is looked for
+       * in the rest of alignments */
+      pairs.matrices[i] -> getColumn(j, columnSeqMatrix);
+      pairRes = (numAlignments - 1) * columnPairs(columnSeqMatrix, numSeqs);
 
-      /* ***** ***** ***** ***** ***** ***** ***** ***** */
-      /* For each position from the previous recovered
-       * columns, we carry out the analysis to detect the
-       * same residues pair in the rest of the alignmetns */
-      for(k = 0; k < numSeqs; k++) {
-
-        /* ***** ***** ***** ***** ***** ***** ***** ***** */
-        /* If there is a valid residue, we go ahead with
-         * the analysis */
-        if(columnSeqMatrix[k] != 0) {
-          /* ***** ***** ***** ***** ***** ***** ***** ***** */
-          for(l = 0; l < i; l++) {
-			/* Recover the residue pairs from the others aligs */
-            vectAlignments[l] -> getColumnSeqMatrix(columnSeqMatrix[k], k, columnSeqMatrixAux);
-            /* ***** ***** ***** ***** ***** ***** ***** ***** */
-			/* and count the similar residue pairs */
-            for(m = k + 1; m < numSeqs; m++)
-              if(columnSeqMatrix[m] != 0) {
-                if(columnSeqMatrix[m] == columnSeqMatrixAux[m])
-                  hits++;
-                pairRes++;
-              }
-            }
-          /* ***** ***** ***** ***** ***** ***** ***** ***** */
-
-          /* ***** ***** ***** ***** ***** ***** ***** ***** */
-          for(l = i + 1; l < numAlignments; l++) {
-			/* Recover the residue pairs from the others aligs */
-            vectAlignments[l] -> getColumnSeqMatrix(columnSeqMatrix[k], k, columnSeqMatrixAux);
-            /* ***** ***** ***** ***** ***** ***** ***** ***** */
-			/* and count the similar residue pairs */
-            for(m = k + 1; m < numSeqs; m++)
-              if(columnSeqMatrix[m] != 0) {
-                if(columnSeqMatrix[m] == columnSeqMatrixAux[m])
-                  hits++;
-                pairRes++;
-              }
-            }
-          /* ***** ***** ***** ***** ***** ***** ***** ***** */
-        }
-      }
+      for(l = 0, hits = 0; l < numAlignments; l++)
+        hits += pairs.hits[i][l][j];
       /* ***** ***** ***** ***** ***** ***** ***** ***** */
 
       /* ***** ***** ***** ***** ***** ***** ***** ***** */
@@ -218,15 +331,25 @@ int compareFiles::algorithm(alignment **vectAlignments, char **fileNames, float
 
   /* ***** ***** ***** ***** ***** ***** ***** ***** */
   /* Deallocate memmory */
-  for(i = 0; ((i < numAlignments) && (!appearErrors)); i++)
+  for(i = 0; ((i < numAlignments) && (!appearErrors)); i++) {
+    for(l = 0; l < numAlignments; l++)
+      delete [] pairs.hits[i][l];
+    delete [] pairs.hits[i];
     delete [] vectHits[i];
+  }
   delete [] vectHits;
 
+  if(!appearErrors) {
+    delete [] pairs.hits;
+    delete [] pairs.matrices;
+    delete [] pairs.firsts;
+    delete [] pairs.seconds;
+  }
+
   delete [] names;
   delete [] correspNames;
   delete [] numResiduesAlig;
   delete [] columnSeqMatrix;
-  delete [] columnSeqMatrixAux;
   /* ***** ***** ***** ***** ***** ***** ***** ***** */
 
   /* ***** ***** ***** ***** ***** ***** ***** ***** */
@@ -241,11 +364,13 @@ int compareFiles::algorithm(alignment **vectAlignments, char **fileNames, float
 /* This method returns the consistency value vector for a given alignment
  * against a set of alignments with the same sequences */
 /* ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** */
-bool compareFiles::forceComparison(alignment **vectAlignments, int numAlignments, alignment *selected, float *columnsValue) {
+bool compareFiles::forceComparison(alignment **vectAlignments, int numAlignments, alignment *selected, float *columnsValue,
+  int threads) {
 
-  int *correspNames, *columnSeqMatrix, *columnSeqMatrixAux;
-  int i, j, k, ll, numResidues, numSeqs, pairRes, hit;
+  int *correspNames, *columnSeqMatrix;
+  int i, k, numResidues, numSeqs, pairRes, hit;
   bool appearErrors = false;
+  consistencyHits pairs;
   string *names;
 
   /* ***** ***** ***** ***** ***** ***** ***** ***** */
@@ -267,7 +392,6 @@ bool compareFiles::forceComparison(alignment **vectAlignments, int numAlignments
   names = new string[numSeqs];
   correspNames = new int[numSeqs];
   columnSeqMatrix = new int[numSeqs];
-  columnSeqMatrixAux = new int[numSeqs];
   /* ***** ***** ***** ***** ***** ***** ***** ***** */
 
   /* ***** ***** ***** ***** ***** ***** ***** ***** */
@@ -306,50 +430,41 @@ bool compareFiles::forceComparison(alignment **vectAlignments, int numAlignments
   }
   /* ***** ***** ***** ***** ***** ***** ***** ***** */
 
+  /* ***** ***** ***** ***** ***** ***** ***** ***** */
+  /* Compare each block of columns against each of the
+   * alignments, sharing them among the available
+   * threads */
+  if(!appearErrors) {
+    pairs.numSeqs = numSeqs;
+    pairs.numAlignments = numAlignments;
+    pairs.numResidues = &numResidues;
+    pairs.selected = selected -> getSeqMatrix();
+    pairs.matrices = new sequencesMatrix*[numAlignments];
+    pairs.selectedHits = new int*[numAlignments];
+    for(k = 0; k < numAlignments; k++) {
+      pairs.matrices[k] = vectAlignments[k] -> getSeqMatrix();
+      pairs.selectedHits[k] = new int[numResidues];
+    }
+
+    pairs.blocks = (numResidues + COMPAREBLOCK - 1) / COMPAREBLOCK;
+    threadPool::computeItems(pairs.blocks * numAlignments, threads, compareSelected, &pairs);
+  }
+  /* ***** ***** ***** ***** ***** ***** ***** ***** */
+
   /* ***** ***** ***** ***** ***** ***** ***** ***** */
   /* Do the same analysis for each column */
-  for(i = 0, pairRes = 0, hit = 0; ((i < numResidues) && (!appearErrors)); i++, pairRes = 0, hit = 0) {
+  for(i = 0; ((i < numResidues) && (!appearErrors)); i++) {
 
     /* ***** ***** ***** ***** ***** ***** ***** ***** */
-    /* We get back the sequence position for each residue
-     * from every column in the selected alignment */
-    utils::initlVect(columnSeqMatrix, numSeqs, 0);
-    selected -> getColumnSeqMatrix(i, columnSeqMatrix);
-    /* ***** ***** ***** ***** ***** ***** ***** ***** */
+    /* Every residue pair from the column is looked for
+     * in each alignment */
+    pairs.selected -> getColumn(i, columnSeqMatrix);
+    pairRes = numAlignments * columnPairs(columnSeqMatrix, numSeqs);
 
+    for(k = 0, hit = 0; k < numAlignments; k++)
+      hit += pairs.selectedHits[k][i];
     /* ***** ***** ***** ***** ***** ***** ***** ***** */
-    /* For each residue pairs, we look for it in the rest
-     * of alignments */
-    for(j = 0; j < numSeqs; j++) {
 
-      /* ***** ***** ***** ***** ***** ***** ***** ***** */
-      /* If there is a residue, not a gap, we carry out the
-       * assesment */
-      if(columnSeqMatrix[j] != 0) {
-        for(k = 0; k < numAlignments; k++) {
-
-          /* ***** ***** ***** ***** ***** ***** ***** ***** */
-          /* We look for the same residue in the same row in
-           * the rest of alignments */
-          utils::initlVect(columnSeqMatrixAux, numSeqs, 0);
-          vectAlignments[k] -> getColumnSeqMatrix(columnSeqMatrix[j], j, columnSeqMatrixAux);
-          /* ***** ***** ***** ***** ***** ***** ***** ***** */
-
-          /* ***** ***** ***** ***** ***** ***** ***** ***** */
-          /* We count when we get the same residue pairs in the
-           * rest of alignments */
-          for(ll = j + 1; ll < numSeqs; ll++)
-            if(columnSeqMatrix[ll] != 0) {
-              if(columnSeqMatrix[ll] == columnSeqMatrixAux[ll])
-                hit++;
-              pairRes++;
-            }
-          /* ***** ***** ***** ***** ***** ***** ***** ***** */
-        }
-      /* ***** ***** ***** ***** ***** ***** ***** ***** */
-      }
-    /* ***** ***** ***** ***** ***** ***** ***** ***** */
-    }
     /* ***** ***** ***** ***** ***** ***** ***** ***** */
     /* Store the hits proportion for each column */
     if(pairRes != 0) columnsValue[i] += ((1.0 * hit)/pairRes);
@@ -357,12 +472,18 @@ bool compareFiles::forceComparison(alignment **vectAlignments, int numAlignments
   }
   /* ***** ***** ***** ***** ***** ***** ***** ***** */
 
+  if(!appearErrors) {
+    for(k = 0; k < numAlignments; k++)
+      delete [] pairs.selectedHits[k];
+    delete [] pairs.selectedHits;
+    delete [] pairs.matrices;
+  }
+
   /* ***** ***** ***** ***** ***** ***** ***** ***** */
   /* Deallocate dinamic memory */
   delete [] names;
   delete [] correspNames;
   delete [] columnSeqMatrix;
-  delete [] columnSeqMatrixAux;
   /* ***** ***** ***** ***** ***** ***** ***** ***** */
 
   /* ***** ***** ***** ***** ***** ***** ***** ***** */
@@ -378,14 +499,12 @@ bool compareFiles::forceComparison(alignment **vectAlignments, int numAlignments
 /* ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** */
 bool compareFiles::applyWindow(int columns, int halfWindow, float *columnsValue) {
 
-  int i, j, window;
   float *vectAux;
 
   /* ***** ***** ***** ***** ***** ***** ***** ***** */
   /* If windows size is greater than 1/4 of alignment
    *length, trimAl rejects this windows size */
   if(halfWindow > columns/4) return false;
-  else window = (2 * halfWindow + 1);
   /* ***** ***** ***** ***** ***** ***** ***** ***** */
 
   /* ***** ***** ***** ***** ***** ***** ***** ***** */
@@ -397,24 +516,10 @@ bool compareFiles::applyWindow(int columns, int halfWindow, float *columnsValue)
 
   /* ***** ***** ***** ***** ***** ***** ***** ***** */
   /* For each column from the selected alignment,
-   * compute the average for its consistency values */
-  for(i = 0; i < columns; i++) {
-	/* ***** ***** ***** ***** ***** ***** ***** ***** */
-    /* This average is computed from halfWindow positions
-	 * before to halfWindow positions after */
-    for(j = i - halfWindow, columnsValue[i] = 0; j <= i + halfWindow; j++) {
-      if(j < 0) columnsValue[i] += vectAux[-j];
-      else if(j >= columns)
-        columnsValue[i] += vectAux[((2 * columns - j) - 2)];
-      else columnsValue[i] += vectAux[j];
-    }
-    /* ***** ***** ***** ***** ***** ***** ***** ***** */
-
-    /* ***** ***** ***** ***** ***** ***** ***** ***** */
-    /* Finally, the column value is divided by the window
-	 * size in order to compute the average score. */
-    columnsValue[i] /= window;
-  }
+   * compute the average for its consistency values
+   * from halfWindow positions before to halfWindow
+   * positions after */
+  utils::windowAverages(vectAux, columns, halfWindow, columnsValue);
   /* ***** ***** ***** ***** ***** ***** ***** ***** */
 
   /* ***** ***** ***** ***** ***** ***** ***** ***** */
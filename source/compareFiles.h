@@ -46,8 +46,8 @@ class compareFiles {
 
     static bool applyWindow(int, int, float *);
 
-    static int algorithm(alignment **, char **, float *, int, bool);
+    static int algorithm(alignment **, char **, float *, int, bool, int);
 
-    static bool forceComparison(alignment **, int, alignment *, float *);
+    static bool forceComparison(alignment **, int, alignment *, float *, int);
 };
 #endif
@@ -0,0 +1,230 @@
+/* ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** *****
+   ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** *****
+
+    trimAl v1.5.0: a tool for automated alignment trimming in large-scale
+                 phylogenetics analyses.
+
+    readAl v1.5.0: a tool for automated alignment conversion among different
+                 formats.
+
+    2009-2020
+        Fernandez-Rodriguez V.  (victor.fernandez@bsc.es)
+        Capella-Gutierrez S.    (salvador.capella@bsc.es)
+        Gabaldon, T.            (tgabaldon@bsc.es)
+
+    This file is part of trimAl/readAl.
+
+    trimAl/readAl are free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, the last available version.
+
+    trimAl/readAl are distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with trimAl/readAl. If not, see <http://www.gnu.org/licenses/>.
+
+***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** *****
+***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** */
+
+#include "compressedBuffer.h"
+
+#ifdef HAVE_ZLIB
+#include <zlib.h>
+#endif
+
+#ifdef HAVE_ZSTD
+#include <zstd.h>
+#endif
+
+compressedBuffer::compressedBuffer(void) {
+
+  compression = NOCOMPRESSION;
+
+  file = NULL;
+  compressedFile = NULL;
+  compressor = NULL;
+
+  buffer = NULL;
+  packed = NULL;
+  packedSize = 0;
+}
+
+compressedBuffer::~compressedBuffer(void) {
+
+  close();
+
+  if(buffer != NULL)
+    delete [] buffer;
+
+  if(packed != NULL)
+    delete [] packed;
+}
+
+int compressedBuffer::compressionByName(char *fileName) {
+  /* Guess compression method from the output file extension */
+  int length;
+
+  length = strlen(fileName);
+
+  if((length > 3) && (!strcmp(fileName + length - 3, ".gz")))
+    return GZIPFILE;
+
+  if((length > 4) && (!strcmp(fileName + length - 4, ".zst")))
+    return ZSTDFILE;
+
+  return NOCOMPRESSION;
+}
+
+bool compressedBuffer::isSupported(int method) {
+
+  switch(method) {
+    case NOCOMPRESSION:
+      return true;
+#ifdef HAVE_ZLIB
+    case GZIPFILE:
+      return true;
+#endif
+#ifdef HAVE_ZSTD
+    case ZSTDFILE:
+      return true;
+#endif
+    default:
+      return false;
+  }
+}
+
+bool compressedBuffer::open(char *fileName, int method) {
+
+  close();
+
+  if((method == NOCOMPRESSION) || (!isSupported(method)))
+    return false;
+
+  compression = method;
+
+#ifdef HAVE_ZLIB
+  if(compression == GZIPFILE) {
+    compressedFile = (void *) gzopen(fileName, "wb");
+    if(compressedFile == NULL)
+      return false;
+  }
+#endif
+
+#ifdef HAVE_ZSTD
+  if(compression == ZSTDFILE) {
+    file = fopen(fileName, "wb");
+    if(file == NULL)
+      return false;
+
+    compressor = (void *) ZSTD_createCStream();
+    ZSTD_initCStream((ZSTD_CStream *) compressor, ZSTDLEVEL);
+
+    packedSize = (long) ZSTD_CStreamOutSize();
+    if(packed == NULL)
+      packed = new char[packedSize];
+  }
+#endif
+
+  /* Pending data is stored until the buffer is full. Last position is kept
+   * free for the character that triggers the overflow */
+  if(buffer == NULL)
+    buffer = new char[READBUFFERSIZE];
+  setp(buffer, buffer + READBUFFERSIZE - 1);
+
+  return true;
+}
+
+bool compressedBuffer::flushBuffer(void) {
+  /* Compress and write all pending data */
+  long pending;
+  bool done = true;
+
+  pending = pptr() - pbase();
+  if(pending == 0)
+    return true;
+
+#ifdef HAVE_ZLIB
+  if(compression == GZIPFILE)
+    done = gzwrite((gzFile) compressedFile, pbase(), pending) == pending;
+#endif
+
+#ifdef HAVE_ZSTD
+  if(compression == ZSTDFILE) {
+    ZSTD_inBuffer input = {pbase(), (size_t) pending, 0};
+
+    while((done) && (input.pos < input.size)) {
+      ZSTD_outBuffer output = {packed, (size_t) packedSize, 0};
+      done = !ZSTD_isError(ZSTD_compressStream((ZSTD_CStream *) compressor,
+        &output, &input));
+      if(fwrite(packed, 1, output.pos, file) != output.pos)
+        done = false;
+    }
+  }
+#endif
+
+  setp(buffer, buffer + READBUFFERSIZE - 1);
+  return done;
+}
+
+int compressedBuffer::overflow(int c) {
+
+  if(c != EOF) {
+    *pptr() = c;
+    pbump(1);
+  }
+
+  if(!flushBuffer())
+    return EOF;
+
+  return (c == EOF) ? 0 : c;
+}
+
+int compressedBuffer::sync(void) {
+  /* Pending data is only compressed when the buffer is full or the file is
+   * closed, since flushing a compressed stream degrades the compression */
+  return 0;
+}
+
+bool compressedBuffer::close(void) {
+  /* Compress pending data, finish the compressed stream and close it */
+  bool done = true;
+
+  if(buffer != NULL)
+    done = flushBuffer();
+
+#ifdef HAVE_ZLIB
+  if(compressedFile != NULL)
+    if(gzclose((gzFile) compressedFile) != Z_OK)
+      done = false;
+#endif
+  compressedFile = NULL;
+
+#ifdef HAVE_ZSTD
+  if(compressor != NULL) {
+    size_t remaining;
+
+    do {
+      ZSTD_outBuffer output = {packed, (size_t) packedSize, 0};
+      remaining = ZSTD_endStream((ZSTD_CStream *) compressor, &output);
+      if(ZSTD_isError(remaining))
+        done = false;
+      else if(fwrite(packed, 1, output.pos, file) != output.pos)
+        done = false;
+    } while((done) && (remaining != 0));
+
+    ZSTD_freeCStream((ZSTD_CStream *) compressor);
+  }
+#endif
+  compressor = NULL;
+
+  if(file != NULL)
+    if(fclose(file))
+      done = false;
+  file = NULL;
+
+  compression = NOCOMPRESSION;
+  return done;
+}
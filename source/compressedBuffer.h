@@ -0,0 +1,117 @@
+/* ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** *****
+   ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** *****
+
+    trimAl v1.5.0: a tool for automated alignment trimming in large-scale
+                 phylogenetics analyses.
+
+    readAl v1.5.0: a tool for automated alignment conversion among different
+                 formats.
+
+    2009-2020
+        Fernandez-Rodriguez V.  (victor.fernandez@bsc.es)
+        Capella-Gutierrez S.    (salvador.capella@bsc.es)
+        Gabaldon, T.            (tgabaldon@bsc.es)
+
+    This file is part of trimAl/readAl.
+
+    trimAl/readAl are free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, the last available version.
+
+    trimAl/readAl are distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with trimAl/readAl. If not, see <http://www.gnu.org/licenses/>.
+
+***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** *****
+***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** */
+
+#ifndef COMPRESSEDBUFFER_H
+#define COMPRESSEDBUFFER_H
+
+#include <stdio.h>
+#include <string.h>
+
+#include <iostream>
+
+#include "defines.h"
+
+using namespace std;
+
+/** \brief Class implementing a compressed output stream buffer.
+ *
+ * This class can be attached to any output stream to write its content
+ * compressed with gzip or zstd, depending on the build options. In this way,
+ * alignment writers do not need to know whether their output is compressed.
+ */
+
+class compressedBuffer : public streambuf {
+
+  /* Compression method: GZIPFILE or ZSTDFILE */
+  int compression;
+
+  /* Output file and compression stream. They are kept as generic pointers
+   * to make this class independent of the available libraries */
+  FILE *file;
+  void *compressedFile;
+  void *compressor;
+
+  /* Uncompressed data pending to be written and compressed data buffer */
+  char *buffer;
+  char *packed;
+  long packedSize;
+
+  bool flushBuffer(void);
+
+  protected:
+
+  int overflow(int c);
+
+  int sync(void);
+
+  public:
+
+  /** \brief Null constructor.
+   *
+   * This construction method initializates all attributes
+   * of the new object with 0 or NULL value.
+   */
+  compressedBuffer(void);
+
+  /** \brief Destructor.
+   *
+   * Destruction method that closes the output file, if any,
+   * and frees previously allocated memory.
+   */
+  ~compressedBuffer(void);
+
+  /** \brief Output file opening method.
+   * \param fileName Path to the output file.
+   * \param method Compression method, GZIPFILE or ZSTDFILE.
+   * \return \b true if the file could be opened, \b false otherwise.
+   */
+  bool open(char *fileName, int method);
+
+  /** \brief Output file closing method.
+   * \return \b true if all pending data could be compressed and written.
+   */
+  bool close(void);
+
+  /** \brief Compression method guessing.
+   * \param fileName Path to the output file.
+   * \return GZIPFILE for ".gz" files, ZSTDFILE for ".zst" files and
+   * NOCOMPRESSION otherwise.
+   */
+  static int compressionByName(char *fileName);
+
+  /** \brief Compression support method.
+   * \param method Compression method, GZIPFILE or ZSTDFILE.
+   * \return \b true if this build supports the given compression method.
+   */
+  static bool isSupported(int method);
+};
+
+#endif
@@ -48,9 +48,41 @@
 #define GAPPYOUT 1
 #define STRICT   2
 
+#define COLUMNSSTAGE    1
+#define COMPARESTAGE    2
+#define OVERLAPSTAGE    3
+#define THRESHOLDSSTAGE 4
+#define SELECTCOLSSTAGE 5
+#define SELECTSEQSSTAGE 6
+#define CLUSTERSSTAGE   7
+#define COLUMNSERROR    8
+#define SEQUENCESERROR  9
+#define CLUSTERSERROR   10
+#define STAGESNUMBER    10
+
 #define DELIMITERS     "   \t\n"
 #define OTHDELIMITERS  "   \t\n,:"
 #define OTH2DELIMITERS "   \n,:;"
 
 #define HTMLBLOCKS 120
 #define PHYLIPDISTANCE 10
+
+#define READBUFFERSIZE 1048576
+#define LINEBUFFERSIZE 4096
+#define SEQUENCESBLOCK 64
+#define TRANSPOSEBLOCK 64
+#define MAPPEDFILESIZE 67108864
+
+#define NOCOMPRESSION 0
+#define GZIPFILE      1
+#define ZSTDFILE      2
+#define ZSTDLEVEL     3
+
+#define PAIRSTILE 32
+#define SIMILARITYBLOCK 16
+#define DISTANCECODES 32
+#define COMPAREBLOCK 256
+
+#define CHANNELTIMEOUT 30
+#define CHANNELOPTIONSIZE 65536
+#define CHANNELFIELDSIZE 1073741824
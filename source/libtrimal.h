@@ -0,0 +1,62 @@
+/* ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** *****
+   ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** *****
+
+    trimAl v1.5.0: a tool for automated alignment trimming in large-scale
+                 phylogenetics analyses.
+
+    2009-2020
+        Fernandez-Rodriguez V.  (victor.fernandez@bsc.es)
+        Capella-Gutierrez S.    (salvador.capella@bsc.es)
+        Gabaldon, T.            (tgabaldon@bsc.es)
+
+    This file is part of trimAl.
+
+    trimAl is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, the last available version.
+
+    trimAl is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with trimAl. If not, see <http://www.gnu.org/licenses/>.
+
+***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** *****
+***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** */
+
+
+#ifndef LIBTRIMAL_H
+#define LIBTRIMAL_H
+
+/* C interface to trim alignments in memory through the trimAl library. The
+ * options are the trimAl command line ones, the first being the program
+ * name. The alignment may be in any input format and it is given back in the
+ * output format set by the options or, otherwise, in the input one */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct trimal_library trimal_library;
+
+/* Create a library handle, which may be shared by several threads */
+trimal_library *trimal_create(void);
+
+/* Free a library handle */
+void trimal_destroy(trimal_library *library);
+
+/* Trim an alignment. Returns 0 if it has been trimmed, with the trimmed
+ * alignment in output, to be freed with trimal_free, or -1 otherwise */
+int trimal_trim(trimal_library *library, const char *name, const char *input, long inputSize,
+                int argc, char *argv[], char **output, long *outputSize);
+
+/* Free an alignment given back by trimal_trim */
+void trimal_free(char *output);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,625 @@
+/* ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** *****
+   ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** *****
+
+    trimAl v1.5.0: a tool for automated alignment trimming in large-scale
+                 phylogenetics analyses.
+
+    readAl v1.5.0: a tool for automated alignment conversion among different
+                 formats.
+
+    2009-2020
+        Fernandez-Rodriguez V.  (victor.fernandez@bsc.es)
+        Capella-Gutierrez S.    (salvador.capella@bsc.es)
+        Gabaldon, T.            (tgabaldon@bsc.es)
+
+    This file is part of trimAl/readAl.
+
+    trimAl/readAl are free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, the last available version.
+
+    trimAl/readAl are distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with trimAl/readAl. If not, see <http://www.gnu.org/licenses/>.
+
+***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** *****
+***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** */
+
+#include "lineReader.h"
+#include "compressedBuffer.h"
+
+#include <iostream>
+
+#ifndef _WIN32
+#include <sys/mman.h>
+#endif
+
+#ifdef HAVE_ZLIB
+#include <zlib.h>
+#endif
+
+#ifdef HAVE_ZSTD
+#include <zstd.h>
+#endif
+
+lineReader::lineReader(void) {
+
+  file = NULL;
+
+  block = NULL;
+  buffer = NULL;
+  bufferStart = 0;
+  bufferEnd = 0;
+  mappedSize = 0;
+
+  compression = NOCOMPRESSION;
+  decompressor = NULL;
+
+  packed = NULL;
+  packedStart = 0;
+  packedEnd = 0;
+  frameEnd = false;
+
+  streamed = false;
+  recording = false;
+  history = NULL;
+  historyStart = 0;
+  historyLength = 0;
+  historySize = 0;
+
+  line = NULL;
+  lineSize = 0;
+  lineLength = 0;
+
+  endOfFile = false;
+}
+
+lineReader::~lineReader(void) {
+
+  close();
+
+  if(block != NULL)
+    delete [] block;
+
+  if(packed != NULL)
+    delete [] packed;
+
+  if(line != NULL)
+    delete [] line;
+}
+
+bool lineReader::open(char *fileName) {
+  /* Open the input file and check whether it exists and its size is greater
+   * than 0. A single dash stands for the standard input */
+  long size = 0;
+
+  close();
+
+  streamed = !strcmp(fileName, "-");
+  if(streamed)
+    file = stdin;
+
+  else {
+    file = fopen(fileName, "rb");
+    if(file == NULL)
+      return false;
+
+    fseek(file, 0, SEEK_END);
+    size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+
+    if(size <= 0) {
+      close();
+      return false;
+    }
+  }
+
+  return start(size);
+}
+
+bool lineReader::openMemory(const char *data, long size) {
+  /* The content is wrapped into a read-only stream, so it is read block by
+   * block as any other file. It is never memory-mapped */
+  close();
+
+#ifndef _WIN32
+  if(size <= 0)
+    return false;
+
+  file = fmemopen((void *) data, size, "rb");
+  if(file == NULL)
+    return false;
+
+  return start(0);
+#else
+  return false;
+#endif
+}
+
+bool lineReader::start(long size) {
+  /* Prepare the reader for the file just opened. Its size is only used to
+   * decide whether it should be memory-mapped */
+
+  /* Allocate line storage and read buffer only once */
+  if(line == NULL) {
+    lineSize = LINEBUFFERSIZE;
+    line = new char[lineSize];
+  }
+
+  if(block == NULL)
+    block = new char[READBUFFERSIZE];
+  buffer = block;
+
+  bufferStart = 0;
+  bufferEnd = 0;
+  endOfFile = false;
+
+  /* Compressed files are decompressed block by block */
+  if(!openCompressed()) {
+    close();
+    return false;
+  }
+
+  /* Streamed input is kept in memory while it may be read again. Bytes
+   * already peeked are the first ones to keep */
+  if(streamed) {
+    recording = true;
+    keepHistory(buffer, bufferEnd);
+    return true;
+  }
+
+#ifndef _WIN32
+  /* Map large files into memory. If it is not possible, fall back to the
+   * block-buffered reading */
+  if((compression == NOCOMPRESSION) && (size >= MAPPEDFILESIZE)) {
+    buffer = (char *) mmap(NULL, size, PROT_READ, MAP_PRIVATE, fileno(file), 0);
+    if(buffer != MAP_FAILED) {
+      madvise(buffer, size, MADV_SEQUENTIAL);
+      mappedSize = size;
+      bufferEnd = size;
+      return true;
+    }
+    buffer = block;
+  }
+#endif
+
+  return true;
+}
+
+bool lineReader::openCompressed(void) {
+  /* Peek at the first bytes of the file looking for gzip or zstd magic
+   * numbers and prepare the decompression stream, if any. Peeked bytes are
+   * left in the read buffer, or with the compressed data, to be read again */
+  unsigned char *magic = (unsigned char *) buffer;
+
+  bufferEnd = (long) fread(buffer, 1, 4, file);
+
+  if((bufferEnd >= 2) && (magic[0] == 0x1F) && (magic[1] == 0x8B))
+    compression = GZIPFILE;
+  else if((bufferEnd == 4) && (magic[0] == 0x28) && (magic[1] == 0xB5) &&
+          (magic[2] == 0x2F) && (magic[3] == 0xFD))
+    compression = ZSTDFILE;
+  else
+    return true;
+
+  if(!compressedBuffer::isSupported(compression)) {
+    cerr << endl << "ERROR: This build does not support "
+         << (compression == GZIPFILE ? "gzip" : "zstd")
+         << " compressed input files." << endl << endl;
+    return false;
+  }
+
+#ifdef HAVE_ZLIB
+  /* Automatic header detection is requested to inflate gzip files */
+  if(compression == GZIPFILE) {
+    decompressor = (void *) new z_stream;
+    memset(decompressor, 0, sizeof(z_stream));
+    if(inflateInit2((z_stream *) decompressor, 15 + 32) != Z_OK)
+      return false;
+  }
+#endif
+
+#ifdef HAVE_ZSTD
+  if(compression == ZSTDFILE) {
+    decompressor = (void *) ZSTD_createDStream();
+    ZSTD_initDStream((ZSTD_DStream *) decompressor);
+  }
+#endif
+
+  /* Compressed data is read in blocks as large as the uncompressed ones */
+  if(packed == NULL)
+    packed = new char[READBUFFERSIZE];
+  memcpy(packed, buffer, bufferEnd);
+  packedStart = 0;
+  packedEnd = bufferEnd;
+  frameEnd = false;
+
+  bufferEnd = 0;
+  return true;
+}
+
+void lineReader::close(void) {
+
+#ifndef _WIN32
+  if(mappedSize != 0)
+    munmap(buffer, mappedSize);
+#endif
+  mappedSize = 0;
+  buffer = block;
+
+#ifdef HAVE_ZLIB
+  if((compression == GZIPFILE) && (decompressor != NULL)) {
+    inflateEnd((z_stream *) decompressor);
+    delete (z_stream *) decompressor;
+  }
+#endif
+
+#ifdef HAVE_ZSTD
+  if((compression == ZSTDFILE) && (decompressor != NULL))
+    ZSTD_freeDStream((ZSTD_DStream *) decompressor);
+#endif
+  decompressor = NULL;
+  compression = NOCOMPRESSION;
+
+  /* Standard input is never closed */
+  if((file != NULL) && (!streamed))
+    fclose(file);
+  file = NULL;
+  streamed = false;
+
+  if(history != NULL)
+    delete [] history;
+  history = NULL;
+  historyStart = 0;
+  historyLength = 0;
+  historySize = 0;
+  recording = false;
+
+  bufferStart = 0;
+  bufferEnd = 0;
+}
+
+void lineReader::forgetHistory(void) {
+  recording = false;
+}
+
+bool lineReader::isMapped(void) {
+  return mappedSize != 0;
+}
+
+bool lineReader::eof(void) {
+  return endOfFile;
+}
+
+bool lineReader::fillBuffer(void) {
+  /* Read a new block from the input file. Return false if nothing else can
+   * be read from it. A memory-mapped file is already available as a whole */
+
+  if((file == NULL) || (mappedSize != 0))
+    return false;
+
+  bufferStart = 0;
+
+  /* Streamed input already read is given back before reading anything new
+   * from the stream. Once it is not needed anymore, it is released */
+  if(historyStart < historyLength) {
+    buffer = history + historyStart;
+    bufferEnd = historyLength - historyStart;
+    historyStart = historyLength;
+    return true;
+  }
+
+  if((!recording) && (history != NULL)) {
+    delete [] history;
+    history = NULL;
+    historyStart = 0;
+    historyLength = 0;
+    historySize = 0;
+  }
+
+  buffer = block;
+  bufferEnd = readBlock(buffer, READBUFFERSIZE);
+
+  if(recording)
+    keepHistory(buffer, bufferEnd);
+
+  return bufferEnd > 0;
+}
+
+void lineReader::keepHistory(char *data, long length) {
+  /* Add data read from the stream to the history. Grow it if it is needed.
+   * Nothing is added when nothing has been read, e.g. when the compressed
+   * stream peek bytes have been already consumed */
+  char *newHistory;
+
+  if(length <= 0)
+    return;
+
+  if(historyLength + length > historySize) {
+    if(historySize == 0)
+      historySize = READBUFFERSIZE;
+    while(historyLength + length > historySize)
+      historySize *= 2;
+    newHistory = new char[historySize];
+    if(history != NULL) {
+      memcpy(newHistory, history, historyLength);
+      delete [] history;
+    }
+    history = newHistory;
+  }
+
+  memcpy(history + historyLength, data, length);
+  historyLength += length;
+  historyStart = historyLength;
+}
+
+bool lineReader::fillPacked(void) {
+  /* Read more compressed data if all the previous one has been already
+   * decompressed */
+
+  if(packedStart == packedEnd) {
+    packedStart = 0;
+    packedEnd = (long) fread(packed, 1, READBUFFERSIZE, file);
+  }
+
+  return packedEnd > 0;
+}
+
+long lineReader::readBlock(char *destination, long size) {
+  /* Read up to size bytes from the input file, decompressing them when it is
+   * needed. Return the number of bytes actually stored at destination */
+
+#ifdef HAVE_ZLIB
+  if(compression == GZIPFILE) {
+    z_stream *stream = (z_stream *) decompressor;
+    int result;
+
+    /* Feed the decompressor until it produces something or the compressed
+     * file is exhausted. Concatenated gzip members are decompressed too */
+    stream -> next_out = (Bytef *) destination;
+    stream -> avail_out = (uInt) size;
+    while((stream -> avail_out == (uInt) size) && (fillPacked())) {
+      stream -> next_in = (Bytef *) packed + packedStart;
+      stream -> avail_in = (uInt) (packedEnd - packedStart);
+
+      result = inflate(stream, Z_NO_FLUSH);
+      packedStart = packedEnd - (long) stream -> avail_in;
+
+      if((result != Z_OK) && (result != Z_STREAM_END) && (result != Z_BUF_ERROR)) {
+        frameEnd = true;
+        cerr << endl << "ERROR: Compressed input file is corrupted."
+             << endl << endl;
+        return 0;
+      }
+
+      frameEnd = (result == Z_STREAM_END);
+      if(frameEnd)
+        inflateReset(stream);
+    }
+    if(!frameEnd && (stream -> avail_out == (uInt) size)) {
+      frameEnd = true;
+      cerr << endl << "ERROR: Compressed input file is truncated."
+           << endl << endl;
+    }
+    return size - (long) stream -> avail_out;
+  }
+#endif
+
+#ifdef HAVE_ZSTD
+  if(compression == ZSTDFILE) {
+    ZSTD_outBuffer output = {destination, (size_t) size, 0};
+    size_t result;
+
+    /* Feed the decompressor until it produces something or the compressed
+     * file is exhausted */
+    while((output.pos == 0) && (fillPacked())) {
+      ZSTD_inBuffer input = {packed, (size_t) packedEnd, (size_t) packedStart};
+
+      result = ZSTD_decompressStream((ZSTD_DStream *) decompressor,
+        &output, &input);
+      packedStart = (long) input.pos;
+
+      if(ZSTD_isError(result)) {
+        frameEnd = true;
+        cerr << endl << "ERROR: Compressed input file is corrupted."
+             << endl << endl;
+        return 0;
+      }
+      frameEnd = (result == 0);
+    }
+    if(!frameEnd && (output.pos == 0)) {
+      frameEnd = true;
+      cerr << endl << "ERROR: Compressed input file is truncated."
+           << endl << endl;
+    }
+    return (long) output.pos;
+  }
+#endif
+
+  return (long) fread(destination, 1, size, file);
+}
+
+void lineReader::appendLine(char *fragment, long length) {
+  /* Add a fragment to the current line removing any carriage return. Grow the
+   * line storage if it is needed */
+  char *carriage, *newLine;
+  long i;
+
+  if(lineLength + length + 1 > lineSize) {
+    while(lineLength + length + 1 > lineSize)
+      lineSize *= 2;
+    newLine = new char[lineSize];
+    memcpy(newLine, line, lineLength);
+    delete [] line;
+    line = newLine;
+  }
+
+  /* For -Windows & MacOS compatibility- carriage returns are removed */
+  carriage = (char *) memchr(fragment, '\r', length);
+  if(carriage == NULL) {
+    memcpy(line + lineLength, fragment, length);
+    lineLength += length;
+    return;
+  }
+
+  for(i = 0; i < length; i++)
+    if(fragment[i] != '\r')
+      line[lineLength++] = fragment[i];
+}
+
+char *lineReader::trimLine(void) {
+  /* Finish the current line and remove blank spaces & tabs from its
+   * beginning */
+  long start;
+
+  line[lineLength] = '\0';
+
+  for(start = 0; line[start] == ' '; start++) ;
+  for( ; line[start] == '\t'; start++) ;
+
+  /* If there is nothing to return, give back a NULL pointer ... */
+  if(start == lineLength)
+    return NULL;
+
+  return line + start;
+}
+
+char *lineReader::readLine(void) {
+  /* Read a new line from the buffer looking for the new line character with
+   * memchr. Buffer is refilled as many times as it is needed */
+  char *newLine;
+  long length;
+
+  /* Check it the end of the file has been reached or not */
+  if(endOfFile)
+    return NULL;
+
+  lineLength = 0;
+  while(true) {
+    if((bufferStart == bufferEnd) && (!fillBuffer())) {
+      endOfFile = true;
+      break;
+    }
+
+    newLine = (char *) memchr(buffer + bufferStart, '\n',
+      bufferEnd - bufferStart);
+    length = (newLine == NULL ? bufferEnd : (newLine - buffer)) - bufferStart;
+
+    appendLine(buffer + bufferStart, length);
+    bufferStart += length;
+
+    /* Skip the new line character itself */
+    if(newLine != NULL) {
+      bufferStart++;
+      break;
+    }
+  }
+
+  return trimLine();
+}
+
+char *lineReader::readView(long *length) {
+  /* Get next line as a pointer to the memory-mapped file. End of file flag
+   * follows the same rules than for the readLine method */
+  char *view, *newLine;
+
+  *length = 0;
+  if((endOfFile) || (mappedSize == 0))
+    return NULL;
+
+  view = buffer + bufferStart;
+  newLine = (char *) memchr(view, '\n', bufferEnd - bufferStart);
+
+  if(newLine == NULL) {
+    *length = bufferEnd - bufferStart;
+    bufferStart = bufferEnd;
+    endOfFile = true;
+  } else {
+    *length = newLine - view;
+    bufferStart += *length + 1;
+  }
+
+  return view;
+}
+
+char *lineReader::viewToLine(char *view, long length) {
+  /* Copy a raw line into the line storage and process it as it would have
+   * been processed by the readLine method */
+
+  lineLength = 0;
+  appendLine(view, length);
+
+  return trimLine();
+}
+
+long lineReader::tokenLength(char *view, long length, const char *delimiters) {
+  /* Look for the first character which would have been processed by the
+   * readLine method or by strtok */
+  const char *d;
+  long i;
+
+  for(i = 0; i < length; i++) {
+    if((view[i] == '\r') || (view[i] == '\0'))
+      break;
+    for(d = delimiters; (*d != '\0') && (*d != view[i]); d++) ;
+    if(*d != '\0')
+      break;
+  }
+  return i;
+}
+
+void lineReader::readChar(char *c) {
+
+  if((bufferStart == bufferEnd) && (!fillBuffer())) {
+    endOfFile = true;
+    return;
+  }
+  *c = buffer[bufferStart++];
+}
+
+bool lineReader::rewind(void) {
+
+  if(file == NULL)
+    return false;
+
+  bufferStart = 0;
+  endOfFile = false;
+
+  /* Memory-mapped files are not read again */
+  if(mappedSize != 0)
+    return true;
+
+  /* Streamed input can only be replayed from its history */
+  if(streamed) {
+    if(!recording)
+      return false;
+    buffer = block;
+    bufferEnd = 0;
+    historyStart = 0;
+    return true;
+  }
+
+  if(fseek(file, 0, SEEK_SET))
+    return false;
+
+  bufferEnd = 0;
+
+  /* Decompression starts again from the file beginning */
+#ifdef HAVE_ZLIB
+  if(compression == GZIPFILE)
+    inflateReset((z_stream *) decompressor);
+#endif
+#ifdef HAVE_ZSTD
+  if(compression == ZSTDFILE)
+    ZSTD_initDStream((ZSTD_DStream *) decompressor);
+#endif
+  packedStart = 0;
+  packedEnd = 0;
+  frameEnd = false;
+
+  return true;
+}
@@ -0,0 +1,215 @@
+/* ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** *****
+   ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** *****
+
+    trimAl v1.5.0: a tool for automated alignment trimming in large-scale
+                 phylogenetics analyses.
+
+    readAl v1.5.0: a tool for automated alignment conversion among different
+                 formats.
+
+    2009-2020
+        Fernandez-Rodriguez V.  (victor.fernandez@bsc.es)
+        Capella-Gutierrez S.    (salvador.capella@bsc.es)
+        Gabaldon, T.            (tgabaldon@bsc.es)
+
+    This file is part of trimAl/readAl.
+
+    trimAl/readAl are free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, the last available version.
+
+    trimAl/readAl are distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with trimAl/readAl. If not, see <http://www.gnu.org/licenses/>.
+
+***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** *****
+***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** */
+
+#ifndef LINEREADER_H
+#define LINEREADER_H
+
+#include <stdio.h>
+#include <string.h>
+
+#include "defines.h"
+
+using namespace std;
+
+/** \brief Class implementing a block-buffered line reader.
+ *
+ * This class reads input files in large blocks and splits them into lines
+ * looking for new line characters directly on the read buffer. Lines are
+ * returned using a reusable internal storage, so the returned pointer is
+ * only valid until the next call to any reading method. It behaves as the
+ * former utils::readLine method: carriage returns are removed, leading
+ * blank spaces and tabs are trimmed and empty lines are returned as NULL.
+ *
+ * Large files are memory-mapped instead. In that case, raw lines can be
+ * obtained as views into the mapped file without copying them.
+ *
+ * Files compressed with gzip or zstd are detected by their magic numbers
+ * and decompressed on the fly, block by block, when the build supports it.
+ *
+ * The standard input, named as "-", is read only once: everything read from
+ * it is kept in memory until it is known that it will not be rewound again.
+ */
+
+class lineReader {
+
+  /* Input file descriptor */
+  FILE *file;
+
+  /* Read buffer and its current boundaries. Buffer points either to the
+   * allocated block or to the memory-mapped file */
+  char *block, *buffer;
+  long bufferStart, bufferEnd;
+
+  /* Memory-mapped file size, 0 if the file is not mapped */
+  long mappedSize;
+
+  /* Compression method of the input file and its decompression stream. The
+   * stream is kept as a generic pointer to make this class independent of
+   * the available libraries */
+  int compression;
+  void *decompressor;
+
+  /* Compressed data read from the input file and not decompressed yet, and
+   * whether the last compressed frame has been completely decompressed */
+  char *packed;
+  long packedStart, packedEnd;
+  bool frameEnd;
+
+  /* The standard input can not be read twice, so everything read from it is
+   * kept in memory while the input may be rewound */
+  bool streamed, recording;
+  char *history;
+  long historyStart, historyLength, historySize;
+
+  /* Reusable storage for the current line */
+  char *line;
+  long lineSize, lineLength;
+
+  /* Flag set once a read has tried to go beyond the end of file */
+  bool endOfFile;
+
+  bool start(long);
+
+  bool fillBuffer(void);
+
+  void keepHistory(char *, long);
+
+  bool fillPacked(void);
+
+  long readBlock(char *, long);
+
+  bool openCompressed(void);
+
+  void appendLine(char *, long);
+
+  char *trimLine(void);
+
+  public:
+
+  /** \brief Null constructor.
+   *
+   * This construction method initializates all attributes
+   * of the new object with 0 or NULL value.
+   */
+  lineReader(void);
+
+  /** \brief Destructor.
+   *
+   * Destruction method that closes the input file, if any,
+   * and frees previously allocated memory.
+   */
+  ~lineReader(void);
+
+  /** \brief Input file opening method.
+   * \param fileName Path to the input file, or "-" for the standard input.
+   * \return \b true if the file exists and it is not empty, \b false otherwise.
+   *
+   * Compressed files are never memory-mapped.
+   */
+  bool open(char *fileName);
+
+  /** \brief In-memory input opening method.
+   * \param data Input content. It has to be kept until the reader is closed.
+   * \param size Input content size.
+   * \return \b true if the content is not empty and it could be opened.
+   *
+   * The content is read as a file would be, compressed or not. It is not
+   * available on Windows.
+   */
+  bool openMemory(const char *data, long size);
+
+  /** \brief Memory-mapped file method.
+   * \return \b true if the input file has been memory-mapped.
+   */
+  bool isMapped(void);
+
+  /** \brief Input file closing method. */
+  void close(void);
+
+  /** \brief End of file method.
+   * \return \b true if any read has reached the end of the input file.
+   */
+  bool eof(void);
+
+  /** \brief Line reading method.
+   * \return Next line without carriage returns and leading blank spaces or
+   * tabs, or NULL when the line is empty. The returned storage belongs to
+   * the reader and it will be overwritten by the next read.
+   */
+  char *readLine(void);
+
+  /** \brief Raw line reading method.
+   * \param length Pointer where the line length will be stored.
+   * \return Pointer to the next line inside the memory-mapped file, without
+   * the new line character and any other processing. The line is not NULL
+   * terminated. Only available for memory-mapped files.
+   */
+  char *readView(long *length);
+
+  /** \brief View to line method.
+   * \param view Raw line previously obtained using readView.
+   * \param length View length.
+   * \return The same line that readLine would have returned for that view.
+   */
+  char *viewToLine(char *view, long length);
+
+  /** \brief Token length method.
+   * \param view Raw line previously obtained using readView.
+   * \param length View length.
+   * \param delimiters Characters which end the token.
+   * \return Position of the first delimiter, carriage return or NULL
+   * character in the view, or its length if there is none of them.
+   */
+  static long tokenLength(char *view, long length, const char *delimiters);
+
+  /** \brief Character reading method.
+   * \param c Pointer where the read character will be stored.
+   *
+   * Method that reads next character from the input file. If the end of file
+   * is reached, \e c is not modified and the end of file flag is set.
+   */
+  void readChar(char *c);
+
+  /** \brief Rewind method.
+   * \return \b true if the reader could be moved back to the file beginning.
+   */
+  bool rewind(void);
+
+  /** \brief History releasing method.
+   *
+   * Method that tells the reader that the input will not be rewound again,
+   * so the standard input kept in memory can be released as soon as it has
+   * been read again.
+   */
+  void forgetHistory(void);
+};
+
+#endif
@@ -0,0 +1,252 @@
+/* ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** *****
+   ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** *****
+
+    trimAl v1.5.0: a tool for automated alignment trimming in large-scale
+                 phylogenetics analyses.
+
+    readAl v1.5.0: a tool for automated alignment conversion among different
+                 formats.
+
+    2009-2020
+        Fernandez-Rodriguez V.  (victor.fernandez@bsc.es)
+        Capella-Gutierrez S.    (salvador.capella@bsc.es)
+        Gabaldon, T.            (tgabaldon@bsc.es)
+
+    This file is part of trimAl/readAl.
+
+    trimAl/readAl are free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, the last available version.
+
+    trimAl/readAl are distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with trimAl/readAl. If not, see <http://www.gnu.org/licenses/>.
+
+***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** *****
+***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** */
+
+#include "localChannel.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+
+#ifndef _WIN32
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/time.h>
+
+/* Fill the address of a socket. Paths longer than the address allows are
+ * not truncated but rejected */
+static bool socketAddress(const char *path, struct sockaddr_un *address) {
+
+  if(strlen(path) >= sizeof(address -> sun_path))
+    return false;
+
+  memset(address, 0, sizeof(struct sockaddr_un));
+  address -> sun_family = AF_UNIX;
+  strcpy(address -> sun_path, path);
+  return true;
+}
+
+/* Write or read exactly the given number of bytes, going on when a signal
+ * interrupts the call */
+static bool writeBytes(int channel, const char *data, long size) {
+
+  long done;
+
+  while(size > 0) {
+    done = (long) write(channel, data, size);
+    if((done < 0) && (errno == EINTR))
+      continue;
+    if(done <= 0)
+      return false;
+    data += done;
+    size -= done;
+  }
+  return true;
+}
+
+static bool readBytes(int channel, char *data, long size) {
+
+  long done;
+
+  while(size > 0) {
+    done = (long) read(channel, data, size);
+    if((done < 0) && (errno == EINTR))
+      continue;
+    if(done <= 0)
+      return false;
+    data += done;
+    size -= done;
+  }
+  return true;
+}
+#endif
+
+int localChannel::listenAt(const char *path) {
+
+#ifndef _WIN32
+  struct sockaddr_un address;
+  struct stat info;
+  int listener, server;
+
+  if(!socketAddress(path, &address))
+    return -1;
+
+  /* A socket nobody listens to is left by a server which did not finish
+   * cleanly. Anything else at that path is kept */
+  if(stat(path, &info) == 0) {
+    if(!S_ISSOCK(info.st_mode))
+      return -1;
+    server = connectTo(path);
+    if(server != -1) {
+      close(server);
+      return -1;
+    }
+    unlink(path);
+  }
+
+  listener = socket(AF_UNIX, SOCK_STREAM, 0);
+  if(listener < 0)
+    return -1;
+
+  if((bind(listener, (struct sockaddr *) &address, sizeof(address)) != 0) ||
+     (listen(listener, SOMAXCONN) != 0)) {
+    close(listener);
+    return -1;
+  }
+  return listener;
+#else
+  return -1;
+#endif
+}
+
+int localChannel::connectTo(const char *path) {
+
+#ifndef _WIN32
+  struct sockaddr_un address;
+  int channel;
+
+  if(!socketAddress(path, &address))
+    return -1;
+
+  channel = socket(AF_UNIX, SOCK_STREAM, 0);
+  if(channel < 0)
+    return -1;
+
+  if(connect(channel, (struct sockaddr *) &address, sizeof(address)) != 0) {
+    close(channel);
+    return -1;
+  }
+  return channel;
+#else
+  return -1;
+#endif
+}
+
+int localChannel::acceptFrom(int listener) {
+
+#ifndef _WIN32
+  int channel;
+
+  /* Connections aborted by their clients before being accepted are skipped */
+  do {
+    channel = accept(listener, NULL, NULL);
+  } while((channel < 0) && (errno == ECONNABORTED));
+
+  return channel;
+#else
+  return -1;
+#endif
+}
+
+void localChannel::close(int channel) {
+
+#ifndef _WIN32
+  if(channel >= 0)
+    ::close(channel);
+#endif
+}
+
+bool localChannel::sendField(int channel, const char *data, long size) {
+
+#ifndef _WIN32
+  char header[32];
+
+  sprintf(header, "%ld\n", size);
+  return writeBytes(channel, header, (long) strlen(header)) &&
+    writeBytes(channel, data, size);
+#else
+  return false;
+#endif
+}
+
+bool localChannel::sendNumber(int channel, long value) {
+
+  char digits[32];
+
+  sprintf(digits, "%ld", value);
+  return sendField(channel, digits, (long) strlen(digits));
+}
+
+bool localChannel::setTimeout(int channel, int seconds) {
+
+#ifndef _WIN32
+  struct timeval timeout;
+
+  timeout.tv_sec = seconds;
+  timeout.tv_usec = 0;
+  return (setsockopt(channel, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout)) == 0) &&
+    (setsockopt(channel, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout)) == 0);
+#else
+  return false;
+#endif
+}
+
+bool localChannel::receiveField(int channel, string &data, long maxSize) {
+
+#ifndef _WIN32
+  long size = 0;
+  int digits;
+  char c;
+
+  /* Read the field size digit by digit up to the new line character */
+  for(digits = 0; ; digits++) {
+    if(!readBytes(channel, &c, 1))
+      return false;
+    if(c == '\n')
+      break;
+    if((c < '0') || (c > '9') || (digits == 18))
+      return false;
+    size = size * 10 + (c - '0');
+  }
+  if((digits == 0) || (size > maxSize))
+    return false;
+
+  data.resize(size);
+  return (size == 0) || readBytes(channel, &data[0], size);
+#else
+  return false;
+#endif
+}
+
+bool localChannel::receiveNumber(int channel, long *value) {
+
+  string digits;
+  char *end;
+
+  /* A number never takes more digits than a field size header */
+  if((!receiveField(channel, digits, 18)) || (digits.size() == 0))
+    return false;
+
+  *value = strtol(digits.c_str(), &end, 10);
+  return *end == '\0';
+}
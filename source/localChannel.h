@@ -0,0 +1,119 @@
+/* ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** *****
+   ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** *****
+
+    trimAl v1.5.0: a tool for automated alignment trimming in large-scale
+                 phylogenetics analyses.
+
+    readAl v1.5.0: a tool for automated alignment conversion among different
+                 formats.
+
+    2009-2020
+        Fernandez-Rodriguez V.  (victor.fernandez@bsc.es)
+        Capella-Gutierrez S.    (salvador.capella@bsc.es)
+        Gabaldon, T.            (tgabaldon@bsc.es)
+
+    This file is part of trimAl/readAl.
+
+    trimAl/readAl are free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, the last available version.
+
+    trimAl/readAl are distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with trimAl/readAl. If not, see <http://www.gnu.org/licenses/>.
+
+***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** *****
+***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** */
+
+#ifndef LOCALCHANNEL_H
+#define LOCALCHANNEL_H
+
+#include <string>
+
+using namespace std;
+
+/** \brief Class to exchange messages through Unix domain sockets.
+ *
+ * It is used by the trimAl server mode and its client. A message is a
+ * sequence of fields, each one sent as its size in decimal digits, a new
+ * line character and then its bytes. Numbers are sent as fields holding
+ * their decimal digits. Unix domain sockets are not available on Windows,
+ * where every method fails.
+ */
+
+class localChannel {
+
+  public:
+
+  /** \brief Listening socket creation method.
+   * \param path Path where the socket will be created. An unused socket
+   * left there by a former server is replaced.
+   * \return Socket descriptor or -1 if it could not be created.
+   */
+  static int listenAt(const char *path);
+
+  /** \brief Connection method.
+   * \param path Path where the server is listening.
+   * \return Connected socket descriptor or -1 if there is not any server.
+   */
+  static int connectTo(const char *path);
+
+  /** \brief Connection accepting method.
+   * \param listener Listening socket descriptor.
+   * \return Connected socket descriptor or -1 if the call was interrupted,
+   * with errno set to EINTR, or it failed.
+   */
+  static int acceptFrom(int listener);
+
+  /** \brief Closing method.
+   * \param channel Socket descriptor.
+   */
+  static void close(int channel);
+
+  /** \brief Field sending method.
+   * \param channel Connected socket descriptor.
+   * \param data Field content.
+   * \param size Field size.
+   * \return \b true if the whole field has been sent.
+   */
+  static bool sendField(int channel, const char *data, long size);
+
+  /** \brief Number sending method.
+   * \param channel Connected socket descriptor.
+   * \param value Number to send.
+   * \return \b true if the number has been sent.
+   */
+  static bool sendNumber(int channel, long value);
+
+  /** \brief Timeout setting method.
+   * \param channel Connected socket descriptor.
+   * \param seconds Longest time any single send or receive call may wait.
+   * \return \b true if the timeout has been set.
+   *
+   * Method that makes sending and receiving fail when the other side
+   * stalls instead of waiting for it forever.
+   */
+  static bool setTimeout(int channel, int seconds);
+
+  /** \brief Field receiving method.
+   * \param channel Connected socket descriptor.
+   * \param data String where the field content will be stored.
+   * \param maxSize Largest field size accepted. Larger fields are taken as
+   * malformed without reading them.
+   * \return \b true if a whole field has been received.
+   */
+  static bool receiveField(int channel, string &data, long maxSize);
+
+  /** \brief Number receiving method.
+   * \param channel Connected socket descriptor.
+   * \param value Pointer where the number will be stored.
+   * \return \b true if a number has been received.
+   */
+  static bool receiveNumber(int channel, long *value);
+};
+
+#endif
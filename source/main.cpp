@@ -30,1771 +30,415 @@
 #include <iostream>
 #include <iomanip>
 
-#include <stdlib.h>
-#include <string.h>
-
-#include "compareFiles.h"
-#include "compareFiles.h"
-#include "alignment.h"
-#include "defines.h"
-#include "utils.h"
-
-void menu(void);
-void examples(void);
-
-int main(int argc, char *argv[]){
-
-  /* Parameters Control */
-  bool appearErrors = false, complementary = false, colnumbering = false, nogaps = false, noallgaps = false, gappyout = false,
-       strict = false, strictplus = false, automated1 = false, sgc = false, sgt = false, scc = false, sct = false, sfc = false,
-       sft = false, sident = false, soverlap = false, selectSeqs = false, selectCols = false, shortNames = false, splitbystop = false,
-       terminal = false, keepSeqs = false, keepHeader = false, ignorestop = false;
-
-  float conserve = -1, gapThreshold = -1, simThreshold = -1, comThreshold = -1, resOverlap = -1, seqOverlap = -1, maxIdentity = -1;
-
-  int outformat = -1, compareset = -1, stats = 0, windowSize = -1, gapWindow = -1, simWindow = -1, conWindow = -1,
-      blockSize = -1, clusters = -1, alternative_matrix = -1, alignDataType = -1;
-
-  /* Others varibles */
-  ifstream compare;
-  float *compareVect = NULL;
-  alignment **compAlig  = NULL;
-  string nline, *seqNames = NULL;
-  sequencesMatrix *seqMatrix = NULL;
-  similarityMatrix *similMatrix = NULL;
-  alignment *origAlig = NULL, *intermediateAlig = NULL, *singleAlig = NULL, *backtranslation = NULL;
-
-  int i = 1, lng, num = 0, maxAminos = 0, numfiles = 0, referFile = 0, *delColumns = NULL, *delSequences = NULL, *seqLengths = NULL, *boundaries = NULL;
-  char c, *forceFile = NULL, *infile = NULL, *backtransFile = NULL, *outfile = NULL, *outhtml = NULL, *matrix = NULL,
-       **filesToCompare = NULL, line[256];
-
-  /* ------------------------------------------------------------------------------------------------------ */
-
-  /* Exec: TrimAl - Shows the menu. */
-
-  /* ------------------------------------------------------------------------------------------------------ */
-  if(argc == 1) {
-    menu();
-    return 0;
-  }
-
-  /* ------------------------------------------------------------------------------------------------------ */
-
-  /*                                        Help and Version Menu                                           */
-
-  /* ------------------------------------------------------------------------------------------------------ */
-  if(!strcmp(argv[i], "-h") && (i+1 == argc)) {
-    menu(); examples();
-    return 0;
-  }
-
-  if(!strcmp(argv[i], "--version") && (i+1 == argc)) {
-    cout << endl << "trimAl v" << VERSION << ".rev" << REVISION
-         << " build[" << BUILD << "]" << endl << endl;
-    return 0;
-  }
-
-  /***** ***** ***** ***** ***** ***** ***** Parameters Processing ***** ***** ***** ***** ***** ***** *****/
-  origAlig = new alignment;
-
-  while(i < argc) {
-
-   /* ------------------------------------------------------------------------------------------------------ */
-
-   /*                                Input and Output files and format output                                */
-
-   /* Option -in ------------------------------------------------------------------------------------------- */
-    if(!strcmp(argv[i], "-in") && (i+1 != argc) && (infile == NULL)) {
-
-      if((sfc) || (sft) || (comThreshold != -1)) {
-        cerr << endl << "ERROR: Not allowed in combination of file comparision." << endl << endl;
-        appearErrors = true;
-        i++;
-      }
-
-      else if((compareset == -1) || (forceFile != NULL)) {
-        lng = strlen(argv[++i]);
-        infile = new char[lng + 1];
-        strcpy(infile, argv[i]);
-
-        if(!origAlig -> loadAlignment(infile)) {
-          cerr << endl << "ERROR: Alignment not loaded: \"" << infile << "\" Check the file's content." << endl << endl;
-          appearErrors = true;
-        }
-      }
-
-      else {
-        if(compareset != -1)
-          cerr << endl << "ERROR: Option \"" << argv[i] << "\" not valid. A reference file exists with alignments to compare." << endl << endl;
-        if(forceFile != NULL)
-          cerr << endl << "ERROR: Option \"" << argv[i] << "\" not valid. A alignment file has been setting up to be compare with a set of alignmets." << endl << endl;
-        appearErrors = true;
-        i++;
-      }
-    }
-   /* ------------------------------------------------------------------------------------------------------ */
-
-   /* Option -out ------------------------------------------------------------------------------------------ */
-    else if((!strcmp(argv[i], "-out")) && (i+1 != argc) && (outfile == NULL)) {
-      lng = strlen(argv[++i]);
-      outfile = new char[lng + 1];
-      strcpy(outfile, argv[i]);
-    }
-
-   /* Option -htmlout -------------------------------------------------------------------------------- */
-    else if((!strcmp(argv[i], "-htmlout")) && (i+1 != argc) && (outhtml == NULL)) {
-      lng = strlen(argv[++i]);
-      outhtml = new char[lng + 1];
-      strcpy(outhtml, argv[i]);
-    }
-
-   /* ------------------------------------------------------------------------------------------------------ */
-
-   /*                                           Output File format                                           */
-
-   /* Option -clustal -------------------------------------------------------------------------------------- */
-    else if(!strcmp(argv[i], "-clustal") && (outformat == -1))
-      outformat = 1;
-
-   /* Option -fasta -------------------------------------------------------------------------------------- */
-    else if(!strcmp(argv[i], "-fasta") && (outformat == -1))
-      outformat = 8;
-
-   /* Option -fasta-m10 -------------------------------------------------------------------------------------- */
-    else if(!strcmp(argv[i], "-fasta_m10") && (outformat == -1)) {
-      outformat = 8; shortNames = true;
-   }
-
-   /* Option -nbrf ------------------------------------------------------------------------------------ */
-    else if(!strcmp(argv[i], "-nbrf") && (outformat == -1))
-      outformat = 3;
-
-   /* Option -nexus ------------------------------------------------------------------------------------ */
-    else if(!strcmp(argv[i], "-nexus") && (outformat == -1))
-      outformat = 17;
-
-   /* Option -mega ------------------------------------------------------------------------------------ */
-    else if(!strcmp(argv[i], "-mega") && (outformat == -1))
-      outformat = 21;
-
-   /* Option -phylip3.2 --------------------------------------------------------------------------------- */
-    else if(!strcmp(argv[i], "-phylip3.2") && (outformat == -1))
-      outformat = 11;
-
-   /* Option -phylip3.2-m10 ----------------------------------------------------------------------------- */
-    else if(!strcmp(argv[i], "-phylip3.2_m10") && (outformat == -1)) {
-      outformat = 11; shortNames = true;
-    }
-
-   /* Option -phylip --------------------------------------------------------------------------- */
-    else if(!strcmp(argv[i], "-phylip") && (outformat == -1))
-      outformat = 12;
-
-   /* Option -phylip-m10 ----------------------------------------------------------------------- */
-    else if(!strcmp(argv[i], "-phylip_m10") && (outformat == -1)) {
-      outformat = 12; shortNames = true;
-    }
-
-   /* Option -phylip_paml ---------------------------------------------------------------------- */
-    else if(!strcmp(argv[i], "-phylip_paml") && (outformat == -1))
-      outformat = 13;
-
-   /* Option -phylip_paml-m10 ------------------------------------------------------------------ */
-    else if(!strcmp(argv[i], "-phylip_paml_m10") && (outformat == -1)) {
-      outformat = 13; shortNames = true;
-    }
-
-   /* ------------------------------------------------------------------------------------------------------ */
-
-   /*                                         Similarity Matrix File                                         */
-
-   /* Option -matrix --------------------------------------------------------------------------------------- */
-    else if(!strcmp(argv[i], "-matrix") && (i+1 != argc) && (matrix == NULL)) {
-      lng = strlen(argv[++i]);
-      matrix = new char[lng + 1];
-      strcpy(matrix, argv[i]);
-    }
-
-    else if(!strcmp(argv[i], "--alternative_matrix") && (i+1 != argc) && (alternative_matrix == -1)) {
-      i++;
-      if (!strcmp(argv[i], "degenerated_nt_identity"))
-        alternative_matrix = 1;
-      else {
-        cerr << endl << "ERROR: Alternative not recognized \"" << argv[i] << "\"" << endl << endl;
-        appearErrors = true;
-      }
-    }
-   /* ------------------------------------------------------------------------------------------------------ */
-
-   /*                                   File with a alignments' set to compare                               */
-
-   /* Option -compareset ----------------------------------------------------------------------------------- */
-    else if(!strcmp(argv[i], "-compareset") && (i+1 != argc) && (compareset == -1)) {
-
-      if(infile == NULL) {
-        compare.open(argv[++i], ifstream::in);
-        if(!compare) {
-          cerr << endl << "ERROR: Check the reference file with the alignments to compare." << endl << endl;
-          appearErrors = true;
-        }
-
-        while(compare.getline(line, 256)) numfiles++;
-        compare.close();
-
-        compareset = i;
-      }
-
-      else {
-        cerr << endl << "ERROR: Option \"" << argv[i] << "\" not valid. A single alignment file has been set by the user." << endl << endl;
-        appearErrors = true;
-        i++;
-      }
-    }
-
-    /* Option -forceselect ----------------------------------------------------------------------------------- */
-    else if(!strcmp(argv[i], "-forceselect") && (i+1 != argc) && (forceFile == NULL)) {
-
-      if(infile == NULL) {
-        lng = strlen(argv[++i]);
-        forceFile = new char[lng + 1];
-        strcpy(forceFile, argv[i]);
-        if(!origAlig -> loadAlignment(forceFile)) {
-          cerr << endl << "ERROR: Alignment not loaded: \"" << forceFile << "\" Check the file's content." << endl << endl;
-          appearErrors = true;
-        }
-      }
-
-      else {
-        cerr << endl << "ERROR: Option \"" << argv[i] << "\" not valid. A single alignment file has been setting it up" << endl << endl;
-        appearErrors = true;
-        i++;
-      }
-    }
-
-    /* Option -backtrans -------------------------------------------------------------------------------------- */
-    else if(!strcmp(argv[i], "-backtrans") && (i+1 != argc) && (backtransFile == NULL)) {
-
-      lng = strlen(argv[++i]);
-      backtransFile = new char[lng + 1];
-      strcpy(backtransFile, argv[i]);
-
-      backtranslation = new alignment;
-      if(!backtranslation -> loadAlignment(backtransFile)) {
-        cerr << endl << "ERROR: Alignment not loaded: \"" << backtransFile << "\" Check the file's content." << endl << endl;
-        appearErrors = true;
-      }
-    }
-
-   /* ------------------------------------------------------------------------------------------------------ */
-
-   /*                                  Manual Method Values. Deleting columns                                */
-
-   /* Option -gt, gapthreshold ----------------------------------------------------------------------------- */
-    else if((!strcmp(argv[i], "-gapthreshold") || !strcmp(argv[i], "-gt")) && (i+1 != argc) && (gapThreshold == -1)) {
-
-      if((selectCols) || (selectSeqs)) {
-        cerr << endl << "ERROR: Not allowed in combination of other manual methods such as manual selection of sequences/columns." << endl << endl;
-        appearErrors = true;
-      }
-
-      else if((nogaps) || (noallgaps) || (gappyout) || (strict) || (strictplus) || (automated1)) {
-        cerr << endl << "ERROR: Combinations between automatic and manual methods are not allowed" << endl << endl;
-        appearErrors = true;
-      }
-
-      else {
-        if(utils::isNumber(argv[++i])) {
-          gapThreshold = 1 - atof(argv[i]);
-          if((gapThreshold < 0) || (gapThreshold > 1)) {
-            cerr << endl << "ERROR: The gap threshold value should be between 0 and 1." << endl << endl;
-            appearErrors = true;
-          }
-        }
-        else {
-          cerr << endl << "ERROR: The gap threshold value should be a positive real number." << endl << endl;
-          appearErrors = true;
-        }
-      }
-    }
-   /* ------------------------------------------------------------------------------------------------------ */
-
-   /* Option -st -simthreshold ----------------------------------------------------------------------------- */
-    else if((!strcmp(argv[i], "-simthreshold") || !strcmp(argv[i], "-st")) && (i+1 != argc) && (simThreshold == -1)) {
-
-      if((selectCols) || (selectSeqs)) {
-        cerr << endl << "ERROR: Not allowed in combination of other manual methods such as manual selection of sequences/columns." << endl << endl;
-        appearErrors = true;
-      }
-
-      else if((nogaps) || (noallgaps) || (gappyout) || (strict) || (strictplus) || (automated1)) {
-        cerr << endl << "ERROR: Combinations between automatic and manual methods are not allowed" << endl << endl;
-        appearErrors = true;
-      }
-
-      else {
-        if(utils::isNumber(argv[++i])) {
-          simThreshold = atof(argv[i]);
-          if((simThreshold < 0) || (simThreshold > 1)) {
-            cerr << endl << "ERROR: The similarity threshold value should be between 0 and 1." << endl << endl;
-            appearErrors = true;
-          }
-        }
-        else {
-          cerr << endl << "ERROR: The similarity threshold value should be a positive real number." << endl << endl;
-          appearErrors = true;
-        }
-      }
-    }
-   /* ------------------------------------------------------------------------------------------------------ */
-
-
-   /* Option -ct -conthreshold ----------------------------------------------------------------------------- */
-    else if((!strcmp(argv[i], "-conthreshold") || !strcmp(argv[i], "-ct")) && (i+1 != argc) && (comThreshold == -1)) {
-
-      if((selectCols) || (selectSeqs)) {
-        cerr << endl << "ERROR: Not allowed in combination of other manual methods such as manual selection of sequences/columns." << endl << endl;
-        appearErrors = true;
-      }
-
-      //~ else if((nogaps) || (noallgaps) || (gappyout) || (strict) || (strictplus) || (automated1)) {
-        //~ cerr << endl << "ERROR: Combinations between automatic and manual methods are not allowed" << endl << endl;
-        //~ appearErrors = true;
-      //~ }
-
-      else if(infile != NULL) {
-        cerr << endl << "ERROR: Not allowed in combination with -in option." << endl << endl;
-        appearErrors = true;
-
-      }
-
-      else {
-        if(utils::isNumber(argv[++i])) {
-          comThreshold = atof(argv[i]);
-          if((comThreshold < 0) || (comThreshold > 1)) {
-            cerr << endl << "ERROR: The consistency threshold value should be between 0 and 1." << endl << endl;
-            appearErrors = true;
-          }
-        }
-        else {
-          cerr << endl << "ERROR: The consistency threshold value should be a positive real number." << endl << endl;
-          appearErrors = true;
-        }
-      }
-    }
-
-   /* ------------------------------------------------------------------------------------------------------ */
-
-   /* Option -cons ----------------------------------------------------------------------------------------- */
-    else if((!strcmp(argv[i], "-cons")) && (i+1 != argc) && (conserve == -1)) {
-
-      if((selectCols) || (selectSeqs)) {
-        cerr << endl << "ERROR: Not allowed in combination of other manual methods such as manual selection of sequences/columns." << endl << endl;
-        appearErrors = true;
-      }
-
-      else if(blockSize != -1) {
-        cerr << endl << "ERROR: Not allowed in combination of column block size value." << endl << endl;
-        appearErrors = true;
-      }
-
-      else if((nogaps) || (noallgaps) || (gappyout) || (strict) || (strictplus)  || (automated1)) {
-        cerr << endl << "ERROR: Combinations between automatic and manual methods are not allowed" << endl << endl;
-        appearErrors = true;
-      }
-
-      else {
-        if(utils::isNumber(argv[++i])) {
-          conserve = atof(argv[i]);
-          if((conserve < 0) || (conserve > 100)) {
-            cerr << endl << "ERROR: The minimal positions value should be between 0 and 100." << endl << endl;
-            appearErrors = true;
-          }
-       }
-        else {
-          cerr << endl << "ERROR: The minimal positions value should be a positive real number." << endl << endl;
-          appearErrors = true;
-        }
-      }
-    }
-   /* ------------------------------------------------------------------------------------------------------ */
-
-   /* Option -selectcols -------------------------------------------------------------------------------- */
-    else if((!strcmp(argv[i], "-selectcols")) && (selectCols == false) && ((i+3) < argc) && (!strcmp(argv[++i], "{")) && (!strcmp(argv[i+2], "}"))) {
-
-      if((nogaps) || (noallgaps) || (gappyout) || (strict) || (strictplus) || (automated1)) {
-        cerr << endl << "ERROR: Combinations between automatic and manual methods are not allowed." << endl << endl;
-        appearErrors = true;
-      }
-
-      else if(blockSize != -1) {
-        cerr << endl << "ERROR: Not allowed in combination of column block size value." << endl << endl;
-        appearErrors = true;
-      }
-
-      else if((gapThreshold != -1) || (conserve != -1) || (simThreshold != -1) || (comThreshold != -1)) {
-        cerr << endl << "ERROR: Not allowed in combination of other manual methods." << endl << endl;
-        appearErrors = true;
-      }
-
-      else if((windowSize != -1) || (gapWindow != -1)|| (simWindow != -1)) {
-        cerr << endl << "ERROR: It's imposible to use this windows size in combination of selection method." << endl << endl;
-        appearErrors = true;
-      }
-
-      else if((delColumns = utils::readNumbers(argv[++i])) == NULL) {
-        cerr << endl << "ERROR: Impossible to parser the sequences number" << endl << endl;
-        appearErrors = true;
-      }
-
-      else selectCols = true;
-      i++;
-    }
-
-   /* ------------------------------------------------------------------------------------------------------ */
-
-   /*                                   Automated Methods. Deleting Columns                                  */
-
-   /* Option -nogaps --------------------------------------------------------------------------------------- */
-    else if(!strcmp(argv[i], "-nogaps") && (!nogaps)) {
-
-      if((windowSize != -1) || (gapWindow != -1) || (simWindow != -1)) {
-        cerr << endl << "ERROR: Not allowed in combination of window values." << endl << endl;
-        appearErrors = true;
-      }
-
-      else if(blockSize != -1) {
-        cerr << endl << "ERROR: Not allowed in combination of column block size value." << endl << endl;
-        appearErrors = true;
-      }
-
-      else if((noallgaps) || (gappyout) || (strict) || (strictplus) || (automated1)) {
-        cerr << endl << "ERROR: Combinations between automatic methods are not allowed." << endl << endl;
-        appearErrors = true;
-      }
-
-      //~ else if((gapThreshold != -1) || (conserve != -1) || (simThreshold != -1) ||
-        //~ (comThreshold != -1) || (selectCols) || (selectSeqs)) {
-        //~ cerr << endl << "ERROR: Combinations between automatic and manual methods are not allowed" << endl << endl;
-        //~ appearErrors = true;
-      //~ }
-      else if((gapThreshold != -1) || (conserve != -1) || (simThreshold != -1) ||
-        (selectCols) || (selectSeqs)) {
-        cerr << endl << "ERROR: Combinations between automatic and manual methods are not allowed" << endl << endl;
-        appearErrors = true;
-      }
-
-      else
-        nogaps = true;
-    }
-   /* ------------------------------------------------------------------------------------------------------ */
-
-   /* Option -noallgaps --------------------------------------------------------------------------------------- */
-    else if(!strcmp(argv[i], "-noallgaps") && (!noallgaps)) {
-
-      if((windowSize != -1) || (gapWindow != -1) || (simWindow != -1)) {
-        cerr << endl << "ERROR: Not allowed in combination of window values." << endl << endl;
-        appearErrors = true;
-      }
-
-      else if(blockSize != -1) {
-        cerr << endl << "ERROR: Not allowed in combination of column block size value." << endl << endl;
-        appearErrors = true;
-      }
-
-      else if((nogaps) || (gappyout) || (strict) || (strictplus) || (automated1)) {
-        cerr << endl << "ERROR: Combinations between automatic methods are not allowed." << endl << endl;
-        appearErrors = true;
-      }
-
-      //~ else if((gapThreshold != -1) || (conserve != -1) || (simThreshold != -1) ||
-        //~ (comThreshold != -1) || (selectCols) || (selectSeqs)) {
-        //~ cerr << endl << "ERROR: Combinations between automatic and manual methods are not allowed" << endl << endl;
-        //~ appearErrors = true;
-      //~ }
-      else if((gapThreshold != -1) || (conserve != -1) || (simThreshold != -1) ||
-        (selectCols) || (selectSeqs)) {
-        cerr << endl << "ERROR: Combinations between automatic and manual methods are not allowed" << endl << endl;
-        appearErrors = true;
-      }
-
-      else
-        noallgaps = true;
-    }
-
-   /* Option -keepseqs --------------------------------------------------------------------------------------- */
-    else if(!strcmp(argv[i], "-keepseqs") && (!keepSeqs)) {
-      keepSeqs = true;
-    }
-
-   /* Option -keepseqs --------------------------------------------------------------------------------------- */
-    else if(!strcmp(argv[i], "-keepheader") && (!keepHeader)) {
-      keepHeader = true;
-    }
-
-   /* ------------------------------------------------------------------------------------------------------ */
-
-   /* Option -gappyout ------------------------------------------------------------------------------------- */
-    else if(!strcmp(argv[i], "-gappyout") && (!strict)) {
-
-      if((windowSize != -1) || (gapWindow != -1) || (simWindow != -1)) {
-        cerr << endl << "ERROR: Not allowed in combination of window values." << endl << endl;
-        appearErrors = true;
-      }
-
-      else if((nogaps) || (noallgaps) || (strict) || (strictplus) || (automated1)) {
-        cerr << endl << "ERROR: Combinations between automatic methods are not allowed." << endl << endl;
-        appearErrors = true;
-      }
-
-      //~ else if((gapThreshold != -1) || (conserve != -1) || (simThreshold != -1) ||
-        //~ (comThreshold != -1) || (selectCols) || (selectSeqs)) {
-        //~ cerr << endl << "ERROR: Combinations between automatic and manual methods are not allowed" << endl << endl;
-        //~ appearErrors = true;
-      //~ }
-      else if((gapThreshold != -1) || (conserve != -1) || (simThreshold != -1) ||
-        (selectCols) || (selectSeqs)) {
-        cerr << endl << "ERROR: Combinations between automatic and manual methods are not allowed" << endl << endl;
-        appearErrors = true;
-      }
-
-      else
-        gappyout = true;
-    }
-   /* ------------------------------------------------------------------------------------------------------ */
-
-   /* Option -strict --------------------------------------------------------------------------------------- */
-    else if(!strcmp(argv[i], "-strict") && (!strict)) {
-
-      if((windowSize != -1) || (gapWindow != -1) || (simWindow != -1)) {
-        cerr << endl << "ERROR: Not allowed in combination of window values." << endl << endl;
-        appearErrors = true;
-      }
-
-      //~ else if(blockSize != -1) {
-        //~ cerr << endl << "ERROR: Not allowed in combination of column block size value." << endl << endl;
-        //~ appearErrors = true;
-      //~ }
-
-      else if((nogaps) || (noallgaps) || (gappyout) || (strictplus) || (automated1)) {
-        cerr << endl << "ERROR: Combinations between automatic methods are not allowed." << endl << endl;
-        appearErrors = true;
-      }
-
-      //~ else if((gapThreshold != -1) || (conserve != -1) || (simThreshold != -1) ||
-        //~ (comThreshold != -1) || (selectCols) || (selectSeqs)) {
-        //~ cerr << endl << "ERROR: Combinations between automatic and manual methods are not allowed" << endl << endl;
-        //~ appearErrors = true;
-      //~ }
-      else if((gapThreshold != -1) || (conserve != -1) || (simThreshold != -1) ||
-        (selectCols) || (selectSeqs)) {
-        cerr << endl << "ERROR: Combinations between automatic and manual methods are not allowed" << endl << endl;
-        appearErrors = true;
-      }
-
-      else
-        strict = true;
-    }
-   /* ------------------------------------------------------------------------------------------------------ */
-
-   /* Option -strictplus ----------------------------------------------------------------------------------- */
-    else if((!strcmp(argv[i], "-strictplus")) && (!strictplus)) {
-
-      if((windowSize != -1) || (gapWindow != -1) || (simWindow != -1)) {
-        cerr << endl << "ERROR: Not allowed in combination with this window value." << endl << endl;
-        appearErrors = true;
-      }
-
-      //~ else if(blockSize != -1) {
-        //~ cerr << endl << "ERROR: Not allowed in combination of column block size value." << endl << endl;
-        //~ appearErrors = true;
-      //~ }
-
-      else if((nogaps) || (noallgaps) || (gappyout) || (strict) || (automated1)) {
-        cerr << endl << "ERROR: Combinations between automatic methods are not allowed." << endl << endl;
-        appearErrors = true;
-      }
-
-      //~ else if((gapThreshold != -1) || (conserve != -1) || (simThreshold != -1) ||
-        //~ (comThreshold != -1) || (selectCols) || (selectSeqs)) {
-        //~ cerr << endl << "ERROR: Combinations between automatic and manual methods are not allowed" << endl << endl;
-        //~ appearErrors = true;
-      //~ }
-      else if((gapThreshold != -1) || (conserve != -1) || (simThreshold != -1) ||
-        (selectCols) || (selectSeqs)) {
-        cerr << endl << "ERROR: Combinations between automatic and manual methods are not allowed" << endl << endl;
-        appearErrors = true;
-      }
-
-      else
-        strictplus = true;
-    }
-   /* ------------------------------------------------------------------------------------------------------ */
-
-   /* Option -automated1 ----------------------------------------------------------------------------------- */
-    else if((!strcmp(argv[i], "-automated1")) && (!automated1)) {
-
-      if((windowSize != -1) || (gapWindow != -1) || (simWindow != -1)) {
-        cerr << endl << "ERROR: Not allowed in combination with this window value." << endl << endl;
-        appearErrors = true;
-      }
-
-      else if(blockSize != -1) {
-        cerr << endl << "ERROR: Not allowed in combination of column block size value." << endl << endl;
-        appearErrors = true;
-      }
-
-      else if((gapThreshold != -1) || (conserve != -1) || (simThreshold != -1) ||
-        (comThreshold != -1) || (selectCols) || (selectSeqs)) {
-        cerr << endl << "ERROR: Combinations between automatic methods are not allowed." << endl << endl;
-        appearErrors = true;
-      }
-
-      //~ else if((gapThreshold != -1) || (conserve != -1) || (simThreshold != -1) ||
-        //~ (comThreshold != -1) || (selectCols) || (selectSeqs)) {
-        //~ cerr << endl << "ERROR: Combinations between automatic and manual methods are not allowed" << endl << endl;
-        //~ appearErrors = true;
-      //~ }
-      else if((gapThreshold != -1) || (conserve != -1) || (simThreshold != -1) ||
-        (selectCols) || (selectSeqs)) {
-        cerr << endl << "ERROR: Combinations between automatic and manual methods are not allowed" << endl << endl;
-        appearErrors = true;
-      }
-//~
-      //~ else if((gapThreshold != -1) || (conserve != -1) || (simThreshold != -1) || (comThreshold != -1) || (delColumns != NULL)) {
-        //~ cerr << endl << "ERROR: Combinations between automatic and manual methods are not allowed" << endl << endl;
-        //~ appearErrors = true;
-      //~ }
-
-      else
-        automated1 = true;
-    }
-   /* ------------------------------------------------------------------------------------------------------ */
-
-   /* ------------------------------------------------------------------------------------------------------ */
-
-   /*                                 Manual Method Values. Deleting sequences                                */
-
-   /* Option -coloverlap ------------------------------------------------------------------------------------ */
-    else if((!strcmp(argv[i], "-resoverlap")) && (i+1 != argc) && (resOverlap == -1)) {
-
-      if((selectCols) || (selectSeqs)) {
-        cerr << endl << "ERROR: Not allowed in combination of methods such as manual selection of sequences/columns." << endl << endl;
-        appearErrors = true;
-      }
-
-      else {
-        if(utils::isNumber(argv[++i])) {
-          resOverlap = atof(argv[i]);
-          if((resOverlap < 0) || (resOverlap > 1)) {
-            cerr << endl << "ERROR: The residue overlap value should be between 0 and 1." << endl << endl;
-            appearErrors = true;
-          }
-       }
-        else {
-          cerr << endl << "ERROR: The residue overlap value should be a positive real number." << endl << endl;
-          appearErrors = true;
-        }
-      }
-    }
-   /* ------------------------------------------------------------------------------------------------------ */
-
-   /* Option -seqoverlap ----------------------------------------------------------------------------------------------------- */
-    else if((!strcmp(argv[i], "-seqoverlap")) && (i+1 != argc) && (seqOverlap == -1)) {
-
-      if((selectCols) || (selectSeqs)) {
-        cerr << endl << "ERROR: Not allowed in combination of methods such as manual selection of sequences/columns." << endl << endl;
-        appearErrors = true;
-      }
-
-      else {
-        if(utils::isNumber(argv[++i])) {
-          seqOverlap = atof(argv[i]);
-          if((seqOverlap < 0) || (seqOverlap > 100)) {
-            cerr << endl << "ERROR: The sequences overlap value should be between 0 and 100." << endl << endl;
-            appearErrors = true;
-          }
-       }
-        else {
-          cerr << endl << "ERROR: The minimal positions value should be a positive real number." << endl << endl;
-          appearErrors = true;
-        }
-      }
-    }
-
-   /* Option -selectseqs -------------------------------------------------------------------------------- */
-    else if((!strcmp(argv[i], "-selectseqs")) && (selectSeqs == false) && ((i+3) < argc) && (!strcmp(argv[++i], "{")) && (!strcmp(argv[i+2], "}"))) {
-
-      if((nogaps) || (noallgaps) || (gappyout) || (strict) || (strictplus) || (automated1)) {
-        cerr << endl << "ERROR: Combinations between automatic and manual methods are not allowed." << endl << endl;
-        appearErrors = true;
-      }
-
-      else if((gapThreshold != -1) || (conserve != -1) || (simThreshold != -1) || (comThreshold != -1)) {
-        cerr << endl << "ERROR: Not allowed in combination of other manual methods." << endl << endl;
-        appearErrors = true;
-      }
-
-      else if((windowSize != -1) || (gapWindow != -1)|| (simWindow != -1)) {
-        cerr << endl << "ERROR: It's imposible to use this windows size in combination of selection method." << endl << endl;
-        appearErrors = true;
-      }
-
-      else if((clusters != -1) || (maxIdentity != -1)) {
-        cerr << endl << "ERROR: Only one method to chose sequences can be applied." << endl << endl;
-        appearErrors = true;
-      }
-
-      else if((delSequences = utils::readNumbers(argv[++i])) == NULL) {
-        cerr << endl << "ERROR: Impossible to parser the sequences number" << endl << endl;
-        appearErrors = true;
-      }
-
-      else selectSeqs = true;
-      i++;
-    }
-
-   /* Option -maxidentity ----------------------------------------------------------------------------------- */
-    else if((!strcmp(argv[i], "-maxidentity")) && (i+1 != argc) && (maxIdentity == -1)) {
-
-      if((gapThreshold != -1) || (conserve != -1) || (simThreshold != -1) ||
-         (comThreshold != -1) || (selectCols) || (selectSeqs)) {
-        cerr << endl << "ERROR: Not allowed in combination of other manual methods such as manual "
-         << "selection of sequences/columns." << endl << endl;
-        appearErrors = true;
-      }
-
-      else if((nogaps) || (noallgaps) || (gappyout) || (strict) || (strictplus)  || (automated1)) {
-        cerr << endl << "ERROR: Combinations between automatic and manual methods are not allowed" << endl << endl;
-        appearErrors = true;
-      }
-
-      else if((windowSize != -1) || (gapWindow != -1) || (simWindow != -1)) {
-        cerr << endl << "ERROR: Not allowed in combination with window values." << endl << endl;
-        appearErrors = true;
-      }
-
-      else if(clusters != -1) {
-        cerr << endl << "ERROR: Only one method to chose representative sequences can be applied." << endl << endl;
-        appearErrors = true;
-      }
-
-      else {
-        if(utils::isNumber(argv[++i])) {
-          maxIdentity = atof(argv[i]);
-          if((maxIdentity < 0) || (maxIdentity > 1)) {
-            cerr << endl << "ERROR: The maximum identity threshold should be between 0 and 1." << endl << endl;
-            appearErrors = true;
-          }
-       }
-        else {
-          cerr << endl << "ERROR: The minimal positions value should be a positive real number." << endl << endl;
-          appearErrors = true;
-        }
-      }
-    }
-   /* ------------------------------------------------------------------------------------------------------ */
-
-   /* Option -clusters ----------------------------------------------------------------------------------- */
-    else if((!strcmp(argv[i], "-clusters")) && (i+1 != argc) && (clusters == -1)) {
-
-      if((gapThreshold != -1) || (conserve != -1) || (simThreshold != -1) ||
-         (comThreshold != -1) || (selectCols) || (selectSeqs)) {
-        cerr << endl << "ERROR: Not allowed in combination of other manual methods such as manual "
-         << "selection of sequences/columns." << endl << endl;
-        appearErrors = true;
-      }
-
-      else if((nogaps) || (noallgaps) || (gappyout) || (strict) || (strictplus)  || (automated1)) {
-        cerr << endl << "ERROR: Combinations between automatic and manual methods are not allowed" << endl << endl;
-        appearErrors = true;
-      }
-
-      else if((windowSize != -1) || (gapWindow != -1) || (simWindow != -1)) {
-        cerr << endl << "ERROR: Not allowed in combination with window values." << endl << endl;
-        appearErrors = true;
-      }
-
-      else if(maxIdentity != -1) {
-        cerr << endl << "ERROR: Only one method to chose representative sequences can be applied." << endl << endl;
-        appearErrors = true;
-      }
-
-      else {
-        if(utils::isNumber(argv[++i])) {
-          clusters = atoi(argv[i]);
-          if(clusters < 1) {
-            cerr << endl << "ERROR: There is a problem with the given clusters number." << endl << endl;
-            appearErrors = true;
-          }
-       }
-        else {
-          cerr << endl << "ERROR: The clusters number should be a positive integer number." << endl << endl;
-          appearErrors = true;
-        }
-      }
-    }
-   /* ------------------------------------------------------------------------------------------------------ */
-
-   /* ------------------------------------------------------------------------------------------------------ */
-
-   /* Other methods: Just remove the terminal gaps from an alignment keeping the columns that are in the middle
-    * of the sequences independently of the trimming method used */
-
-   /* ------------------------------------------------------------------------------------------------------ */
-   /* Option -terminalonly --------------------------------------------------------------------------------- */
-    else if((!strcmp(argv[i], "-terminalonly")) && (!terminal)) {
-      terminal = true;
-    }
-
-   /* Option --set_boundaries -------------------------------------------------------------------------------- */
-    else if((!strcmp(argv[i], "--set_boundaries")) && (!terminal) && ((i+3) < argc) && (!strcmp(argv[++i], "{")) && (!strcmp(argv[i+2], "}"))) {
-
-      if((boundaries = utils::readNumbers_StartEnd(argv[++i])) == NULL) {
-
-        cerr << endl << "ERROR: Impossible to parser the sequences number" << endl << endl;
-        appearErrors = true;
-      }
-
-      terminal = true;
-      i++;
-    }
-   /* ------------------------------------------------------------------------------------------------------ */
-
-   /* ------------------------------------------------------------------------------------------------------ */
-
-   /*                                           Windows Size Values                                           */
-
-   /* Option -w -------------------------------------------------------------------------------------------- */
-    else if(!strcmp(argv[i], "-w") && (i+1 != argc) && (windowSize == -1)){
-
-      if((gapWindow != -1) || (simWindow != -1) || (conWindow != -1)) {
-        cerr << endl << "ERROR: Not allowed in combination with this specific window value." << endl << endl;
-        appearErrors = true;
-      }
-
-      if((selectCols) || (selectSeqs)) {
-        cerr << endl << "ERROR: It's imposible to use this windows size in combination of manual selection method." << endl << endl;
-        appearErrors = true;
-      }
-
-      else if((nogaps) || (noallgaps) || (gappyout) || (strict) || (strictplus) || (automated1)) {
-        cerr << endl << "ERROR: Not allowed in combination of automatic methods." << endl << endl;
-        appearErrors = true;
-      }
-
-      else {
-        if(utils::isNumber(argv[i+1])) {
-          windowSize = atoi(argv[++i]);
-          if(windowSize <= 0){
-            cerr << endl << "ERROR: The window value should be a positive integer number." << endl << endl;
-            appearErrors = true;
-          }
-        }
-        else {
-          cerr << endl << "ERROR: The window value should be a number." << endl << endl;
-          appearErrors = true;
-        }
-      }
-      //~ i++;
-    }
-   /* ------------------------------------------------------------------------------------------------------ */
-
-   /* Option -gw -------------------------------------------------------------------------------------------- */
-    else if(!strcmp(argv[i], "-gw") && (i+1 != argc) && (gapWindow == -1)){
-
-      if(windowSize != -1) {
-        cerr << endl << "ERROR: Not allowed in combination of general window value." << endl << endl;
-        appearErrors = true;
-      }
-
-      if((selectCols) || (selectSeqs)) {
-        cerr << endl << "ERROR: It's imposible to use this windows size in combination of manual selection method." << endl << endl;
-        appearErrors = true;
-      }
-
-      else if((nogaps) || (noallgaps) || (gappyout) || (strict) || (strictplus) || (automated1)) {
-        cerr << endl << "ERROR: Not allowed in combination of automatic methods." << endl << endl;
-        appearErrors = true;
-      }
-
-      else {
-        if(utils::isNumber(argv[i+1])) {
-          gapWindow = atoi(argv[++i]);
-          if(gapWindow <= 0){
-            cerr << endl << "ERROR: The window value should be a positive integer number." << endl << endl;
-            appearErrors = true;
-          }
-        }
-        else {
-          cerr << endl << "ERROR: The window value should be a number." << endl << endl;
-          appearErrors = true;
-        }
-      }
-      //~ i++;
-    }
-   /* ------------------------------------------------------------------------------------------------------ */
-
-   /* Option -sw -------------------------------------------------------------------------------------------- */
-    else if(!strcmp(argv[i], "-sw") && (i+1 != argc) && (simWindow == -1)){
-
-      if(windowSize != -1) {
-        cerr << endl << "ERROR: Not allowed in combination of general window value." << endl << endl;
-        appearErrors = true;
-      }
-
-      if((selectCols) || (selectSeqs)) {
-        cerr << endl << "ERROR: It's imposible to use this windows size in combination of manual selection method." << endl << endl;
-        appearErrors = true;
-      }
-
-      else if((nogaps) || (noallgaps) || (gappyout) || (strict) || (strictplus) || (automated1)) {
-        cerr << endl << "ERROR: Not allowed in combination of automatic methods." << endl << endl;
-        appearErrors = true;
-      }
-
-      else {
-        if(utils::isNumber(argv[i+1])) {
-          simWindow = atoi(argv[++i]);
-          if(simWindow <= 0){
-            cerr << endl << "ERROR: The window value should be a positive integer number." << endl << endl;
-            appearErrors = true;
-          }
-        }
-        else {
-          cerr << endl << "ERROR: The window value should be a number." << endl << endl;
-          appearErrors = true;
-        }
-      }
-      //~ i++;
-    }
-   /* ------------------------------------------------------------------------------------------------------ */
-
-   /* Option -cw -------------------------------------------------------------------------------------------- */
-    else if(!strcmp(argv[i], "-cw") && (i+1 != argc) && (conWindow == -1)){
-
-      if(windowSize != -1) {
-        cerr << endl << "ERROR: Not allowed in combination of general window value." << endl << endl;
-        appearErrors = true;
-      }
-
-      if((selectCols) || (selectSeqs)) {
-        cerr << endl << "ERROR: It's imposible to use this windows size in combination of manual selection method." << endl << endl;
-        appearErrors = true;
-      }
-
-      else {
-        if(utils::isNumber(argv[i+1])) {
-          conWindow = atoi(argv[++i]);
-          if(conWindow <= 0){
-            cerr << endl << "ERROR: The window value should be a positive integer number." << endl << endl;
-            appearErrors = true;
-          }
-        }
-        else {
-          cerr << endl << "ERROR: The window value should be a number." << endl << endl;
-          appearErrors = true;
-        }
-      }
-      //~ i++;
-    }
-   /* ------------------------------------------------------------------------------------------------------ */
-
-   /* ------------------------------------------------------------------------------------------------------ */
-
-   /*                                             Block Size Value                                           */
-
-   /* Option -block -------------------------------------------------------------------------------------------- */
-    else if(!strcmp(argv[i], "-block") && (i+1 != argc) && (blockSize == -1)){
-
-      if(selectCols) {
-        cerr << endl << "ERROR: It's imposible to set a block size value in combination with a column manual selection" << endl << endl;
-        appearErrors = true;
-      }
-
-      else if(conserve != -1) {
-        cerr << endl << "ERROR: It's imposible to ask for a minimum percentage of the input alignment in combination with column block size" << endl << endl;
-        appearErrors = true;
-      }
-
-      //~ else if((nogaps) || (noallgaps) || (strict) || (strictplus) || (automated1)) {
-      else if((nogaps) || (noallgaps)) {
-        cerr << endl << "ERROR: Not allowed in combination of automatic methods." << endl << endl;
-        appearErrors = true;
-      }
-
-      else {
-        if(utils::isNumber(argv[i+1])) {
-          blockSize = atoi(argv[++i]);
-          if(blockSize <= 0){
-            cerr << endl << "ERROR: The block size value should be a positive integer number." << endl << endl;
-            appearErrors = true;
-          }
-        }
-        else {
-          cerr << endl << "ERROR: The block size value should be a number." << endl << endl;
-          appearErrors = true;
-        }
-      }
-    }
-   /* ------------------------------------------------------------------------------------------------------ */
-
-   /*                                               Statistics                                               */
-
-   /* Option -sgc ------------------------------------------------------------------------------------------ */
-    else if((!strcmp(argv[i], "-sgc")) && (!sgc)) {
-      sgc = true;
-      stats--;
-    }
-   /* ------------------------------------------------------------------------------------------------------ */
-
-   /* Option -sgt ------------------------------------------------------------------------------------------ */
-    else if((!strcmp(argv[i], "-sgt")) && (!sgt)) {
-      sgt = true;
-      stats--;
-    }
-   /* ------------------------------------------------------------------------------------------------------ */
-
-   /* Option -scc ------------------------------------------------------------------------------------------ */
-    else if((!strcmp(argv[i], "-ssc")) && (!scc)) {
-      scc = true;
-      stats--;
-    }
-   /* ------------------------------------------------------------------------------------------------------ */
-
-   /* Option -sct ------------------------------------------------------------------------------------------ */
-    else if((!strcmp(argv[i], "-sst")) && (!sct)) {
-      sct = true;
-      stats--;
-    }
-   /* ------------------------------------------------------------------------------------------------------ */
-
-   /* Option -sident --------------------------------------------------------------------------------------- */
-    else if((!strcmp(argv[i], "-sident")) && (!sident)) {
-      sident = true;
-      stats--;
-    }
-
-   /* Option -soverlap --------------------------------------------------------------------------------------- */
-    else if((!strcmp(argv[i], "-soverlap")) && (!soverlap)) {
-      soverlap = true;
-      stats--;
-    }
-   /* ------------------------------------------------------------------------------------------------------ */
-
-   /* Option -sfc ------------------------------------------------------------------------------------------ */
-    else if((!strcmp(argv[i], "-sfc")) && (!sfc)) {
-
-      if(infile != NULL) {
-        cerr << endl << "ERROR: Not allowed in combination with -in option." << endl << endl;
-        appearErrors = true;
-        i++;
-      }
-
-      else {
-        sfc = true;
-        stats--;
-      }
-    }
-   /* ------------------------------------------------------------------------------------------------------ */
-
-   /* Option -sft ------------------------------------------------------------------------------------------ */
-    else if((!strcmp(argv[i], "-sft")) && (!sft)) {
-
-      if(infile != NULL) {
-        cerr << endl << "ERROR: Not allowed in combination with -in option." << endl << endl;
-        appearErrors = true;
-        i++;
-      }
-
-      else {
-        sft = true;
-        stats--;
-      }
-    }
-   /* ------------------------------------------------------------------------------------------------------ */
+#include <sstream>
+#include <new>
 
-   /*                                            Others parameters                                           */
-
-   /* ------------------------------------------------------------------------------------------------------ */
-
-   /* Option -complementary -------------------------------------------------------------------------------- */
-    else if((!strcmp(argv[i], "-complementary")) && (complementary == false)) {
-      complementary = true;
-    }
-
-   /* Option -colnumbering ------------------------------------------------------------------------------- */
-    else if((!strcmp(argv[i], "-colnumbering")) && (colnumbering == false)) {
-      colnumbering = true;
-    }
-
-   /* Option -splitbystopcodon ------------------------------------------------------------------------------- */
-    else if((!strcmp(argv[i], "-splitbystopcodon")) && (splitbystop == false)) {
-      splitbystop = true;
-    }
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <signal.h>
+#include <pthread.h>
 
-   /* Option -ignorestopcodon ------------------------------------------------------------------------------- */
-    else if((!strcmp(argv[i], "-ignorestopcodon")) && (ignorestop == false)) {
-      ignorestop = true;
-    }
+#ifndef _WIN32
+#include <glob.h>
+#include <unistd.h>
+#endif
 
-   /* ------------------------------------------------------------------------------------------------------ */
+#include <vector>
 
-   /*                                          Not Valids Parameters                                         */
+#include "trimalLibrary.h"
+#include "localChannel.h"
+#include "threadPool.h"
+#include "defines.h"
+#include "utils.h"
 
-   /* ------------------------------------------------------------------------------------------------------ */
-    else {
-      cerr << endl << "ERROR: Parameter \"" << argv[i] << "\" not valid." << endl << endl;
-      appearErrors = true;
-    }
-   /* ------------------------------------------------------------------------------------------------------ */
-    i++;
+/* Data shared by all the alignments trimmed in batch mode. Alignments are
+ * loaded, trimmed and saved at the same time by the available threads,
+ * sharing the default similarity matrices through the library */
+struct trimalBatch {
+  pthread_mutex_t lock;
+  trimalLibrary library;
+  vector<string> inputs, outputs;
+  vector<char *> arguments;
+  int failed;
+};
 
-    if(appearErrors)
-      break;
+void menu(void);
+void examples(void);
 
-  }
-   /* ------------------------------------------------------------------------------------------------------ */
+static int trimBatch(int argc, char *argv[]);
+static int trimServer(int argc, char *argv[]);
 
-   /*                                       Postprocessing Parameters                                        */
+int main(int argc, char *argv[]) {
 
+  trimalLibrary library;
+  int i;
 
   /* ------------------------------------------------------------------------------------------------------ */
-  if((!appearErrors) && (infile != NULL) && (forceFile != NULL)) {
-     cerr << endl << "ERROR: You can not use a single alignmet at the same "
-        << "time that you force the alignment selection." << endl << endl;
-     appearErrors = true;
-  }
-  /* ------------------------------------------------------------------------------------------------------ */
-  if((!appearErrors) && (compareset == -1) && (forceFile != NULL)) {
-     cerr << endl << "ERROR: You can not force the alignment selection without set"
-        << " an alignment dataset against to compare it." << endl << endl;
-     appearErrors = true;
-  }
-  /* ------------------------------------------------------------------------------------------------------ */
-  if((!appearErrors) && (infile == NULL) && (compareset == -1) && (forceFile == NULL) && (backtransFile != NULL)) {
-     cerr << endl << "ERROR: It is impossible to use a Coding Sequences file to apply the back translation method"
-              << " without define an input alignment." << endl << endl;
-     appearErrors = true;
-  }
-  /* ------------------------------------------------------------------------------------------------------ */
-  if((!appearErrors) && (infile != NULL)) {
 
-    if(((nogaps) || (noallgaps) || (gappyout) || (strict) || (strictplus) || (automated1) ||
-      (gapThreshold != -1) || (conserve != -1) || (simThreshold != -1) || (selectCols) || (selectSeqs) ||
-      (resOverlap != -1) || (seqOverlap != -1) || (stats < 0)) &&
-      (!origAlig -> isFileAligned())) {
-        cerr << endl << "ERROR: The sequences in the input alignment should be aligned in order to use trimming method." << endl << endl;
-        appearErrors = true;
-    }
-  }
-  /* ------------------------------------------------------------------------------------------------------ */
-  if((!appearErrors) && (windowSize != -1) && (compareset != -1))
-    cerr << "INFO: Try with specific comparison file window value. parameter -cw." << endl << endl;
-  /* ------------------------------------------------------------------------------------------------------ */
+  /* Exec: TrimAl - Shows the menu. */
 
   /* ------------------------------------------------------------------------------------------------------ */
-  if((matrix != NULL) && (!appearErrors)) {
-    if((!strict) && (!strictplus) && (!automated1) && (simThreshold == -1.0) && (!scc) && (!sct)) {
-      cerr << endl << "ERROR: The Similarity Matrix can only be used with methods that use this matrix." << endl << endl;
-      appearErrors = true;
-    }
-
-    if((gapWindow != -1) ||((compareset == -1) && (conWindow != -1))) {
-      cerr << endl << "ERROR: The Similarity Matrix can only be used with general/similarity windows size." << endl << endl;
-      appearErrors = true;
-    }
+  if(argc == 1) {
+    menu();
+    return 0;
   }
-  /* ------------------------------------------------------------------------------------------------------ */
 
   /* ------------------------------------------------------------------------------------------------------ */
-  if((complementary) && (!appearErrors))
-    if((!nogaps) && (!noallgaps) && (!gappyout) && (!strict) && (!strictplus) && (!automated1)
-      && (gapThreshold == -1) && (conserve == -1) && (simThreshold == -1) && (!selectCols) && (!selectSeqs)
-    && (resOverlap == -1) && (seqOverlap == -1) && (maxIdentity == -1) && (clusters == -1)) {
-      cerr << endl << "ERROR: This parameter can only be used with either an automatic or a manual method." << endl << endl;
-      appearErrors = true;
-    }
-  /* ------------------------------------------------------------------------------------------------------ */
-
-  /* ------------------------------------------------------------------------------------------------------ */
-  if((terminal) && (boundaries != NULL) && (!appearErrors)) {
-    num = origAlig -> getNumAminos();
-
-    if((!nogaps) && (!noallgaps) && (!gappyout) && (!strict) && (!strictplus) && (!automated1)
-      && (gapThreshold == -1) && (conserve == -1) && (simThreshold == -1) && (!selectCols) && (!selectSeqs)
-    && (resOverlap == -1) && (seqOverlap == -1) && (maxIdentity == -1) && (clusters == -1)) {
-      cerr << endl << "ERROR: This parameter '--set_boundaries' can only be used with either an automatic or a manual method." << endl << endl;
-      appearErrors = true;
-    }
 
-    else if(boundaries[1] >= num) {
-      cerr << endl << "ERROR:  \"--set_boundaries\" parameter only accepts "
-        << "integer numbers between 0 and the number of positions (" << num
-        << ") - 1." << endl << endl;
-      appearErrors = true;
-    }
-  }
-
-  if((terminal) && (boundaries == NULL) && (!appearErrors))
-    if((!nogaps) && (!noallgaps) && (!gappyout) && (!strict) && (!strictplus) && (!automated1)
-      && (gapThreshold == -1) && (conserve == -1) && (simThreshold == -1) && (!selectCols) && (!selectSeqs)
-    && (resOverlap == -1) && (seqOverlap == -1) && (maxIdentity == -1) && (clusters == -1)) {
-      cerr << endl << "ERROR: This parameter '-terminalonly' can only be used with either an automatic or a manual method." << endl << endl;
-      appearErrors = true;
-    }
-  /* ------------------------------------------------------------------------------------------------------ */
+  /*                                        Help and Version Menu                                           */
 
   /* ------------------------------------------------------------------------------------------------------ */
-  if((colnumbering) && (!appearErrors)) {
-    if((!nogaps) && (!noallgaps) && (!gappyout) && (!strict) && (!strictplus) && (!automated1)
-      && (gapThreshold == -1) && (conserve == -1) && (simThreshold == -1) &&  (comThreshold == -1) && (!selectCols) && (!selectSeqs)) {
-      cerr << endl << "ERROR: This parameter can only be used with any trimming method." << endl << endl;
-      appearErrors = true;
-    }
-    else if(stats < 0) {
-      cerr << endl << "ERROR: This parameter is not valid when statistics' parameters are defined." << endl << endl;
-      appearErrors = true;
-    }
+  if(!strcmp(argv[1], "-h") && (argc == 2)) {
+    menu(); examples();
+    return 0;
   }
-  /* ------------------------------------------------------------------------------------------------------ */
 
-  /* ------------------------------------------------------------------------------------------------------ */
-  if((outhtml != NULL) && (outfile != NULL) && (!appearErrors)) {
-    if(!strcmp(outhtml, outfile)) {
-      cerr << endl << "ERROR: The output and html files should not be the same." << endl << endl;
-      appearErrors = true;
-    }
+  if(!strcmp(argv[1], "--version") && (argc == 2)) {
+    cout << endl << "trimAl v" << VERSION << ".rev" << REVISION
+         << " build[" << BUILD << "]" << endl << endl;
+    return 0;
   }
 
-  /* ------------------------------------------------------------------------------------------------------ */
+  /* Batch mode trims every alignment from a list with the same options */
+  for(i = 1; i < argc; i++)
+    if((!strcmp(argv[i], "-batch")) || (!strcmp(argv[i], "-batchglob")))
+      return trimBatch(argc, argv);
 
-  if((outhtml != NULL) && (!appearErrors)) {
-   if((!nogaps) && (!noallgaps) && (!gappyout) && (!strict) && (!strictplus) && (!automated1) &&
-      (gapThreshold == -1) && (conserve == -1) && (simThreshold == -1) && (comThreshold == -1) &&
-      (!selectCols) && (!selectSeqs) && (resOverlap == -1) && (seqOverlap == -1) && (maxIdentity == -1) &&
-    (clusters == -1)) {
-      cerr << endl << "ERROR: This parameter can only be used with any trimming method." << endl << endl;
-      appearErrors = true;
-    }
-  }
-  /* ------------------------------------------------------------------------------------------------------ */
+  /* Server mode trims the alignments sent through a local socket */
+  for(i = 1; i < argc; i++)
+    if(!strcmp(argv[i], "--serve"))
+      return trimServer(argc, argv);
 
-  /* ------------------------------------------------------------------------------------------------------ */
+  return library.run(argc, argv);
+}
 
-  //~ if((outhtml != NULL) && (!appearErrors)) {
-   //~ if(((gapThreshold != -1) || (simThreshold != -1)) && (comThreshold != -1)) {
-      //~ cerr << endl << "ERROR: Impossible to generate the HTML file using two consecutive trimming methods." << endl << endl;
-      //~ appearErrors = true;
-    //~ }
-  //~ }
-  /* ------------------------------------------------------------------------------------------------------ */
+/* ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** */
+/* Trim one of the alignments from a batch, reporting it when it fails */
+/* ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** */
+static void trimBatchEntry(void *data, int entry) {
 
+  trimalBatch *batch = (trimalBatch *) data;
+  vector<char *> arguments(batch -> arguments);
 
-  /* ------------------------------------------------------------------------------------------------------ */
-  if(((resOverlap != -1) || (seqOverlap != -1)) && (!appearErrors)) {
+  arguments.push_back((char *) "-in");
+  arguments.push_back((char *) batch -> inputs[entry].c_str());
+  arguments.push_back((char *) "-out");
+  arguments.push_back((char *) batch -> outputs[entry].c_str());
 
-    if((resOverlap != -1) && (seqOverlap == -1)) {
-      cerr << endl << "ERROR: The sequence overlap value should be defined." << endl << endl;
-      appearErrors = true;
+  if(!batch -> library.trim((int) arguments.size(), &arguments[0])) {
+    pthread_mutex_lock(&batch -> lock);
+    batch -> failed++;
+    cerr << "ERROR: Alignment \"" << batch -> inputs[entry] << "\" has not been trimmed." << endl << endl;
+    pthread_mutex_unlock(&batch -> lock);
+  }
+}
+
+/* ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** */
+/* Trim every alignment from a batch file, or matching a pattern, with the
+ * rest of the command line options. Alignments are shared among -threads
+ * threads */
+/* ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** */
+static int trimBatch(int argc, char *argv[]) {
+
+  const char *unavailable[] = {"-in", "-out", "-htmlout", "-compareset", "-forceselect", "-backtrans", "-sgc", "-sgt",
+    "-ssc", "-sst", "-sident", "-soverlap", "-sfc", "-sft", "-colnumbering", NULL};
+  char *batchFile = NULL, *pattern = NULL, *outDir = NULL;
+  bool appearErrors = false;
+  int i, j, threads = -1;
+  string nline, name;
+  size_t first, last;
+  trimalBatch batch;
+  ifstream manifest;
+
+  batch.arguments.push_back(argv[0]);
+
+  /* ***** ***** ***** ***** ***** ***** ***** ***** */
+  /* Split the batch options from the trimming ones,
+   * shared by every alignment */
+  for(i = 1; (i < argc) && (!appearErrors); i++) {
+    if((!strcmp(argv[i], "-batch")) && (i+1 != argc) && (batchFile == NULL))
+      batchFile = argv[++i];
+
+    else if((!strcmp(argv[i], "-batchglob")) && (i+1 != argc) && (pattern == NULL))
+      pattern = argv[++i];
+
+    else if((!strcmp(argv[i], "-batchoutdir")) && (i+1 != argc) && (outDir == NULL))
+      outDir = argv[++i];
+
+    else if((!strcmp(argv[i], "-threads")) && (i+1 != argc) && (threads == -1)) {
+      if(utils::isNumber(argv[i+1])) {
+        threads = atoi(argv[++i]);
+        if(threads <= 0) {
+          cerr << endl << "ERROR: The threads number should be a positive integer number." << endl << endl;
+          appearErrors = true;
+        }
+      }
+      else {
+        cerr << endl << "ERROR: The threads number should be a number." << endl << endl;
+        appearErrors = true;
+      }
     }
 
-    else if((resOverlap == -1) && (seqOverlap != -1)) {
-      cerr << endl << "ERROR: The residue overlap value should be defined." << endl << endl;
-      appearErrors = true;
+    else {
+      for(j = 0; unavailable[j] != NULL; j++)
+        if(!strcmp(argv[i], unavailable[j])) {
+          cerr << endl << "ERROR: Option \"" << argv[i] << "\" is not available in batch mode." << endl << endl;
+          appearErrors = true;
+        }
+      batch.arguments.push_back(argv[i]);
     }
   }
-  /* ------------------------------------------------------------------------------------------------------ */
-
-  /* ------------------------------------------------------------------------------------------------------ */
-  if((stats < 0) && (!appearErrors)) {
-    stats--;
+  /* ***** ***** ***** ***** ***** ***** ***** ***** */
 
-    if(((nogaps) || (noallgaps) || (gappyout) || (strict) || (strictplus) || (automated1)
-      || (gapThreshold != -1) || (conserve != -1) || (simThreshold != -1)) && (outfile == NULL)) {
-      cerr << endl << "ERROR: An output file should be defined in order to get the alignment's statistics." << endl << endl;
-      appearErrors = true;
-    }
+  /* ***** ***** ***** ***** ***** ***** ***** ***** */
+  if((!appearErrors) && (batchFile != NULL) && (pattern != NULL)) {
+    cerr << endl << "ERROR: Choose either a batch file or a pattern to look for the alignments." << endl << endl;
+    appearErrors = true;
   }
-  /* ------------------------------------------------------------------------------------------------------ */
 
-  /* ------------------------------------------------------------------------------------------------------ */
-  if((comThreshold != -1) && (conserve != -1) && (!appearErrors)) {
+  if((!appearErrors) && (pattern != NULL) && (outDir == NULL)) {
+    cerr << endl << "ERROR: An output directory should be defined for the alignments matching the pattern." << endl << endl;
+    appearErrors = true;
+  }
 
-    if((gapThreshold != -1) || (simThreshold != -1)) {
-      cerr << endl << "ERROR: Combinations among thresholds are not allowed." << endl << endl;
+  if((!appearErrors) && (batchFile != NULL) && (outDir != NULL)) {
+    cerr << endl << "ERROR: The output directory can only be used with a pattern. Set every output alignment in the batch file." << endl << endl;
+    appearErrors = true;
+  }
+  /* ***** ***** ***** ***** ***** ***** ***** ***** */
+
+  /* ***** ***** ***** ***** ***** ***** ***** ***** */
+  /* Each line from the batch file has an input and
+   * an output alignment, separated by blank spaces
+   * or tabs. Empty lines and lines starting by '#'
+   * are skipped */
+  if((!appearErrors) && (batchFile != NULL)) {
+    manifest.open(batchFile, ifstream::in);
+    if(!manifest) {
+      cerr << endl << "ERROR: Check the batch file \"" << batchFile << "\"." << endl << endl;
       appearErrors = true;
     }
-  }
-  /* **** ***** ***** ***** ***** ***** **** **************************** **** ***** ***** ***** ***** ***** **** */
-
-  /* **** ***** ***** ***** ***** ***** ***** Files Comparison Methods ***** ***** ***** ***** ***** ***** **** */
-  if((compareset != -1) && (!appearErrors)) {
-
-    compAlig = new alignment*[numfiles];
-    filesToCompare = new char*[numfiles];
-
-    /* -------------------------------------------------------------------- */
-    compare.open(argv[compareset], ifstream::in);
 
-    for(i = 0; (i < numfiles)  && (!appearErrors); i++) {
+    for(i = 1; (!appearErrors) && (getline(manifest, nline)); i++) {
+      first = nline.find_first_not_of(" \t\r");
+      if((first == string::npos) || (nline[first] == '#'))
+        continue;
 
-      /* -------------------------------------------------------------------- */
-      for(nline.clear(), compare.read(&c, 1); (c != '\n') && ((!compare.eof())); compare.read(&c, 1))
-        nline += c;
-
-      filesToCompare[i] = new char [nline.size() + 1];
-      strcpy(filesToCompare[i], nline.c_str());
-      /* -------------------------------------------------------------------- */
-
-      /* -------------------------------------------------------------------- */
-      compAlig[i] = new alignment;
-      if(!compAlig[i] -> loadAlignment(filesToCompare[i])) {
-        cerr << endl << "Alignment not loaded: \"" << filesToCompare[i] << "\" Check the file's content." << endl << endl;
+      last = nline.find_first_of(" \t\r", first);
+      name = nline.substr(first, last - first);
+      first = nline.find_first_not_of(" \t\r", last);
+      if(first == string::npos) {
+        cerr << endl << "ERROR: Line " << i << " from the batch file should have an input and an output alignment." << endl << endl;
         appearErrors = true;
+        break;
       }
+      last = nline.find_last_not_of(" \t\r");
 
-      else {
-        if(!compAlig[i] -> isFileAligned()) {
-          cerr << endl << "ERROR: The sequences in the input alignment should be aligned in order to use this method." << endl << endl;
-          appearErrors = true;
-        } else {
-          compAlig[i] -> sequenMatrix();
-
-          if(compAlig[i] -> getNumAminos() > maxAminos)
-            maxAminos = compAlig[i] -> getNumAminos();
-
-          if((compAlig[i] -> getTypeAlignment() != alignDataType) && (alignDataType != -1)) {
-            cerr << endl << "ERROR: The alignments' datatypes are different. Check your dataset." << endl << endl;
-            appearErrors = true;
-          } else
-            alignDataType = compAlig[i] -> getTypeAlignment();
-        }
-      }
-    }
-    /* -------------------------------------------------------------------- */
-
-    /* -------------------------------------------------------------------- */
-    if((!appearErrors) && (forceFile == NULL)) {
-
-      compareVect = new float[maxAminos];
-      if((stats >= 0) && (outfile != NULL))
-        referFile = compareFiles::algorithm(compAlig, filesToCompare, compareVect, numfiles, true);
-      else
-        referFile = compareFiles::algorithm(compAlig, filesToCompare, compareVect, numfiles, false);
-
-      if(windowSize != -1)
-        compareFiles::applyWindow(compAlig[referFile] -> getNumAminos(), windowSize, compareVect);
-      else if(conWindow != -1)
-        compareFiles::applyWindow(compAlig[referFile] -> getNumAminos(), conWindow, compareVect);
-
-      origAlig -> loadAlignment(filesToCompare[referFile]);
-
-    } else if((!appearErrors) && (forceFile != NULL)) {
-
-      compareVect = new float[origAlig -> getNumAminos()];
-      appearErrors = !(compareFiles::forceComparison(compAlig, numfiles, origAlig, compareVect));
-
-      if((windowSize != -1) && (!appearErrors))
-        compareFiles::applyWindow(origAlig -> getNumAminos(), windowSize, compareVect);
-      else if((conWindow != -1) && (!appearErrors))
-        compareFiles::applyWindow(origAlig -> getNumAminos(), conWindow, compareVect);
+      batch.inputs.push_back(name);
+      batch.outputs.push_back(nline.substr(first, last - first + 1));
     }
-    /* -------------------------------------------------------------------- */
-
-    /* -------------------------------------------------------------------- */
-    for(i = 0; i < numfiles; i++) {
-      delete compAlig[i];
-      delete filesToCompare[i];
-    }
-    /* -------------------------------------------------------------------- */
+    manifest.close();
   }
+  /* ***** ***** ***** ***** ***** ***** ***** ***** */
 
-  /* **** ***** ***** ***** ***** ***** **** **************************** **** ***** ***** ***** ***** ***** **** */
+  /* ***** ***** ***** ***** ***** ***** ***** ***** */
+  /* Alignments matching the pattern keep their names
+   * in the output directory */
+  if((!appearErrors) && (pattern != NULL)) {
+#ifndef _WIN32
+    glob_t matches;
 
-  /* ------------------------------------------------------------------------------------------------------ */
-  if((!appearErrors) && (origAlig -> getNumAminos() < (blockSize/4))) {
-     cerr << endl << "ERROR: The block size value is too big. Please, choose another one smaller than residues number / 4." << endl << endl;
-     appearErrors = true;
+    if(glob(pattern, 0, NULL, &matches) == 0) {
+      for(i = 0; i < (int) matches.gl_pathc; i++) {
+        name = matches.gl_pathv[i];
+        batch.inputs.push_back(name);
+        batch.outputs.push_back(string(outDir) + "/" + name.substr(name.find_last_of('/') + 1));
+      }
+    }
+    globfree(&matches);
+#else
+    cerr << endl << "ERROR: Patterns are not available in this platform. Use a batch file instead." << endl << endl;
+    appearErrors = true;
+#endif
   }
 
-  if((!appearErrors) && (backtransFile != NULL) && (backtranslation -> getTypeAlignment() != DNAType && backtranslation -> getTypeAlignment() != DNADeg)) {
-     cerr << endl << "ERROR: Check your Coding sequences file. It has been detected other kind of biological sequences." << endl << endl;
-     appearErrors = true;
-  }
-  /* ------------------------------------------------------------------------------------------------------ */
-  if((!appearErrors) && (origAlig -> isFileAligned() != true) && (backtransFile != NULL)) {
-     cerr << endl << "ERROR: The input protein file has to be aligned to carry out the backtranslation process" << endl << endl;
-     appearErrors = true;
-  }
-  /* ------------------------------------------------------------------------------------------------------ */
-  if((!appearErrors) && (backtransFile == NULL) && (splitbystop)) {
-     cerr << endl << "ERROR: The -splitbystopcodon parameter can be only set up with backtranslation functionality." << endl << endl;
-     appearErrors = true;
-  }
-  /* ------------------------------------------------------------------------------------------------------ */
-  if((!appearErrors) && (backtransFile == NULL) && (ignorestop)) {
-     cerr << endl << "ERROR: The -ignorestopcodon parameter can be only set up with backtranslation functionality." << endl << endl;
-     appearErrors = true;
-  }
-  /* ------------------------------------------------------------------------------------------------------ */
-  if((!appearErrors) && (ignorestop) && (splitbystop)) {
-     cerr << endl << "ERROR: Incompatibility of -ignorestopcodon & -splitbystopcodon parameters. Choose one." << endl << endl;
-     appearErrors = true;
-  }
-  /* ------------------------------------------------------------------------------------------------------ */
-  if((!appearErrors)  && (backtransFile != NULL) && (backtranslation -> prepareCodingSequence(splitbystop, ignorestop, origAlig) != true))
+  if((!appearErrors) && (batch.inputs.size() == 0)) {
+    cerr << endl << "ERROR: There are not alignments to trim in batch mode." << endl << endl;
     appearErrors = true;
-
-  /* ------------------------------------------------------------------------------------------------------ */
-  if((!appearErrors) && (backtransFile != NULL)) {
-
-    seqNames = new string[backtranslation -> getNumSpecies()];
-    seqLengths = new int[backtranslation -> getNumSpecies()];
-    backtranslation -> getSequences(seqNames, seqLengths);
-
-    if(origAlig -> checkCorrespondence(seqNames, seqLengths, backtranslation -> getNumSpecies(), 3) != true)
-      appearErrors = true;
   }
-  /* ------------------------------------------------------------------------------------------------------ */
-
-  /* **** ***** ***** ***** ***** ***** **** End of Parameters Processing **** ***** ***** ***** ***** ***** **** */
-
+  /* ***** ***** ***** ***** ***** ***** ***** ***** */
 
-  /* **** ***** ***** ***** ***** ***** **** Errors Control **** ***** ***** ***** ***** ***** **** */
-  if(appearErrors) {
-
-    delete singleAlig;
-    delete origAlig;
-    delete[] compAlig;
-
-    delete similMatrix;
-    delete []delColumns;
-
-    delete[] filesToCompare;
-    delete[] compareVect;
+  if(appearErrors)
+    return -1;
 
-    delete[] outfile;
-    delete[] outhtml;
+  /* ***** ***** ***** ***** ***** ***** ***** ***** */
+  /* Trim the alignments sharing them among threads */
+  pthread_mutex_init(&batch.lock, NULL);
+  batch.failed = 0;
 
-    delete[] infile;
-    delete[] matrix;
+  threadPool::computeItems((int) batch.inputs.size(), threads, trimBatchEntry, &batch);
 
-    if(forceFile != NULL) delete forceFile;
-    if(backtransFile != NULL) delete backtransFile;
-    if(backtranslation != NULL) delete backtranslation;
+  pthread_mutex_destroy(&batch.lock);
+  /* ***** ***** ***** ***** ***** ***** ***** ***** */
 
+  if(batch.failed != 0) {
+    cerr << "ERROR: " << batch.failed << " of " << batch.inputs.size() << " alignments have not been trimmed." << endl << endl;
     return -1;
   }
-  /* **** ***** ***** ***** ***** ***** ** End Errors Control ** ***** ***** ***** ***** ***** **** */
+  return 0;
+}
 
-  /* -------------------------------------------------------------------- */
-  if(conserve == -1)
-    conserve  = 0;
-  /* -------------------------------------------------------------------- */
+/* ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** */
+/* Stop the server once the request being trimmed, if any, has been answered */
+/* ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** */
+static volatile sig_atomic_t stopServer = 0;
 
-  origAlig -> trimTerminalGaps(terminal, boundaries);
-  origAlig -> setKeepSequencesFlag(keepSeqs);
-  origAlig -> setKeepSeqsHeaderFlag(keepHeader);
+static void stopServerSignal(int) {
+  stopServer = 1;
+}
 
-  /* -------------------------------------------------------------------- */
-  if(windowSize != -1) {
-    gapWindow = windowSize;
-    simWindow = windowSize;
-  }
+/* ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** */
+/* Listen on a local socket for alignments to trim. Each request has the
+ * command line options, with the input alignment name after -in, and then
+ * the alignment content. The answer has the exit code, the standard output,
+ * where the trimmed alignment is printed, and the standard error. A request
+ * without options stops the server. Requests are trimmed one at a time,
+ * since their outputs are captured from the standard streams, while every
+ * request may use several threads. The default similarity matrices are
+ * kept among requests by the library */
+/* ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** */
+static int trimServer(int argc, char *argv[]) {
+
+#ifndef _WIN32
+  const char *unavailable[] = {"-out", "-htmlout", "-compareset", "-forceselect", "-backtrans", "--serve", NULL};
+  struct sigaction action;
+  stringbuf output, errors;
+  streambuf *coutBuffer, *cerrBuffer;
+  ios coutFormat(NULL), cerrFormat(NULL);
+  vector<string> options;
+  vector<char *> arguments;
+  string alignmentData;
+  char *socketPath = NULL;
+  int i, j, listener, client, code;
+  long number;
+  trimalLibrary library;
+
+  if((argc == 3) && (!strcmp(argv[1], "--serve")))
+    socketPath = argv[2];
   else {
-    if(gapWindow == -1)
-      gapWindow = 0;
-    if(simWindow == -1)
-      simWindow = 0;
-  }
-  origAlig -> setWindowsSize(gapWindow, simWindow);
-
-  /* -------------------------------------------------------------------- */
-
-  /* -------------------------------------------------------------------- */
-  if(blockSize != -1)
-    origAlig -> setBlockSize(blockSize);
-
-  /* -------------------------------------------------------------------- */
-
-  /* -------------------------------------------------------------------- */
-  if(outformat != -1)
-    origAlig -> setOutputFormat(outformat, shortNames);
-  /* -------------------------------------------------------------------- */
-
-  /* -------------------------------------------------------------------- */
-  if((strict) || (strictplus) || (automated1) || (simThreshold != -1.0) || (scc == 1) || (sct == 1)) {
-    similMatrix = new similarityMatrix();
-
-    if(matrix != NULL)
-      similMatrix -> loadSimMatrix(matrix);
-
-    /* User can choose alternative matrices such as other BLOSUMs, PAMs, Identity Matrices, etc */
-    else if(alternative_matrix != -1) {
-      alignDataType = origAlig -> getTypeAlignment();
-      similMatrix -> alternativeSimilarityMatrices(alternative_matrix, alignDataType);
-    }
-
-    else {
-      alignDataType = origAlig -> getTypeAlignment();
-      if(alignDataType == AAType)
-        similMatrix -> defaultAASimMatrix();
-      else if((alignDataType == DNAType) || (alignDataType == RNAType))
-        similMatrix -> defaultNTSimMatrix();
-      else if((alignDataType == DNADeg) || (alignDataType == RNADeg))
-        similMatrix -> defaultNTDegeneratedSimMatrix();
-    }
-
-    if(!origAlig -> setSimilarityMatrix(similMatrix)) {
-      cerr << endl << "ERROR: It's imposible to proccess the Similarity Matrix." << endl << endl;
-      return -1;
-    }
-  }
-  /* -------------------------------------------------------------------- */
-
-  /* -------------------------------------------------------------------- */
-  if(sgc) {
-    origAlig -> printStatisticsGapsColumns();
-    stats++;
-    if(stats < -1)
-      cout << endl;
-  }
-
-  if(sgt) {
-    origAlig -> printStatisticsGapsTotal();
-    stats++;
-    if(stats < -1)
-      cout << endl;
-  }
-
-  if(scc) {
-    origAlig -> printStatisticsConservationColumns();
-    stats++;
-    if(stats < -1)
-      cout << endl;
-  }
-
-  if(sct) {
-    origAlig -> printStatisticsConservationTotal();
-    stats++;
-    if(stats < -1)
-      cout << endl;
-  }
-
-  if(sident) {
-    origAlig -> printSeqIdentity();
-    stats++;
-    if(stats < -1)
-      cout << endl;
+    cerr << endl << "ERROR: The server mode only needs the socket path: trimal --serve <socket>." << endl << endl;
+    return -1;
   }
 
-  if(soverlap) {
-    origAlig -> printSeqOverlap();
-    stats++;
-    if(stats < -1)
-      cout << endl;
-  }
-  /* -------------------------------------------------------------------- */
-
-  /* -------------------------------------------------------------------- */
-  if(compareset != -1) {
-    if(sfc)
-      compareFiles::printStatisticsFileColumns(origAlig -> getNumAminos(), compareVect);
-    if(sft)
-      compareFiles::printStatisticsFileAcl(origAlig -> getNumAminos(), compareVect);
+  listener = localChannel::listenAt(socketPath);
+  if(listener == -1) {
+    cerr << endl << "ERROR: Impossible to listen on \"" << socketPath << "\". Check the path is not in use." << endl << endl;
+    return -1;
   }
-  /* -------------------------------------------------------------------- */
-
-  /* -------------------------------------------------------------------- */
-  if(backtransFile != NULL)
-    seqMatrix = origAlig -> getSeqMatrix();
-  /* -------------------------------------------------------------------- */
-
-  /* -------------------------------------------------------------------- */
-  if(nogaps)
-    singleAlig = origAlig -> cleanGaps(0, 0, complementary);
 
-  else if(noallgaps)
-    singleAlig = origAlig -> cleanNoAllGaps(complementary);
-
-  else if(gappyout)
-    singleAlig = origAlig -> clean2ndSlope(complementary);
-
-  else if(strict)
-    singleAlig = origAlig -> cleanCombMethods(complementary, false);
-
-  else if(strictplus)
-    singleAlig = origAlig -> cleanCombMethods(complementary, true);
+  /* Interruptions stop the server, which removes its socket. Clients
+   * leaving before getting their answer are just forgotten */
+  memset(&action, 0, sizeof(action));
+  action.sa_handler = stopServerSignal;
+  sigaction(SIGINT, &action, NULL);
+  sigaction(SIGTERM, &action, NULL);
+  signal(SIGPIPE, SIG_IGN);
+
+  while(!stopServer) {
+    client = localChannel::acceptFrom(listener);
+    if((client == -1) && (errno == EINTR))
+      continue;
+    if(client == -1) {
+      cerr << endl << "ERROR: The server can not accept any other request." << endl << endl;
+      break;
+    }
 
-  else if(automated1) {
-    if(origAlig -> selectMethod() == GAPPYOUT)
-      singleAlig = origAlig -> clean2ndSlope(complementary);
-    else
-      singleAlig = origAlig -> cleanCombMethods(complementary, false);
-  }
-  /* -------------------------------------------------------------------- */
-
-  /* -------------------------------------------------------------------- */
-  if(comThreshold != -1)
-    singleAlig = origAlig -> cleanCompareFile(comThreshold, conserve, compareVect, complementary);
- /* -------------------------------------------------------------------- */
-
-  /* -------------------------------------------------------------------- */
-  if((resOverlap != -1) && (seqOverlap != -1)) {
-    intermediateAlig = origAlig -> cleanSpuriousSeq(resOverlap, (seqOverlap/100), complementary);
-    singleAlig = intermediateAlig -> cleanNoAllGaps(false);
-    
-    delete intermediateAlig;
-  }
-  /* -------------------------------------------------------------------- */
-
-  /* -------------------------------------------------------------------- */
-  if(simThreshold != -1.0) {
-    if(gapThreshold != -1.0)
-      singleAlig = origAlig -> clean(conserve, gapThreshold, simThreshold, complementary);
-    else
-      singleAlig = origAlig -> cleanConservation(conserve, simThreshold, complementary);
-  }
-  /* -------------------------------------------------------------------- */
-
-  /* -------------------------------------------------------------------- */
-  else if(gapThreshold != -1.0)
-    singleAlig = origAlig -> cleanGaps(conserve, gapThreshold, complementary);
-  /* -------------------------------------------------------------------- */
-
-  /* -------------------------------------------------------------------- */
-  if((selectCols) || (selectSeqs)) {
-
-    /* Columns and/or sequences to be removed might be disordered. Therefore,
-     * we cannot assume the last element of the vectors are the highest ones.
-     * We check every single element to make sure they are inbetween the
-     * established boundaries e.g. max number of sequences and/or columns.
-     */
-    
-    if(delColumns != NULL) {
-      num = origAlig -> getNumAminos();
-
-      for(i = 1; i < delColumns[0] + 1; i++) 
-        if(delColumns[i] >= num) {
-          cerr << endl << "ERROR: This option only accepts integer numbers "
-              "between 0 and the number of columns - 1." << endl << endl;
-          appearErrors = true;
+    /* ***** ***** ***** ***** ***** ***** ***** ***** */
+    /* Receive the request. Malformed ones, too large ones and those from
+     * clients which stall are dropped, so they do not keep the server from
+     * answering other clients */
+    localChannel::setTimeout(client, CHANNELTIMEOUT);
+    options.clear();
+    if(!localChannel::receiveNumber(client, &number) || (number < 0)) {
+      localChannel::close(client);
+      continue;
+    }
+    try {
+      for(i = 0; i < number; i++) {
+        options.push_back(string());
+        if(!localChannel::receiveField(client, options[i], CHANNELOPTIONSIZE))
           break;
+      }
+      if((i == number) && (!localChannel::receiveField(client, alignmentData, CHANNELFIELDSIZE)))
+        i = -1;
+    } catch(bad_alloc &) {
+      i = -1;
+    }
+    if(i != number) {
+      options.clear();
+      alignmentData.clear();
+      localChannel::close(client);
+      continue;
+    }
+    /* ***** ***** ***** ***** ***** ***** ***** ***** */
+
+    /* ***** ***** ***** ***** ***** ***** ***** ***** */
+    /* Trim the alignment capturing the standard streams.
+     * Their format is restored for the next request */
+    coutFormat.copyfmt(cout);
+    cerrFormat.copyfmt(cerr);
+    output.str("");
+    errors.str("");
+    coutBuffer = cout.rdbuf(&output);
+    cerrBuffer = cerr.rdbuf(&errors);
+
+    code = 0;
+    for(i = 0; i < number; i++)
+      for(j = 0; unavailable[j] != NULL; j++)
+        if(options[i] == unavailable[j]) {
+          cerr << endl << "ERROR: Option \"" << options[i] << "\" is not available in server mode." << endl << endl;
+          code = -1;
         }
 
-      if (!appearErrors)
-        singleAlig = origAlig -> removeColumns(delColumns, 1, delColumns[0], \
-          complementary);
-
-    }
+    if(number == 0)
+      stopServer = 1;
 
-    if(delSequences != NULL) {
-      num = origAlig -> getNumSpecies();
+    else if(code == 0) {
+      arguments.clear();
+      arguments.push_back(argv[0]);
+      for(i = 0; i < number; i++)
+        arguments.push_back((char *) options[i].c_str());
 
-      for(i = 1; i < delSequences[0] + 1; i++) 
-        if(delSequences[i] >= num) {
-          cerr << endl << "ERROR: This option only accepts integer numbers "
-              "between 0 and the number of sequences - 1." << endl << endl;
-          appearErrors = true;
-          break;
-        }
-        
-      if (!appearErrors) {
-        intermediateAlig = origAlig -> removeSequences(delSequences, 1, \
-          delSequences[0], complementary);
-        singleAlig = intermediateAlig -> cleanNoAllGaps(false);
-        
-        delete intermediateAlig;
+      try {
+        if(!library.trim((int) arguments.size(), &arguments[0], alignmentData.data(), (long) alignmentData.size()))
+          code = -1;
+      } catch(bad_alloc &) {
+        cerr << endl << "ERROR: There is not enough memory to trim the alignment." << endl << endl;
+        code = -1;
       }
     }
-  }
-  /* -------------------------------------------------------------------- */
-
-  /* -------------------------------------------------------------------- */
-  if(maxIdentity != -1) {
-    intermediateAlig = origAlig -> getClustering(maxIdentity);
-    singleAlig = intermediateAlig -> cleanNoAllGaps(false);
-    
-    delete intermediateAlig;  
-  }
-  else if(clusters != -1) {
-  if(clusters > origAlig -> getNumSpecies()) {
-        cerr << endl << "ERROR:The number of clusters from the alignment can not be larger than the number of sequences from that alignment." << endl << endl;
-        appearErrors = true;
-    } else {
-    intermediateAlig = origAlig -> getClustering(origAlig -> getCutPointClusters(clusters));
-    singleAlig = intermediateAlig -> cleanNoAllGaps(false);
-    
-    delete intermediateAlig;
-  }
-  }
-  /* -------------------------------------------------------------------- */
-
-  /* -------------------------------------------------------------------- */
-  if(singleAlig == NULL) {
-    singleAlig = origAlig;
-    origAlig = NULL;
-  }
-  /* -------------------------------------------------------------------- */
-
-  /* -------------------------------------------------------------------- */
-  if((outhtml != NULL) && (!appearErrors))
-    if(!origAlig -> alignmentSummaryHTML(outhtml, singleAlig -> getNumAminos(), singleAlig -> getNumSpecies(),
-                                     singleAlig -> getCorrespResidues(), singleAlig -> getCorrespSequences(), compareVect)) {
-      cerr << endl << "ERROR: It's imposible to generate the HTML output file." << endl << endl;
-      appearErrors = true;
-    }
-  /* -------------------------------------------------------------------- */
-
-  /* -------------------------------------------------------------------- */
-  if(backtransFile != NULL) {
-
-  if(seqNames != NULL) delete [] seqNames;
-    seqNames = new string[singleAlig -> getNumSpecies()];
-
-  singleAlig -> getSequences(seqNames);
 
-  singleAlig = backtranslation -> getTranslationCDS(singleAlig -> getNumAminos(), singleAlig -> getNumSpecies(),
-                                                      singleAlig -> getCorrespResidues(), seqNames, seqMatrix, singleAlig);
-  }
-  /* -------------------------------------------------------------------- */
+    cout.flush();
+    cout.rdbuf(coutBuffer);
+    cerr.rdbuf(cerrBuffer);
+    cout.copyfmt(coutFormat);
+    cerr.copyfmt(cerrFormat);
+    /* ***** ***** ***** ***** ***** ***** ***** ***** */
 
-  /* -------------------------------------------------------------------- */
-  if((outfile != NULL) && (!appearErrors)) {
-    if(!singleAlig -> saveAlignment(outfile)) {
-      cerr << endl << "ERROR: It's imposible to generate the output file." << endl << endl;
-      appearErrors = true;
-    }
+    localChannel::sendNumber(client, code);
+    localChannel::sendField(client, output.str().data(), (long) output.str().size());
+    localChannel::sendField(client, errors.str().data(), (long) errors.str().size());
+    localChannel::close(client);
   }
-  else if((stats >= 0) && (!appearErrors))
-    singleAlig -> printAlignment();
-  /* -------------------------------------------------------------------- */
-
-  /* -------------------------------------------------------------------- */
-  if((colnumbering) && (!appearErrors))
-    singleAlig -> printCorrespondence();
-  /* -------------------------------------------------------------------- */
-
-  /* -------------------------------------------------------------------- */
-  delete singleAlig;
-  delete origAlig;
-    
-  delete[] compAlig;
-
-  delete similMatrix;
-  delete []delColumns;
-
-  delete[] filesToCompare;
-  delete[] compareVect;
-
-  delete[] outfile;
-  delete[] outhtml;
-
-  delete[] infile;
-  delete[] matrix;
-  /* -------------------------------------------------------------------- */
 
+  localChannel::close(listener);
+  unlink(socketPath);
   return 0;
+#else
+  cerr << endl << "ERROR: The server mode is not available in this platform." << endl << endl;
+  return -1;
+#endif
 }
 
 void menu(void) {
@@ -1821,7 +465,8 @@ void menu(void) {
   cout << "    -h                          " << "Print this information and show some examples." << endl;
   cout << "    --version                   " << "Print the trimAl version." << endl << endl;
 
-  cout << "    -in <inputfile>             " << "Input file in several formats (clustal, fasta, NBRF/PIR, nexus, phylip3.2, phylip)." << endl << endl;
+  cout << "    -in <inputfile>             " << "Input file in several formats (clustal, fasta, NBRF/PIR, nexus, phylip3.2, phylip)." << endl
+       << "                                gzip and zstd compressed files are detected automatically. Use '-' for stdin." << endl << endl;
 
   cout << "    -compareset <inputfile>     " << "Input list of paths for the files containing the alignments to compare." << endl;
   cout << "    -forceselect <inputfile>    " << "Force selection of the given input file in the files comparison method." << endl << endl;
@@ -1835,7 +480,8 @@ void menu(void) {
   cout << "    --alternative_matrix <name> " << "Select an alternative similarity matrix already loaded. " << endl
        << "                                Only available 'degenerated_nt_identity'" << endl << endl;
 
-  cout << "    -out <outputfile>           " << "Output alignment in the same input format (default stdout). (default input format)" << endl;
+  cout << "    -out <outputfile>           " << "Output alignment in the same input format (default stdout). (default input format)" << endl
+       << "                                It is compressed when its name ends with '.gz' (gzip) or '.zst' (zstd). Use '-' for stdout." << endl;
   cout << "    -htmlout <outputfile>       " << "Get a summary of trimal's work in an HTML file." << endl << endl;
 
   cout << "    -keepheader                 " << "Keep original sequence header including non-alphanumeric characters." << endl;
@@ -1897,6 +543,17 @@ void menu(void) {
   cout << "    -seqoverlap                 " << "Minimum percentage of \"good positions\" that a sequence must have in order to be conserved. Range: [0 - 100]"
                                              << "(see User Guide)." << endl << endl;
 
+  cout << "    -threads <n>                " << "Number of threads used to compute the pairwise sequences matrices and to compare alignments (default 1)." << endl
+       << "                                In batch mode, number of alignments trimmed at the same time." << endl << endl;
+
+  cout << "    -batch <inputfile>          " << "Trim, with the same options, every alignment from a file with an input and an output" << endl
+       << "                                alignment per line." << endl;
+  cout << "    -batchglob <pattern>        " << "Trim, with the same options, every alignment matching a quoted pattern, e.g. 'dir/*.fasta'." << endl;
+  cout << "    -batchoutdir <directory>    " << "Directory where the alignments matching the pattern are written with the same name." << endl << endl;
+
+  cout << "    --serve <socket>            " << "Keep trimAl running, trimming the alignments sent through a local socket by 'trimalclient'" << endl
+       << "                                until it is asked to stop. Not available on Windows." << endl << endl;
+
   cout << "    -clusters <n>               " << "Get the most Nth representatives sequences from a given alignment. Range: [1 - (Number of sequences)]" << endl;
   cout << "    -maxidentity <n>            " << "Get the representatives sequences for a given identity threshold. Range: [0 - 1]." << endl << endl;
 
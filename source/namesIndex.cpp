@@ -0,0 +1,85 @@
+/* ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** *****
+   ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** *****
+
+    trimAl v1.5.0: a tool for automated alignment trimming in large-scale
+                 phylogenetics analyses.
+
+    readAl v1.5.0: a tool for automated alignment conversion among different
+                 formats.
+
+    2009-2020
+        Fernandez-Rodriguez V.  (victor.fernandez@bsc.es)
+        Capella-Gutierrez S.    (salvador.capella@bsc.es)
+        Gabaldon, T.            (tgabaldon@bsc.es)
+
+    This file is part of trimAl/readAl.
+
+    trimAl/readAl are free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, the last available version.
+
+    trimAl/readAl are distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with trimAl/readAl. If not, see <http://www.gnu.org/licenses/>.
+
+***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** *****
+***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** */
+
+#include "namesIndex.h"
+
+#include <algorithm>
+
+/* Order the positions by name, and the positions of the same name by their
+ * value, so the first one is found for repeated names */
+struct namesOrder {
+  const string *names;
+
+  bool operator()(int a, int b) const {
+    int order = names[a].compare(names[b]);
+    return (order < 0) || ((order == 0) && (a < b));
+  }
+};
+
+namesIndex::namesIndex(const string *sequencesNames, int sequences) {
+
+  namesOrder order;
+  int i;
+
+  number = sequences;
+  names = sequencesNames;
+
+  sorted = new int[number];
+  for(i = 0; i < number; i++)
+    sorted[i] = i;
+
+  order.names = names;
+  sort(sorted, sorted + number, order);
+}
+
+namesIndex::~namesIndex(void) {
+
+  delete [] sorted;
+}
+
+int namesIndex::find(const string &name) {
+
+  int first, last, middle;
+
+  /* Look for the first sorted position whose name is not lower than the
+   * given one */
+  for(first = 0, last = number; first < last; ) {
+    middle = first + (last - first) / 2;
+    if(names[sorted[middle]].compare(name) < 0)
+      first = middle + 1;
+    else
+      last = middle;
+  }
+
+  if((first < number) && (names[sorted[first]] == name))
+    return sorted[first];
+  return -1;
+}
@@ -0,0 +1,79 @@
+/* ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** *****
+   ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** *****
+
+    trimAl v1.5.0: a tool for automated alignment trimming in large-scale
+                 phylogenetics analyses.
+
+    readAl v1.5.0: a tool for automated alignment conversion among different
+                 formats.
+
+    2009-2020
+        Fernandez-Rodriguez V.  (victor.fernandez@bsc.es)
+        Capella-Gutierrez S.    (salvador.capella@bsc.es)
+        Gabaldon, T.            (tgabaldon@bsc.es)
+
+    This file is part of trimAl/readAl.
+
+    trimAl/readAl are free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, the last available version.
+
+    trimAl/readAl are distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with trimAl/readAl. If not, see <http://www.gnu.org/licenses/>.
+
+***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** *****
+***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** */
+
+#ifndef NAMESINDEX_H
+#define NAMESINDEX_H
+
+#include <string>
+
+using namespace std;
+
+/** \brief Class to look for sequences by their names.
+ *
+ * Positions of the names are kept sorted by name, so a name is found with a
+ * binary search instead of comparing it against every name. If a name is
+ * repeated, the first position where it is at is returned, as a sequential
+ * search would do. The names are not copied, so they have to be available
+ * while the index is used.
+ */
+
+class namesIndex {
+
+  int number;
+
+  /* Names of the sequences */
+  const string *names;
+
+  /* Positions of the names, sorted by name and then by position */
+  int *sorted;
+
+  public:
+
+  /** \brief Constructor.
+   * \param sequencesNames Names of the sequences.
+   * \param sequences Number of sequences.
+   */
+  namesIndex(const string *sequencesNames, int sequences);
+
+  /** \brief Destructor.
+   *
+   * Destruction method that frees previously allocated memory.
+   */
+  ~namesIndex(void);
+
+  /** \brief Name looking for method.
+   * \param name Name to look for.
+   * \return First position where the name is at or -1 if it is not present.
+   */
+  int find(const string &name);
+};
+
+#endif
@@ -0,0 +1,294 @@
+/* ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** *****
+   ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** *****
+
+    trimAl v1.5.0: a tool for automated alignment trimming in large-scale
+                 phylogenetics analyses.
+
+    readAl v1.5.0: a tool for automated alignment conversion among different
+                 formats.
+
+    2009-2020
+        Fernandez-Rodriguez V.  (victor.fernandez@bsc.es)
+        Capella-Gutierrez S.    (salvador.capella@bsc.es)
+        Gabaldon, T.            (tgabaldon@bsc.es)
+
+    This file is part of trimAl/readAl.
+
+    trimAl/readAl are free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, the last available version.
+
+    trimAl/readAl are distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with trimAl/readAl. If not, see <http://www.gnu.org/licenses/>.
+
+***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** *****
+***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** */
+
+#include "packedSequences.h"
+
+#include <string.h>
+
+packedSequences::packedSequences(string *alignmentMatrix, int species, int aminos, char indetSymbol) {
+
+  bool used[256];
+  const unsigned char *residues;
+  uint64_t *seqCodes, *seqGaps, *seqIndets;
+  int i, j, length, symbols, code, shift;
+
+  seqsNumber = species;
+  resNumber = aminos;
+  indet = indetSymbol;
+
+  /* Look for the symbols used in the alignment. Gaps are not encoded */
+  memset(used, 0, sizeof(used));
+  for(i = 0; i < seqsNumber; i++) {
+    residues = (const unsigned char *) alignmentMatrix[i].data();
+    length = (int) alignmentMatrix[i].size();
+    for(j = 0; j < length; j++)
+      used[residues[j]] = true;
+  }
+  used[(unsigned char) '-'] = false;
+
+  /* Codes are given following the symbols order */
+  for(i = 0, symbols = 0; i < 256; i++) {
+    symbolCode[i] = 0;
+    codeSymbol[i] = '-';
+    if(used[i]) {
+      symbolCode[i] = symbols;
+      codeSymbol[symbols++] = (char) i;
+    }
+  }
+
+  /* Use as few bits as possible, and never let codes cross words */
+  for(bits = 1; (1 << bits) < symbols; bits++) ;
+  codesPerWord = 64 / bits;
+  codeWords = (resNumber + codesPerWord - 1) / codesPerWord;
+  maskWords = (resNumber + 63) / 64;
+
+  fieldsLow = fieldsHigh = 0;
+  for(i = 0; i < codesPerWord; i++) {
+    fieldsLow |= (((uint64_t) 1 << (bits - 1)) - 1) << (i * bits);
+    fieldsHigh |= (uint64_t) 1 << (i * bits + bits - 1);
+  }
+  lastMask = (resNumber & 63) ? ((uint64_t) 1 << (resNumber & 63)) - 1 : ~(uint64_t) 0;
+
+  codes = new uint64_t[(long) seqsNumber * codeWords];
+  gaps = new uint64_t[(long) seqsNumber * maskWords];
+  indets = new uint64_t[(long) seqsNumber * maskWords];
+  valid = new uint64_t[(long) seqsNumber * codeWords];
+
+  memset(codes, 0, sizeof(uint64_t) * seqsNumber * codeWords);
+  memset(gaps, 0, sizeof(uint64_t) * seqsNumber * maskWords);
+  memset(indets, 0, sizeof(uint64_t) * seqsNumber * maskWords);
+
+  /* Encode each sequence. Positions beyond the sequence end, if any, are
+   * considered as gaps */
+  for(i = 0; i < seqsNumber; i++) {
+    residues = (const unsigned char *) alignmentMatrix[i].data();
+    length = (int) alignmentMatrix[i].size();
+    if(length > resNumber)
+      length = resNumber;
+
+    seqCodes = codes + (long) i * codeWords;
+    seqGaps = gaps + (long) i * maskWords;
+    seqIndets = indets + (long) i * maskWords;
+
+    for(j = 0, shift = 0, code = 0; j < length; j++) {
+      if(residues[j] == '-')
+        seqGaps[j >> 6] |= (uint64_t) 1 << (j & 63);
+      else {
+        seqCodes[code] |= (uint64_t) symbolCode[residues[j]] << shift;
+        if(residues[j] == (unsigned char) indet)
+          seqIndets[j >> 6] |= (uint64_t) 1 << (j & 63);
+      }
+
+      shift += bits;
+      if(shift + bits > 64) {
+        shift = 0;
+        code++;
+      }
+    }
+
+    for( ; j < resNumber; j++)
+      seqGaps[j >> 6] |= (uint64_t) 1 << (j & 63);
+  }
+
+  markValidResidues();
+}
+
+packedSequences::~packedSequences(void) {
+
+  delete [] codes;
+  delete [] gaps;
+  delete [] indets;
+  delete [] valid;
+}
+
+void packedSequences::setIndetermination(char indetSymbol) {
+  /* Rebuild the indeterminations bitmasks for a different symbol. Nothing
+   * is marked if the symbol does not appear in the alignment */
+  uint64_t *seqGaps, *seqIndets;
+  int i, j, code;
+
+  if(indetSymbol == indet)
+    return;
+
+  indet = indetSymbol;
+  memset(indets, 0, sizeof(uint64_t) * seqsNumber * maskWords);
+
+  code = symbolCode[(unsigned char) indet];
+  if(codeSymbol[code] == indet)
+    for(i = 0; i < seqsNumber; i++) {
+      seqGaps = gaps + (long) i * maskWords;
+      seqIndets = indets + (long) i * maskWords;
+      for(j = 0; j < resNumber; j++)
+        if((getCode(i, j) == code) && (!(seqGaps[j >> 6] & ((uint64_t) 1 << (j & 63)))))
+          seqIndets[j >> 6] |= (uint64_t) 1 << (j & 63);
+    }
+
+  markValidResidues();
+}
+
+void packedSequences::markValidResidues(void) {
+  /* Move the residues bitmask bits to the code fields layout */
+  uint64_t *seqValid, word;
+  int i, j, shift, code;
+
+  memset(valid, 0, sizeof(uint64_t) * seqsNumber * codeWords);
+
+  for(i = 0; i < seqsNumber; i++) {
+    seqValid = valid + (long) i * codeWords;
+    for(j = 0, word = 0, shift = bits - 1, code = 0; j < resNumber; j++) {
+      if(!(j & 63))
+        word = residuesWord(i, j >> 6);
+      if(word & ((uint64_t) 1 << (j & 63)))
+        seqValid[code] |= (uint64_t) 1 << shift;
+
+      shift += bits;
+      if(shift >= 64) {
+        shift = bits - 1;
+        code++;
+      }
+    }
+  }
+}
+
+uint64_t packedSequences::residuesWord(int sequence, int word) {
+  uint64_t residues;
+
+  residues = ~(gaps[(long) sequence * maskWords + word] | indets[(long) sequence * maskWords + word]);
+  return (word == maskWords - 1) ? residues & lastMask : residues;
+}
+
+char packedSequences::getIndetermination(void) {
+  return indet;
+}
+
+void packedSequences::countGaps(int *gapsInColumn) {
+  /* Visit only the bits set in each gaps word */
+  const uint64_t *seqGaps;
+  uint64_t word;
+  int i, j;
+
+  for(i = 0; i < seqsNumber; i++) {
+    seqGaps = gaps + (long) i * maskWords;
+    for(j = 0; j < maskWords; j++)
+      for(word = seqGaps[j]; word != 0; word &= word - 1)
+        gapsInColumn[(j << 6) + __builtin_ctzll(word)]++;
+  }
+}
+
+void packedSequences::countIndeterminations(int *indetsInColumn) {
+  /* Visit only the bits set in each indeterminations word */
+  const uint64_t *seqIndets;
+  uint64_t word;
+  int i, j;
+
+  for(i = 0; i < seqsNumber; i++) {
+    seqIndets = indets + (long) i * maskWords;
+    for(j = 0; j < maskWords; j++)
+      for(word = seqIndets[j]; word != 0; word &= word - 1)
+        indetsInColumn[(j << 6) + __builtin_ctzll(word)]++;
+  }
+}
+
+int packedSequences::countResidues(int sequence) {
+  int j, count;
+
+  for(j = 0, count = 0; j < maskWords; j++)
+    count += __builtin_popcountll(residuesWord(sequence, j));
+  return count;
+}
+
+int packedSequences::countSharedResidues(int seqA, int seqB) {
+  int j, count;
+
+  for(j = 0, count = 0; j < maskWords; j++)
+    count += __builtin_popcountll(residuesWord(seqA, j) & residuesWord(seqB, j));
+  return count;
+}
+
+int packedSequences::countIdenticalResidues(int seqA, int seqB) {
+  /* Code fields are compared all at once: adding the lowest bits of each
+   * field to themselves sets the highest bit of any field that differs, and
+   * there is no carry from one field into the next one */
+  const uint64_t *codesA, *codesB, *validA, *validB;
+  uint64_t differ;
+  int j, count;
+
+  codesA = codes + (long) seqA * codeWords;
+  codesB = codes + (long) seqB * codeWords;
+  validA = valid + (long) seqA * codeWords;
+  validB = valid + (long) seqB * codeWords;
+
+  for(j = 0, count = 0; j < codeWords; j++) {
+    differ = codesA[j] ^ codesB[j];
+    differ = (((differ & fieldsLow) + fieldsLow) | differ) & fieldsHigh;
+    count += __builtin_popcountll(~differ & validA[j] & validB[j]);
+  }
+  return count;
+}
+
+int packedSequences::getCode(int sequence, int residue) {
+  uint64_t word;
+
+  word = codes[(long) sequence * codeWords + residue / codesPerWord];
+  return (int) ((word >> ((residue % codesPerWord) * bits)) & (((uint64_t) 1 << bits) - 1));
+}
+
+char packedSequences::getSymbol(int code) {
+  return codeSymbol[code];
+}
+
+const uint64_t *packedSequences::getCodes(int sequence) {
+  return codes + (long) sequence * codeWords;
+}
+
+const uint64_t *packedSequences::getGaps(int sequence) {
+  return gaps + (long) sequence * maskWords;
+}
+
+const uint64_t *packedSequences::getIndeterminations(int sequence) {
+  return indets + (long) sequence * maskWords;
+}
+
+int packedSequences::getBitsPerCode(void) {
+  return bits;
+}
+
+int packedSequences::getCodesPerWord(void) {
+  return codesPerWord;
+}
+
+int packedSequences::getCodeWords(void) {
+  return codeWords;
+}
+
+int packedSequences::getMaskWords(void) {
+  return maskWords;
+}
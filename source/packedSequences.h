@@ -0,0 +1,183 @@
+/* ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** *****
+   ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** *****
+
+    trimAl v1.5.0: a tool for automated alignment trimming in large-scale
+                 phylogenetics analyses.
+
+    readAl v1.5.0: a tool for automated alignment conversion among different
+                 formats.
+
+    2009-2020
+        Fernandez-Rodriguez V.  (victor.fernandez@bsc.es)
+        Capella-Gutierrez S.    (salvador.capella@bsc.es)
+        Gabaldon, T.            (tgabaldon@bsc.es)
+
+    This file is part of trimAl/readAl.
+
+    trimAl/readAl are free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, the last available version.
+
+    trimAl/readAl are distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with trimAl/readAl. If not, see <http://www.gnu.org/licenses/>.
+
+***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** *****
+***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** */
+
+#ifndef PACKEDSEQUENCES_H
+#define PACKEDSEQUENCES_H
+
+#include <stdint.h>
+#include <string>
+
+using namespace std;
+
+/** \brief Class containing an encoded copy of the alignment sequences.
+ *
+ * Each residue, except gaps, is encoded using as few bits as the alphabet
+ * used in the alignment needs: 2 bits for pure nucleotide alignments, 5 bits
+ * for most amino acid alignments and up to 8 bits in the worst case. Codes
+ * are packed into 64-bit words without crossing word boundaries.
+ *
+ * Gaps and indeterminations are also stored as separate bitmasks, one bit
+ * per residue, so they can be counted or combined a whole word at a time.
+ */
+
+class packedSequences {
+
+  int seqsNumber;
+  int resNumber;
+
+  /* Bits per code, codes per 64-bit word and words per sequence both for
+   * codes and bitmasks */
+  int bits;
+  int codesPerWord;
+  int codeWords;
+  int maskWords;
+
+  /* Indetermination symbol used to build the indeterminations bitmasks */
+  char indet;
+
+  /* Codes and bitmasks storage. Sequences are stored one after the other */
+  uint64_t *codes;
+  uint64_t *gaps;
+  uint64_t *indets;
+
+  /* Residues that are neither gaps nor indeterminations, flagged using the
+   * highest bit of their code field so they can be combined with codes */
+  uint64_t *valid;
+
+  /* Lowest bits and highest bit of every code field in a word, and valid
+   * positions in the last bitmasks word */
+  uint64_t fieldsLow;
+  uint64_t fieldsHigh;
+  uint64_t lastMask;
+
+  /* Code assigned to each symbol and symbol for each code */
+  int symbolCode[256];
+  char codeSymbol[256];
+
+  /* Flag valid residues for the current indetermination symbol */
+  void markValidResidues(void);
+
+  /* Residues bitmask word, i.e. neither gaps nor indeterminations */
+  uint64_t residuesWord(int sequence, int word);
+
+  public:
+
+  /** \brief Encoding constructor.
+   * \param alignmentMatrix Aligned sequences.
+   * \param species Number of sequences.
+   * \param aminos Number of residues per sequence.
+   * \param indetSymbol Indetermination symbol.
+   */
+  packedSequences(string *alignmentMatrix, int species, int aminos, char indetSymbol);
+
+  /** \brief Destructor.
+   *
+   * Destruction method that frees previously allocated memory.
+   */
+  ~packedSequences(void);
+
+  /** \brief Indetermination symbol setting method.
+   * \param indetSymbol New indetermination symbol.
+   *
+   * Method that rebuilds the indeterminations bitmasks from the residues
+   * codes when the symbol is different from the current one.
+   */
+  void setIndetermination(char indetSymbol);
+
+  /** \brief Indetermination symbol getting method.
+   * \return Symbol used to build the indeterminations bitmasks.
+   */
+  char getIndetermination(void);
+
+  /** \brief Gaps counting method.
+   * \param gapsInColumn Vector where the gaps number of each column is added.
+   */
+  void countGaps(int *gapsInColumn);
+
+  /** \brief Indeterminations counting method.
+   * \param indetsInColumn Vector where the indeterminations number of each
+   * column is added.
+   */
+  void countIndeterminations(int *indetsInColumn);
+
+  /** \brief Residues counting method.
+   * \param sequence Sequence index.
+   * \return Number of positions that are neither gaps nor indeterminations.
+   */
+  int countResidues(int sequence);
+
+  /** \brief Shared residues counting method.
+   * \param seqA First sequence index.
+   * \param seqB Second sequence index.
+   * \return Number of positions where both sequences have a residue, i.e.
+   * neither a gap nor an indetermination.
+   */
+  int countSharedResidues(int seqA, int seqB);
+
+  /** \brief Identical residues counting method.
+   * \param seqA First sequence index.
+   * \param seqB Second sequence index.
+   * \return Number of positions where both sequences have the same residue.
+   * Gaps and indeterminations are never counted.
+   */
+  int countIdenticalResidues(int seqA, int seqB);
+
+  /** \brief Residue code getting method.
+   * \param sequence Sequence index.
+   * \param residue Residue index.
+   * \return Code of the residue. Gaps always get the code 0, so the gaps
+   * bitmask should be checked to tell them apart from other symbols.
+   */
+  int getCode(int sequence, int residue);
+
+  /** \brief Code decoding method.
+   * \param code Residue code.
+   * \return Symbol encoded with the given code.
+   */
+  char getSymbol(int code);
+
+  /* Raw access to the packed words of a given sequence */
+  const uint64_t *getCodes(int sequence);
+
+  const uint64_t *getGaps(int sequence);
+
+  const uint64_t *getIndeterminations(int sequence);
+
+  int getBitsPerCode(void);
+
+  int getCodesPerWord(void);
+
+  int getCodeWords(void);
+
+  int getMaskWords(void);
+};
+
+#endif
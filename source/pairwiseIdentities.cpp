@@ -0,0 +1,72 @@
+/* ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** *****
+   ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** *****
+
+    trimAl v1.5.0: a tool for automated alignment trimming in large-scale
+                 phylogenetics analyses.
+
+    readAl v1.5.0: a tool for automated alignment conversion among different
+                 formats.
+
+    2009-2020
+        Fernandez-Rodriguez V.  (victor.fernandez@bsc.es)
+        Capella-Gutierrez S.    (salvador.capella@bsc.es)
+        Gabaldon, T.            (tgabaldon@bsc.es)
+
+    This file is part of trimAl/readAl.
+
+    trimAl/readAl are free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, the last available version.
+
+    trimAl/readAl are distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with trimAl/readAl. If not, see <http://www.gnu.org/licenses/>.
+
+***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** *****
+***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** */
+
+#include "pairwiseIdentities.h"
+#include "utils.h"
+
+pairwiseIdentities::pairwiseIdentities(int sequences, char indetSymbol) {
+
+  elements = sequences;
+  indet = indetSymbol;
+
+  values = new float[(long) elements * (elements - 1) / 2 + 1];
+}
+
+pairwiseIdentities::~pairwiseIdentities(void) {
+
+  delete [] values;
+}
+
+char pairwiseIdentities::getIndetermination(void) {
+  return indet;
+}
+
+float pairwiseIdentities::getIdentity(int seqA, int seqB) {
+
+  if(seqA == seqB)
+    return 0;
+  else if(seqA < seqB)
+    return values[utils::triangleOffset(seqA, elements) + seqB];
+  else
+    return values[utils::triangleOffset(seqB, elements) + seqA];
+}
+
+void pairwiseIdentities::setIdentity(int seqA, int seqB, float identity) {
+
+  if(seqA < seqB)
+    values[utils::triangleOffset(seqA, elements) + seqB] = identity;
+  else
+    values[utils::triangleOffset(seqB, elements) + seqA] = identity;
+}
+
+const float *pairwiseIdentities::getRow(int sequence) {
+  return values + utils::triangleOffset(sequence, elements);
+}
@@ -0,0 +1,95 @@
+/* ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** *****
+   ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** *****
+
+    trimAl v1.5.0: a tool for automated alignment trimming in large-scale
+                 phylogenetics analyses.
+
+    readAl v1.5.0: a tool for automated alignment conversion among different
+                 formats.
+
+    2009-2020
+        Fernandez-Rodriguez V.  (victor.fernandez@bsc.es)
+        Capella-Gutierrez S.    (salvador.capella@bsc.es)
+        Gabaldon, T.            (tgabaldon@bsc.es)
+
+    This file is part of trimAl/readAl.
+
+    trimAl/readAl are free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, the last available version.
+
+    trimAl/readAl are distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with trimAl/readAl. If not, see <http://www.gnu.org/licenses/>.
+
+***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** *****
+***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** */
+
+#ifndef PAIRWISEIDENTITIES_H
+#define PAIRWISEIDENTITIES_H
+
+/** \brief Class containing the identity scores between every pair of
+ * sequences in an alignment.
+ *
+ * Scores are symmetric, so only the upper triangle of the matrix is stored,
+ * row by row, which halves the memory of a full matrix. The same scores are
+ * shared by the sequences identity statistics, the clustering methods and
+ * the identity weights of the similarity statistics.
+ */
+
+class pairwiseIdentities {
+
+  int elements;
+
+  /* Indetermination symbol used to compute the scores */
+  char indet;
+
+  /* Upper triangle of the scores matrix, without its diagonal */
+  float *values;
+
+  public:
+
+  /** \brief Constructor.
+   * \param sequences Number of sequences.
+   * \param indetSymbol Indetermination symbol used to compute the scores.
+   */
+  pairwiseIdentities(int sequences, char indetSymbol);
+
+  /** \brief Destructor.
+   *
+   * Destruction method that frees previously allocated memory.
+   */
+  ~pairwiseIdentities(void);
+
+  /** \brief Indetermination symbol getting method.
+   * \return Symbol used to compute the scores.
+   */
+  char getIndetermination(void);
+
+  /** \brief Identity score getting method.
+   * \param seqA First sequence index.
+   * \param seqB Second sequence index.
+   * \return Identity score between both sequences, 0 for the same sequence.
+   */
+  float getIdentity(int seqA, int seqB);
+
+  /** \brief Identity score setting method.
+   * \param seqA First sequence index.
+   * \param seqB Second, and different, sequence index.
+   * \param identity Identity score between both sequences.
+   */
+  void setIdentity(int seqA, int seqB, float identity);
+
+  /** \brief Scores row getting method.
+   * \param sequence Sequence index.
+   * \return Row of scores for the given sequence. Only the positions of the
+   * following sequences, i.e. greater than the given index, are valid.
+   */
+  const float *getRow(int sequence);
+};
+
+#endif
@@ -0,0 +1,95 @@
+/* ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** *****
+   ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** *****
+
+    trimAl v1.5.0: a tool for automated alignment trimming in large-scale
+                 phylogenetics analyses.
+
+    readAl v1.5.0: a tool for automated alignment conversion among different
+                 formats.
+
+    2009-2020
+        Fernandez-Rodriguez V.  (victor.fernandez@bsc.es)
+        Capella-Gutierrez S.    (salvador.capella@bsc.es)
+        Gabaldon, T.            (tgabaldon@bsc.es)
+
+    This file is part of trimAl/readAl.
+
+    trimAl/readAl are free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, the last available version.
+
+    trimAl/readAl are distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with trimAl/readAl. If not, see <http://www.gnu.org/licenses/>.
+
+***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** *****
+***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** */
+
+#include <limits.h>
+
+#include "pairwiseOverlaps.h"
+#include "utils.h"
+
+pairwiseOverlaps::pairwiseOverlaps(int sequences, int length) {
+
+  long pairs;
+
+  elements = sequences;
+  residues = new int[elements];
+
+  /* Shared residues will never be more than the alignment length */
+  pairs = (long) elements * (elements - 1) / 2 + 1;
+  shortShared = NULL;
+  shared = NULL;
+  if(length <= USHRT_MAX)
+    shortShared = new unsigned short[pairs];
+  else
+    shared = new int[pairs];
+}
+
+pairwiseOverlaps::~pairwiseOverlaps(void) {
+
+  delete [] residues;
+  delete [] shortShared;
+  delete [] shared;
+}
+
+void pairwiseOverlaps::setResidues(int sequence, int count) {
+  residues[sequence] = count;
+}
+
+void pairwiseOverlaps::setShared(int seqA, int seqB, int count) {
+  long pos;
+
+  if(seqA < seqB)
+    pos = utils::triangleOffset(seqA, elements) + seqB;
+  else
+    pos = utils::triangleOffset(seqB, elements) + seqA;
+
+  if(shortShared != NULL)
+    shortShared[pos] = (unsigned short) count;
+  else
+    shared[pos] = count;
+}
+
+float pairwiseOverlaps::getOverlap(int reference, int sequence) {
+  long pos;
+
+  /* Every residue is shared with the sequence itself */
+  if(reference == sequence)
+    return (float) residues[reference]/residues[reference];
+
+  if(reference < sequence)
+    pos = utils::triangleOffset(reference, elements) + sequence;
+  else
+    pos = utils::triangleOffset(sequence, elements) + reference;
+
+  if(shortShared != NULL)
+    return (float) shortShared[pos]/residues[reference];
+  else
+    return (float) shared[pos]/residues[reference];
+}
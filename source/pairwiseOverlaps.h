@@ -0,0 +1,93 @@
+/* ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** *****
+   ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** *****
+
+    trimAl v1.5.0: a tool for automated alignment trimming in large-scale
+                 phylogenetics analyses.
+
+    readAl v1.5.0: a tool for automated alignment conversion among different
+                 formats.
+
+    2009-2020
+        Fernandez-Rodriguez V.  (victor.fernandez@bsc.es)
+        Capella-Gutierrez S.    (salvador.capella@bsc.es)
+        Gabaldon, T.            (tgabaldon@bsc.es)
+
+    This file is part of trimAl/readAl.
+
+    trimAl/readAl are free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, the last available version.
+
+    trimAl/readAl are distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with trimAl/readAl. If not, see <http://www.gnu.org/licenses/>.
+
+***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** *****
+***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** */
+
+#ifndef PAIRWISEOVERLAPS_H
+#define PAIRWISEOVERLAPS_H
+
+/** \brief Class containing the overlap scores between every pair of
+ * sequences in an alignment.
+ *
+ * The overlap between two sequences is the ratio of residues shared by both
+ * divided by the residues of the one taken as reference, so the scores matrix
+ * is not symmetric. The shared residues are, though, and only the upper
+ * triangle of their matrix is stored, row by row, along with the residues of
+ * every sequence. Shared residues are stored in 16 bits when the alignment is
+ * short enough for them to fit.
+ */
+
+class pairwiseOverlaps {
+
+  int elements;
+
+  /* Residues, neither gaps nor indeterminations, of every sequence */
+  int *residues;
+
+  /* Upper triangle of the shared residues matrix, without its diagonal. Only
+   * one of them is used depending on the alignment length */
+  unsigned short *shortShared;
+  int *shared;
+
+  public:
+
+  /** \brief Constructor.
+   * \param sequences Number of sequences.
+   * \param length Alignment length, i.e. the maximum number of residues.
+   */
+  pairwiseOverlaps(int sequences, int length);
+
+  /** \brief Destructor.
+   *
+   * Destruction method that frees previously allocated memory.
+   */
+  ~pairwiseOverlaps(void);
+
+  /** \brief Sequence residues setting method.
+   * \param sequence Sequence index.
+   * \param count Residues of the sequence.
+   */
+  void setResidues(int sequence, int count);
+
+  /** \brief Shared residues setting method.
+   * \param seqA First sequence index.
+   * \param seqB Second, and different, sequence index.
+   * \param count Residues shared by both sequences.
+   */
+  void setShared(int seqA, int seqB, int count);
+
+  /** \brief Overlap score getting method.
+   * \param reference Sequence taken as reference.
+   * \param sequence Sequence compared with the reference.
+   * \return Ratio of the reference residues shared with the other sequence.
+   */
+  float getOverlap(int reference, int sequence);
+};
+
+#endif
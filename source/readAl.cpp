@@ -26,13 +26,51 @@
 ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** *****
 ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** */
 
+#include <fstream>
 #include <stdlib.h>
 #include <string.h>
+#include <pthread.h>
+
+#ifndef _WIN32
+#include <glob.h>
+#endif
+
+#include <algorithm>
+#include <vector>
 
 #include "alignment.h"
+#include "compressedBuffer.h"
+#include "threadPool.h"
 #include "defines.h"
 #include "utils.h"
 
+/* Output formats available in bulk mode. Each one is written to a file named
+ * after the input alignment with the option name as its extension */
+static const struct {
+  const char *option;
+  int format;
+  bool shortNames;
+} outputFormats[] = {
+  {"-clustal", 1, false}, {"-fasta", 8, false}, {"-fasta_m10", 8, true},
+  {"-nbrf", 3, false}, {"-nexus", 17, false}, {"-mega", 21, false},
+  {"-phylip3.2", 11, false}, {"-phylip3.2_m10", 11, true},
+  {"-phylip", 12, false}, {"-phylip_m10", 12, true},
+  {"-phylip_paml", 13, false}, {"-phylip_paml_m10", 13, true},
+  {"-html", 100, false}, {"-onlyseqs", 99, false}, {NULL, 0, false}
+};
+
+/* Data shared by all the alignments converted in bulk mode. Every alignment
+ * is read once and then written in all the requested formats */
+struct readalBatch {
+  pthread_mutex_t lock;
+  vector<string> inputs, outputs;
+  vector<int> formats;
+  bool reverse;
+  int failed;
+};
+
+static int convertBatch(int argc, char *argv[]);
+
 void menu(void);
 
 int main(int argc, char *argv[]) {
@@ -67,8 +105,14 @@ int main(int argc, char *argv[]) {
     return 0;
   }
 
+  /* Convert several alignments at once in bulk mode */
+  for(i = 1; i < argc; i++)
+    if((!strcmp(argv[i], "-batch")) || (!strcmp(argv[i], "-batchglob")))
+      return convertBatch(argc, argv);
+
   /* Catch different input options and then check whether there is a valid
    * combination of parameters */
+  i = 1;
   while(i < argc) {
 
     /* Input alignment option: -in */
@@ -315,6 +359,203 @@ int main(int argc, char *argv[]) {
   return (errors == true ? -1 : 0);
 }
 
+/* Read one of the alignments from a batch and write it in every requested
+ * format, reporting it when it fails */
+static void convertBatchEntry(void *data, int entry) {
+
+  readalBatch *batch = (readalBatch *) data;
+  string outfile;
+  alignment inAlig;
+  bool loaded, errors = false;
+  int i;
+
+  loaded = inAlig.loadAlignment((char *) batch -> inputs[entry].c_str());
+  if(!loaded)
+    errors = true;
+
+  if(batch -> reverse)
+    inAlig.setReverse();
+
+  /* Unaligned sequences can still be written in the formats which admit them
+   * even when any other format fails */
+  for(i = 0; (i < (int) batch -> formats.size()) && (loaded); i++) {
+    inAlig.setOutputFormat(outputFormats[batch -> formats[i]].format,
+      outputFormats[batch -> formats[i]].shortNames);
+
+    outfile = batch -> outputs[entry] + "." + (outputFormats[batch -> formats[i]].option + 1);
+    if(!inAlig.saveAlignment((char *) outfile.c_str()))
+      errors = true;
+  }
+
+  if(errors) {
+    pthread_mutex_lock(&batch -> lock);
+    batch -> failed++;
+    cerr << endl << "ERROR: Alignment \"" << batch -> inputs[entry]
+      << "\" has not been converted." << endl << endl;
+    pthread_mutex_unlock(&batch -> lock);
+  }
+}
+
+/* Convert every alignment from a batch file, or matching a pattern, into the
+ * requested formats. Alignments are shared among -threads threads */
+static int convertBatch(int argc, char *argv[]) {
+
+  char *batchFile = NULL, *pattern = NULL, *outDir = NULL;
+  bool errors = false, chosen[sizeof(outputFormats) / sizeof(outputFormats[0])];
+  int i, j, threads = -1;
+  size_t first, last;
+  string nline, name;
+  readalBatch batch;
+  ifstream manifest;
+
+  batch.reverse = false;
+  for(j = 0; outputFormats[j].option != NULL; j++)
+    chosen[j] = false;
+
+  /* Catch the batch options and the output formats, which can be chosen
+   * together in this mode */
+  for(i = 1; (i < argc) && (!errors); i++) {
+    if(!strcmp(argv[i], "-batch") && (i+1 != argc) && (batchFile == NULL))
+      batchFile = argv[++i];
+
+    else if(!strcmp(argv[i], "-batchglob") && (i+1 != argc) && (pattern == NULL))
+      pattern = argv[++i];
+
+    else if(!strcmp(argv[i], "-batchoutdir") && (i+1 != argc) && (outDir == NULL))
+      outDir = argv[++i];
+
+    else if(!strcmp(argv[i], "-threads") && (i+1 != argc) && (threads == -1)) {
+      if(utils::isNumber(argv[i+1]) && (atoi(argv[i+1]) > 0))
+        threads = atoi(argv[++i]);
+      else {
+        cerr << endl << "ERROR: The threads number should be a positive "
+          << "integer number." << endl << endl;
+        errors = true;
+      }
+    }
+
+    else if(!strcmp(argv[i], "-reverse") && (!batch.reverse))
+      batch.reverse = true;
+
+    else {
+      for(j = 0; outputFormats[j].option != NULL; j++)
+        if(!strcmp(argv[i], outputFormats[j].option))
+          break;
+
+      if((outputFormats[j].option != NULL) && (!chosen[j])) {
+        chosen[j] = true;
+        batch.formats.push_back(j);
+      }
+      else {
+        cerr << endl << "ERROR: Parameter \"" << argv[i] << "\" not valid "
+          << "in bulk mode." << endl << endl;
+        errors = true;
+      }
+    }
+  }
+
+  /* Final verifications to detect any possible mistake in the input options */
+  if((batchFile != NULL) && (pattern != NULL) && (!errors)) {
+    cerr << endl << "ERROR: Choose either a batch file or a pattern to look "
+      << "for the alignments." << endl << endl;
+    errors = true;
+  }
+
+  if((outDir == NULL) && (!errors)) {
+    cerr << endl << "ERROR: An output directory has to be defined in bulk "
+      << "mode." << endl << endl;
+    errors = true;
+  }
+
+  if((batch.formats.size() == 0) && (!errors)) {
+    cerr << endl << "ERROR: At least one output format has to be chosen."
+      << endl << endl;
+    errors = true;
+  }
+
+  /* Each line from the batch file has an input alignment. Empty lines and
+   * lines starting by '#' are skipped */
+  if((batchFile != NULL) && (!errors)) {
+    manifest.open(batchFile, ifstream::in);
+    if(!manifest) {
+      cerr << endl << "ERROR: Check the batch file \"" << batchFile << "\"."
+        << endl << endl;
+      errors = true;
+    }
+
+    while((!errors) && (getline(manifest, nline))) {
+      first = nline.find_first_not_of(" \t\r");
+      if((first == string::npos) || (nline[first] == '#'))
+        continue;
+      last = nline.find_last_not_of(" \t\r");
+      batch.inputs.push_back(nline.substr(first, last - first + 1));
+    }
+    manifest.close();
+  }
+
+  if((pattern != NULL) && (!errors)) {
+#ifndef _WIN32
+    glob_t matches;
+
+    if(glob(pattern, 0, NULL, &matches) == 0)
+      for(i = 0; i < (int) matches.gl_pathc; i++)
+        batch.inputs.push_back(matches.gl_pathv[i]);
+    globfree(&matches);
+#else
+    cerr << endl << "ERROR: Patterns are not available in this platform. Use "
+      << "a batch file instead." << endl << endl;
+    errors = true;
+#endif
+  }
+
+  if((batch.inputs.size() == 0) && (!errors)) {
+    cerr << endl << "ERROR: There are not alignments to convert in bulk mode."
+      << endl << endl;
+    errors = true;
+  }
+
+  if(errors)
+    return -1;
+
+  /* Output files keep the input alignment name, without its compression
+   * extension, in the output directory. Two alignments with the same name
+   * would overwrite each other */
+  for(i = 0; i < (int) batch.inputs.size(); i++) {
+    name = batch.inputs[i].substr(batch.inputs[i].find_last_of('/') + 1);
+    if(compressedBuffer::compressionByName((char *) name.c_str()) != NOCOMPRESSION)
+      name = name.substr(0, name.find_last_of('.'));
+    batch.outputs.push_back(string(outDir) + "/" + name);
+  }
+
+  vector<string> names(batch.outputs);
+  sort(names.begin(), names.end());
+  for(i = 1; (i < (int) names.size()) && (!errors); i++)
+    if(names[i] == names[i - 1]) {
+      cerr << endl << "ERROR: Several alignments would be written to \""
+        << names[i] << "\"." << endl << endl;
+      errors = true;
+    }
+
+  if(errors)
+    return -1;
+
+  /* Convert the alignments sharing them among threads */
+  pthread_mutex_init(&batch.lock, NULL);
+  batch.failed = 0;
+
+  threadPool::computeItems((int) batch.inputs.size(), threads,
+    convertBatchEntry, &batch);
+
+  pthread_mutex_destroy(&batch.lock);
+
+  if(batch.failed != 0) {
+    cerr << "ERROR: " << batch.failed << " of " << batch.inputs.size()
+      << " alignments have not been converted." << endl << endl;
+    return -1;
+  }
+  return 0;
+}
+
 void menu(void) {
 
   cout << endl
@@ -336,8 +577,10 @@ void menu(void) {
     << "\t-h                   " << "Show this information." << endl
     << "\t--version            " << "Show readAl version." << endl << endl
 
-    << "\t-in <inputfile>      " << "Input file in several formats." << endl
-    << "\t-out <outputfile>    " << "Output file name (default STDOUT)." << endl
+    << "\t-in <inputfile>      " << "Input file in several formats. It can be "
+    << "gzip or zstd compressed. Use '-' for STDIN." << endl
+    << "\t-out <outputfile>    " << "Output file name (default STDOUT). It is "
+    << "compressed when it ends with '.gz' or '.zst'." << endl
     << endl
 
     << "\t-format              " << "Print information about input file format "
@@ -381,5 +624,20 @@ void menu(void) {
     << "with PAML. Sequences name up to 10 characters." << endl
     << "\t-phylip3.2           " << "Output file in PHYLIP3.2 format" << endl
     << "\t-phylip3.2_m10       " << "Output file in PHYLIP3.2 format. Sequences"
-    << " name up to 10 characters." << endl << endl;
+    << " name up to 10 characters." << endl << endl
+
+    << "Bulk mode" << endl
+    << "\treadal -batch <file> -batchoutdir <directory> [formats] [-reverse] "
+    << "[-threads <n>]." << endl << endl
+
+    << "\t-batch <file>        " << "File with an input alignment per line. "
+    << "Lines starting by '#' are skipped." << endl
+    << "\t-batchglob <pattern> " << "Convert the alignments matching the "
+    << "pattern, e.g. 'families/*.fa', instead." << endl
+    << "\t-batchoutdir <dir>   " << "Output directory. Each alignment is "
+    << "written once per chosen format, named" << endl
+    << "\t                     " << "after the input file with the format as "
+    << "extension, e.g. 'family.fa.phylip'." << endl
+    << "\t-threads <n>         " << "Number of alignments converted at the "
+    << "same time (default 1)." << endl << endl;
 }
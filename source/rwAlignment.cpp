@@ -38,6 +38,12 @@ extern int errno;
 #include <ctype.h>
 #include <string>
 
+/* The Windows C library names the reentrant strtok after its bounds-checked
+ * interface */
+#ifdef _WIN32
+#define strtok_r strtok_s
+#endif
+
 using namespace std;
 
 bool alignment::fillMatrices(bool aligned) {
@@ -141,22 +147,45 @@ void alignment::getSequences(ostream &file) {
   delete [] tmpMatrix;
 }
 
-int alignment::formatInputAlignment(char *alignmentFile) {
+void alignment::growSequences(int newSize) {
+  /* Resize sequences, names and headers storage keeping the sequences loaded
+   * so far. Strings are swapped to avoid copying their content */
+
+  string *newSequences, *newNames, *newInfo;
+  int i;
+
+  newSequences = new string[newSize];
+  newNames = new string[newSize];
+  newInfo = new string[newSize];
+
+  for(i = 0; i < sequenNumber; i++) {
+    newSequences[i].swap(sequences[i]);
+    newNames[i].swap(seqsName[i]);
+    newInfo[i].swap(seqsInfo[i]);
+  }
+
+  if(sequences != NULL)
+    delete [] sequences;
+  if(seqsName != NULL)
+    delete [] seqsName;
+  if(seqsInfo != NULL)
+    delete [] seqsInfo;
+
+  sequences = newSequences;
+  seqsName = newNames;
+  seqsInfo = newInfo;
+}
+
+int alignment::formatInputAlignment(lineReader &file) {
   /* Guess input alignment format */
 
-  char c, *firstWord = NULL, *line = NULL;
+  char c, *firstWord = NULL, *line = NULL, *tokens = NULL;
   int format = 0, blocks = 0;
-  ifstream file;
   string nline;
 
-  /* Check the file and its content */
-  file.open(alignmentFile, ifstream::in);
-  if(!utils::checkFile(file))
-    return false;
-
   /* Read first valid line in a safer way */
   do {
-    line = utils::readLine(file);
+    line = file.readLine();
   } while ((line == NULL) && (!file.eof()));
 
   /* If the file end is reached without a valid line, warn about it */
@@ -164,7 +193,7 @@ int alignment::formatInputAlignment(char *alignmentFile) {
     return false;
 
   /* Otherwise, split line */
-  firstWord = strtok(line, OTHDELIMITERS);
+  firstWord = strtok_r(line, OTHDELIMITERS, &tokens);
 
   /* Clustal Format */
   if((!strcmp(firstWord, "CLUSTAL")) || (!strcmp(firstWord, "clustal")))
@@ -190,13 +219,13 @@ int alignment::formatInputAlignment(char *alignmentFile) {
      * the input file. */
     blocks = 0;
     do {
-      file.read(&c, 1);
+      file.readChar(&c);
     } while((c != '#') && (!file.eof()));
 
     do {
       while((c != '\n') && (!file.eof()))
-        file.read(&c, 1);
-      file.read(&c, 1);
+        file.readChar(&c);
+      file.readChar(&c);
       if(c == '#')
         blocks++;
     } while((c != '\n') && (!file.eof()));
@@ -211,7 +240,7 @@ int alignment::formatInputAlignment(char *alignmentFile) {
 
     /* Get number of sequences and residues */
     sequenNumber = atoi(firstWord);
-    firstWord = strtok(NULL, DELIMITERS);
+    firstWord = strtok_r(NULL, DELIMITERS, &tokens);
     if(firstWord != NULL)
       residNumber = atoi(firstWord);
 
@@ -227,32 +256,28 @@ int alignment::formatInputAlignment(char *alignmentFile) {
 
       /* Read line in a safer way */
       do {
-        if (line != NULL)
-          delete [] line;
-        line = utils::readLine(file);
+        line = file.readLine();
       } while ((line == NULL) && (!file.eof()));
 
       /* If the file end is reached without a valid line, warn about it */
       if (file.eof())
         return false;
 
-      firstWord = strtok(line, DELIMITERS);
+      firstWord = strtok_r(line, DELIMITERS, &tokens);
       while(firstWord != NULL) {
         blocks++;
-        firstWord = strtok(NULL, DELIMITERS);
+        firstWord = strtok_r(NULL, DELIMITERS, &tokens);
       }
 
       /* Read line in a safer way */
       do {
-        if (line != NULL)
-          delete [] line;
-        line = utils::readLine(file);
+        line = file.readLine();
       } while ((line == NULL) && (!file.eof()));
 
-      firstWord = strtok(line, DELIMITERS);
+      firstWord = strtok_r(line, DELIMITERS, &tokens);
       while(firstWord != NULL) {
         blocks--;
-        firstWord = strtok(NULL, DELIMITERS);
+        firstWord = strtok_r(NULL, DELIMITERS, &tokens);
       }
 
       /* If the file end is reached without a valid line, warn about it */
@@ -264,27 +289,17 @@ int alignment::formatInputAlignment(char *alignmentFile) {
     }
   }
 
-  /* Close the input file and delete dinamic memory */
-  file.close();
-  if (line != NULL)
-    delete [] line;
-
   /* Return the input alignment format */
   return format;
 }
 
-bool alignment::loadPhylipAlignment(char *alignmentFile) {
+bool alignment::loadPhylipAlignment(lineReader &file, char *alignmentFile) {
   /* PHYLIP/PHYLIP 4 (Sequential) file format parser */
 
-  char *str, *line = NULL;
-  ifstream file;
+  char *str, *view, *line = NULL, *tokens = NULL;
+  long length, nameLength, start;
   int i;
 
-  /* Check the file and its content */
-  file.open(alignmentFile, ifstream::in);
-  if(!utils::checkFile(file))
-    return false;
-
   /* Store some data about filename for possible uses in other formats */
   filename.append("!Title ");
   filename.append(alignmentFile);
@@ -292,7 +307,7 @@ bool alignment::loadPhylipAlignment(char *alignmentFile) {
 
   /* Read first valid line in a safer way */
   do {
-    line = utils::readLine(file);
+    line = file.readLine();
   } while ((line == NULL) && (!file.eof()));
 
   /* If the file end is reached without a valid line, warn about it */
@@ -300,12 +315,12 @@ bool alignment::loadPhylipAlignment(char *alignmentFile) {
     return false;
 
   /* Read the input sequences and residues for each sequence numbers */
-  str = strtok(line, DELIMITERS);
+  str = strtok_r(line, DELIMITERS, &tokens);
   sequenNumber = 0;
   if(str != NULL)
     sequenNumber = atoi(str);
 
-  str = strtok(NULL, DELIMITERS);
+  str = strtok_r(NULL, DELIMITERS, &tokens);
   residNumber = 0;
   if(str != NULL)
     residNumber = atoi(str);
@@ -323,24 +338,41 @@ bool alignment::loadPhylipAlignment(char *alignmentFile) {
   i = 0;
   while((i < sequenNumber) && (!file.eof())){
 
-    /* Read lines in a safer way. Destroy previous stored information */
-    if (line != NULL)
-      delete [] line;
-    line = utils::readLine(file);
+    /* Memory-mapped files: a sequence name followed by a single fragment is
+     * taken straight from the mapped file */
+    if (file.isMapped()) {
+      view = file.readView(&length);
+      nameLength = lineReader::tokenLength(view, length, DELIMITERS);
+      for(start = nameLength; (start < length) &&
+        ((view[start] == ' ') || (view[start] == '\t')); start++) ;
+
+      if ((nameLength != 0) && (start < length) && (length - start ==
+          lineReader::tokenLength(view + start, length - start, DELIMITERS))) {
+        seqsName[i].append(view, nameLength);
+        sequences[i].append(view + start, length - start);
+        i++;
+        continue;
+      }
+      line = file.viewToLine(view, length);
+    }
+
+    /* Read lines in a safer way */
+    else
+      line = file.readLine();
 
     /* It the input line/s are blank lines, skip the loop iteration  */
     if(line == NULL)
       continue;
 
     /* First token: Sequence name */
-    str = strtok(line, DELIMITERS);
+    str = strtok_r(line, DELIMITERS, &tokens);
     seqsName[i].append(str, strlen(str));
 
     /* Trim the rest of the line from blank spaces, tabs, etc and store it */
-    str = strtok(NULL, DELIMITERS);
+    str = strtok_r(NULL, DELIMITERS, &tokens);
     while(str != NULL) {
       sequences[i].append(str, strlen(str));
-      str = strtok(NULL, DELIMITERS);
+      str = strtok_r(NULL, DELIMITERS, &tokens);
     }
     i++;
   }
@@ -351,46 +383,50 @@ bool alignment::loadPhylipAlignment(char *alignmentFile) {
     /* Try to get for each sequences its corresponding residues */
     i = 0;
     while((i < sequenNumber) && (!file.eof())) {
-      /* Read lines in a safer way. Destroy previous stored information */
-      if (line != NULL)
-        delete [] line;
 
-      line = utils::readLine(file);
+      /* Memory-mapped files: fragments without blank spaces are appended
+       * straight from the mapped file */
+      if (file.isMapped()) {
+        view = file.readView(&length);
+        if ((length != 0) &&
+            (lineReader::tokenLength(view, length, DELIMITERS) == length)) {
+          sequences[i].append(view, length);
+          i++;
+          continue;
+        }
+        line = file.viewToLine(view, length);
+      }
+
+      /* Read lines in a safer way */
+      else
+        line = file.readLine();
       /* It the input line/s are blank lines, skip the loop iteration  */
       if(line == NULL)
         continue;
 
       /* Remove from the current line non-printable characters and add fragments
        * to previous stored sequence */
-      str = strtok(line, DELIMITERS);
+      str = strtok_r(line, DELIMITERS, &tokens);
       while(str != NULL) {
         sequences[i].append(str, strlen(str));
-        str = strtok(NULL, DELIMITERS);
+        str = strtok_r(NULL, DELIMITERS, &tokens);
       }
       i++;
     }
   }
 
-  /* Close the input file and delete dinamic memory */
+  /* Close the input file */
   file.close();
-  if (line != NULL)
-    delete [] line;
 
   /* Check the matrix's content */
   return fillMatrices(true);
 }
 
-bool alignment::loadPhylip3_2Alignment(char *alignmentFile) {
+bool alignment::loadPhylip3_2Alignment(lineReader &file, char *alignmentFile) {
   /* PHYLIP 3.2 (Interleaved) file format parser */
 
   int i, blocksFirstLine, firstLine = true;
-  char *str, *line = NULL;
-  ifstream file;
-
-  /* Check the file and its content */
-  file.open(alignmentFile, ifstream::in);
-  if(!utils::checkFile(file))
-    return false;
+  char *str, *line = NULL, *tokens = NULL;
 
   /* Store the file name for futher format conversion*/
   filename.append("!Title ");
@@ -399,7 +435,7 @@ bool alignment::loadPhylip3_2Alignment(char *alignmentFile) {
 
   /* Read first valid line in a safer way */
   do {
-    line = utils::readLine(file);
+    line = file.readLine();
   } while ((line == NULL) && (!file.eof()));
 
   /* If the file end is reached without a valid line, warn about it */
@@ -408,12 +444,12 @@ bool alignment::loadPhylip3_2Alignment(char *alignmentFile) {
 
   /* Get the sequences and residues numbers. If there is any mistake,
    * return a FALSE value to warn about the possible error */
-  str = strtok(line, DELIMITERS);
+  str = strtok_r(line, DELIMITERS, &tokens);
   sequenNumber = 0;
   if(str != NULL)
     sequenNumber = atoi(str);
 
-  str = strtok(NULL, DELIMITERS);
+  str = strtok_r(NULL, DELIMITERS, &tokens);
   residNumber = 0;
   if(str != NULL)
     residNumber = atoi(str);
@@ -432,29 +468,26 @@ bool alignment::loadPhylip3_2Alignment(char *alignmentFile) {
   blocksFirstLine = 0;
 
   do {
-    /* Read lines in a safer way. Destroy previous stored information */
-    if (line != NULL)
-      delete [] line;
-
-    line = utils::readLine(file);
+    /* Read lines in a safer way */
+    line = file.readLine();
     /* If there is nothing in the input line, skip the loop instructions */
     if(line == NULL)
       continue;
 
-    str = strtok(line, DELIMITERS);
+    str = strtok_r(line, DELIMITERS, &tokens);
     /* First block: Sequence Name + Sequence fragment. Count how many blocks
      * the first sequence line is divided. It could help to identify the
      * different sequences from the input file */
     if(firstLine) {
       seqsName[i].append(str, strlen(str));
-      str = strtok(NULL, OTHDELIMITERS);
+      str = strtok_r(NULL, OTHDELIMITERS, &tokens);
       firstLine = 1;
     }
 
     /* Sequence fragment */
     while(str != NULL) {
       sequences[i].append(str, strlen(str));
-      str = strtok(NULL, OTHDELIMITERS);
+      str = strtok_r(NULL, OTHDELIMITERS, &tokens);
       /* Count the blocks number for the sequences first line */
       if (firstLine)
         firstLine += 1;
@@ -486,26 +519,18 @@ bool alignment::loadPhylip3_2Alignment(char *alignmentFile) {
     }
   } while(!file.eof());
 
-  /* Close the input file and delete dinamic memory */
+  /* Close the input file */
   file.close();
-  if (line != NULL)
-    delete [] line;
 
   /* Check the matrix's content */
   return fillMatrices(true);
 }
 
-bool alignment::loadClustalAlignment(char *alignmentFile) {
+bool alignment::loadClustalAlignment(lineReader &file, char *alignmentFile) {
   /* CLUSTAL file format parser */
 
   int i, seqLength, pos, firstBlock;
-  char *str, *line = NULL;
-  ifstream file;
-
-  /* Check input file and its content */
-  file.open(alignmentFile, ifstream::in);
-  if(!utils::checkFile(file))
-    return false;
+  char *str, *line = NULL, *tokens = NULL;
 
   /* Store some details about input file to be used in posterior format
    * conversions */
@@ -515,7 +540,7 @@ bool alignment::loadClustalAlignment(char *alignmentFile) {
 
   /* The first valid line corresponding to CLUSTAL label is ignored */
   do {
-    line = utils::readLine(file);
+    line = file.readLine();
   } while ((line == NULL) && (!file.eof()));
 
   /* If the file end is reached without a valid line, warn about it */
@@ -525,12 +550,8 @@ bool alignment::loadClustalAlignment(char *alignmentFile) {
   /* Ignore blank lines before first sequence block starts */
   while(!file.eof()) {
 
-    /* Deallocate previously used dynamic memory */
-    if (line != NULL)
-      delete [] line;
-
     /* Read lines in safe way */
-    line = utils::readLine(file);
+    line = file.readLine();
 
     if (line != NULL)
       break;
@@ -560,24 +581,19 @@ bool alignment::loadClustalAlignment(char *alignmentFile) {
       break;
     sequenNumber++;
 
-    /* Deallocate previously used dynamic memory */
-    if (line != NULL)
-      delete [] line;
-
     /* Read lines in safe way */
-    line = utils::readLine(file);
+    line = file.readLine();
   }
 
   /* Finish to preprocess the input file. */
-  file.clear();
-  file.seekg(0);
+  file.rewind();
 
   /* Allocate memory for the input alignmet */
   seqsName  = new string[sequenNumber];
   sequences = new string[sequenNumber];
 
   /* Read the title line and store it */
-  line = utils::readLine(file);
+  line = file.readLine();
   if (line == NULL)
     return false;
   aligInfo.append(line, strlen(line));
@@ -585,12 +601,8 @@ bool alignment::loadClustalAlignment(char *alignmentFile) {
   /* Ignore blank lines before first sequence block starts */
   while(!file.eof()) {
 
-    /* Deallocate previously used dynamic memory */
-    if (line != NULL)
-      delete [] line;
-
     /* Read lines in safe way */
-    line = utils::readLine(file);
+    line = file.readLine();
 
     if (line != NULL)
       break;
@@ -611,7 +623,7 @@ bool alignment::loadClustalAlignment(char *alignmentFile) {
       if (i == 0)
         firstBlock = false;
       /* Read current line and analyze it*/
-      line = utils::readLine(file);
+      line = file.readLine();
       continue;
     }
 
@@ -626,12 +638,8 @@ bool alignment::loadClustalAlignment(char *alignmentFile) {
     if (pos == seqLength) {
       firstBlock = false;
 
-      /* Deallocate dinamic memory if it has been used before */
-      if (line != NULL)
-        delete [] line;
-
       /* Read current line and analyze it*/
-      line = utils::readLine(file);
+      line = file.readLine();
 
       continue;
     }
@@ -639,11 +647,11 @@ bool alignment::loadClustalAlignment(char *alignmentFile) {
     /* If it is a standard line, split it into two parts. The first one contains
      * sequence name and the second one the residues. If the "firstBlock" flag
      * is active then store the sequence name */
-    str = strtok(line, OTHDELIMITERS);
+    str = strtok_r(line, OTHDELIMITERS, &tokens);
     if(str != NULL) {
       if(firstBlock)
         seqsName[i].append(str, strlen(str));
-      str = strtok(NULL, OTHDELIMITERS);
+      str = strtok_r(NULL, OTHDELIMITERS, &tokens);
       if(str != NULL)
         sequences[i].append(str, strlen(str));
 
@@ -651,135 +659,109 @@ bool alignment::loadClustalAlignment(char *alignmentFile) {
       i = (i + 1) % sequenNumber;
     }
 
-    /* Deallocate dinamic memory if it has been used before */
-    if (line != NULL)
-      delete [] line;
-
     /* Read current line and analyze it*/
-    line = utils::readLine(file);
+    line = file.readLine();
   }
 
   /* Close the input file */
   file.close();
 
-  /* Deallocate dinamic memory */
-  if (line != NULL)
-    delete [] line;
-
   /* Check the matrix's content */
   return fillMatrices(true);
 }
 
-bool alignment::loadFastaAlignment(char *alignmentFile) {
-  /* FASTA file format parser */
+bool alignment::loadFastaAlignment(lineReader &file, char *alignmentFile) {
+  /* FASTA file format parser. The input file is read only once: sequences
+   * storage grows as new sequences are found */
 
-  char *str, *line = NULL;
-  ifstream file;
-  int i;
-
-  /* Check the file and its content */
-  file.open(alignmentFile, ifstream::in);
-  if(!utils::checkFile(file))
-    return false;
+  char *str, *view, *line = NULL, *tokens = NULL;
+  int capacity;
+  long length;
 
   /* Store input file name for posterior uses in other formats */
   filename.append("!Title ");
   filename.append(alignmentFile);
   filename.append(";");
 
-  /* Compute how many sequences are in the input alignment */
+  /* Reserve memory for a first block of sequences */
+  capacity = SEQUENCESBLOCK;
   sequenNumber = 0;
+  growSequences(capacity);
+
   while(!file.eof()) {
 
-    /* Deallocate previously used dinamic memory */
-    if (line != NULL)
-      delete [] line;
+    /* Memory-mapped files: lines only made by residues are appended straight
+     * from the mapped file. Any other line is processed as usual */
+    if (file.isMapped()) {
+      view = file.readView(&length);
+      if ((sequenNumber != 0) && (length != 0) && (view[0] != '>') &&
+          (lineReader::tokenLength(view, length, OTHDELIMITERS) == length)) {
+        sequences[sequenNumber - 1].append(view, length);
+        continue;
+      }
+      line = file.viewToLine(view, length);
+    }
 
     /* Read lines in a safe way */
-    line = utils::readLine(file);
+    else
+      line = file.readLine();
     if (line == NULL)
       continue;
 
-    /* It the line starts by ">" means that a new sequence has been found */
-    str = strtok(line, DELIMITERS);
-    if (str == NULL)
-      continue;
-
-    /* If a sequence name flag is detected, increase sequences counter */
-    if(str[0] == '>')
-      sequenNumber++;
-  }
-
-  /* Finish to preprocess the input file. */
-  file.clear();
-  file.seekg(0);
-
-  /* Allocate memory for the input alignmet */
-  seqsName  = new string[sequenNumber];
-  sequences = new string[sequenNumber];
-  seqsInfo  = new string[sequenNumber];
-
-  for(i = -1; (i < sequenNumber) && (!file.eof()); ) {
-
-    /* Deallocate previously used dinamic memory */
-    if (line != NULL)
-      delete [] line;
-
-    /* Read lines in a safe way */
-    line = utils::readLine(file);
-    if (line == NULL)
-      continue;
+    /* Make room for a new sequence if the current storage is full */
+    if ((line[0] == '>') && (sequenNumber == capacity)) {
+      capacity *= 2;
+      growSequences(capacity);
+    }
 
     /* Store original header fom input sequences including non-standard
      * characters */
     if (line[0] == '>')
-      seqsInfo[i+1].append(&line[1], strlen(line) - 1);
+      seqsInfo[sequenNumber].append(&line[1], strlen(line) - 1);
 
     /* Cut the current line and check whether there are valid characters */
-    str = strtok(line, OTHDELIMITERS);
+    str = strtok_r(line, OTHDELIMITERS, &tokens);
     if (str == NULL)
       continue;
 
     /* Check whether current line belongs to the current sequence
      * or it is a new one. In that case, store the sequence name */
     if(str[0] == '>') {
+      if (sequenNumber == capacity) {
+        capacity *= 2;
+        growSequences(capacity);
+      }
       /* Move sequence name pointer until a valid string name is obtained */
       do {
         str = str + 1;
       } while(strlen(str) == 0);
-      seqsName[++i].append(str, strlen(str));
+      seqsName[sequenNumber++].append(str, strlen(str));
       continue;
     }
 
+    /* Skip any residue found before the first sequence name */
+    if (sequenNumber == 0)
+      continue;
+
     /* Sequence */
     while(str != NULL) {
-      sequences[i].append(str, strlen(str));
-      str = strtok(NULL, DELIMITERS);
+      sequences[sequenNumber - 1].append(str, strlen(str));
+      str = strtok_r(NULL, DELIMITERS, &tokens);
     }
   }
 
   /* Close the input file */
   file.close();
 
-  /* Deallocate previously used dinamic memory */
-  if (line != NULL)
-    delete [] line;
-
   /* Check the matrix's content */
   return fillMatrices(false);
 }
 
-bool alignment::loadNexusAlignment(char *alignmentFile) {
+bool alignment::loadNexusAlignment(lineReader &file, char *alignmentFile) {
 
   /* NEXUS file format parser */
-  char *frag = NULL, *str = NULL, *line = NULL;
+  char *frag = NULL, *str = NULL, *line = NULL, *tokens = NULL;
   int i, pos, state, firstBlock;
-  ifstream file;
-
-  /* Check the file and its content */
-  file.open(alignmentFile, ifstream::in);
-  if(!utils::checkFile(file))
-    return false;
 
   /* Store input file name for posterior uses in other formats */
   /* We store the file name */
@@ -790,17 +772,13 @@ bool alignment::loadNexusAlignment(char *alignmentFile) {
   state = false;
   do {
 
-    /* Destroy previous assigned memory */
-    if (line != NULL)
-      delete [] line;
-
     /* Read line in a safer way */
-    line = utils::readLine(file);
+    line = file.readLine();
     if (line == NULL)
       continue;
 
     /* Discard line where there is not information */
-    str = strtok(line, DELIMITERS);
+    str = strtok_r(line, DELIMITERS, &tokens);
     if(str == NULL)
       continue;
 
@@ -818,22 +796,22 @@ bool alignment::loadNexusAlignment(char *alignmentFile) {
 
     /* Store information about input format file */
     else if(!strcmp(str, "FORMAT")) {
-      str = strtok(NULL, DELIMITERS);
+      str = strtok_r(NULL, DELIMITERS, &tokens);
       while(str != NULL) {
         aligInfo.append(str, strlen(str));
         aligInfo.append(" ", strlen(" "));
-        str = strtok(NULL, DELIMITERS);
+        str = strtok_r(NULL, DELIMITERS, &tokens);
       }
     }
 
     /* In this case, try to get matrix dimensions */
     else if((!strcmp(str, "DIMENSIONS")) && state) {
-      str = strtok(NULL, DELIMITERS);
-      frag = strtok(NULL, DELIMITERS);
-      str = strtok(str, "=;");
-      sequenNumber = atoi(strtok(NULL, "=;"));
-      frag = strtok(frag, "=;");
-      residNumber = atoi(strtok(NULL, "=;"));
+      str = strtok_r(NULL, DELIMITERS, &tokens);
+      frag = strtok_r(NULL, DELIMITERS, &tokens);
+      str = strtok_r(str, "=;", &tokens);
+      sequenNumber = atoi(strtok_r(NULL, "=;", &tokens));
+      frag = strtok_r(frag, "=;", &tokens);
+      residNumber = atoi(strtok_r(NULL, "=;", &tokens));
     }
   } while(!file.eof());
 
@@ -850,12 +828,8 @@ bool alignment::loadNexusAlignment(char *alignmentFile) {
   firstBlock = true;
 
   while(!file.eof()) {
-    /* Destroy previous assigned memory */
-    if (line != NULL)
-      delete [] line;
-
     /* Read line in a safer way */
-    line = utils::readLine(file);
+    line = file.readLine();
     if (line == NULL)
       continue;
 
@@ -878,7 +852,7 @@ bool alignment::loadNexusAlignment(char *alignmentFile) {
       break;
 
     /* Split input line and check it if it is valid */
-    str = strtok(line, OTH2DELIMITERS);
+    str = strtok_r(line, OTH2DELIMITERS, &tokens);
     if (str == NULL)
       continue;
 
@@ -887,10 +861,10 @@ bool alignment::loadNexusAlignment(char *alignmentFile) {
       seqsName[pos].append(str, strlen(str));
 
     /* Store rest of line as part of sequence */
-    str = strtok(NULL, OTH2DELIMITERS);
+    str = strtok_r(NULL, OTH2DELIMITERS, &tokens);
     while(str != NULL) {
       sequences[pos].append(str, strlen(str));
-      str = strtok(NULL, OTH2DELIMITERS);
+      str = strtok_r(NULL, OTH2DELIMITERS, &tokens);
     }
 
     /* Move sequences pointer to next one. It if it is last one, move it to
@@ -901,10 +875,6 @@ bool alignment::loadNexusAlignment(char *alignmentFile) {
       firstBlock = false;
   }
 
-  /* Deallocate memory */
-  if (line != NULL)
-    delete [] line;
-
   /* Close the input file */
   file.close();
 
@@ -912,18 +882,12 @@ bool alignment::loadNexusAlignment(char *alignmentFile) {
   return fillMatrices(true);
 }
 
-bool alignment::loadMegaNonInterleavedAlignment(char *alignmentFile) {
+bool alignment::loadMegaNonInterleavedAlignment(lineReader &file, char *alignmentFile) {
   /* MEGA sequential file format parser */
 
-  char *frag = NULL, *str = NULL, *line = NULL;
-  ifstream file;
+  char *frag = NULL, *str = NULL, *line = NULL, *tokens = NULL;
   int i;
 
-  /* Check the file and its content */
-  file.open(alignmentFile, ifstream::in);
-  if(!utils::checkFile(file))
-    return false;
-
   /* Filename is stored as a title for MEGA input alignment.
    * If it is detected later a label "TITLE" in input file, this information
    * will be replaced for that one */
@@ -933,7 +897,7 @@ bool alignment::loadMegaNonInterleavedAlignment(char *alignmentFile) {
 
   /* Skip first valid line */
   do {
-    line = utils::readLine(file);
+    line = file.readLine();
   } while ((line == NULL) && (!file.eof()));
 
   /* If the file end is reached without a valid line, warn about it */
@@ -943,12 +907,8 @@ bool alignment::loadMegaNonInterleavedAlignment(char *alignmentFile) {
   /* Try to get input alignment information */
   while(!file.eof()) {
 
-    /* Destroy previously allocated memory */
-    if (line != NULL)
-      delete [] line;
-
     /* Read a new line in a safe way */
-    line = utils::readLine(file);
+    line = file.readLine();
     if (line == NULL)
       continue;
 
@@ -966,7 +926,7 @@ bool alignment::loadMegaNonInterleavedAlignment(char *alignmentFile) {
 
     /* Split input line copy into pieces and analize it
      * looking for specific labels */
-    str = strtok(frag, "!: ");
+    str = strtok_r(frag, "!: ", &tokens);
     for(i = 0; i < (int) strlen(str); i++)
       str[i] = toupper(str[i]);
 
@@ -993,7 +953,7 @@ bool alignment::loadMegaNonInterleavedAlignment(char *alignmentFile) {
 
     /* Check whether input line is valid or not */
     if (line == NULL) {
-      line = utils::readLine(file);
+      line = file.readLine();
       continue;
     }
 
@@ -1001,35 +961,26 @@ bool alignment::loadMegaNonInterleavedAlignment(char *alignmentFile) {
     if (!strncmp(line, "#", 1))
       sequenNumber++;
 
-    /* Destroy previously allocated memory */
-    if (line != NULL)
-      delete [] line;
-
     /* Read a new line in a safe way */
-    line = utils::readLine(file);
+    line = file.readLine();
 
   } while(!file.eof());
 
   /* Move file pointer to the beginner */
-  file.clear();
-  file.seekg(0);
+  file.rewind();
 
   /* Allocate memory */
   seqsName  = new string[sequenNumber];
   sequences = new string[sequenNumber];
 
   /* Skip first line */
-  line = utils::readLine(file);
+  line = file.readLine();
 
   /* Skip lines until first sequence name is found */
   while(!file.eof()) {
 
-    /* Destroy previously allocated memory */
-    if (line != NULL)
-      delete [] line;
-
     /* Read a new line in a safe way */
-    line = utils::readLine(file);
+    line = file.readLine();
     if (line == NULL)
       continue;
 
@@ -1048,15 +999,14 @@ bool alignment::loadMegaNonInterleavedAlignment(char *alignmentFile) {
 
     /* Skip blank lines */
     if (line == NULL) {
-      line = utils::readLine(file);
+      line = file.readLine();
       continue;
     }
 
     /* Skip lines with comments */
     if (!strncmp(line, "!", 1)) {
-      /* Deallocate memory and read a new line */
-      delete [] line;
-      line = utils::readLine(file);
+      /* Read a new line */
+      line = file.readLine();
       continue;
     }
 
@@ -1065,63 +1015,46 @@ bool alignment::loadMegaNonInterleavedAlignment(char *alignmentFile) {
 
     /* Skip lines with only comments */
     if (frag == NULL) {
-
-      /* Deallocate memory and read a new line */
-      if (line != NULL)
-        delete [] line;
-      line = utils::readLine(file);
+      line = file.readLine();
       continue;
     }
 
     /* Otherwise, split it into fragments */
-    str = strtok(frag, " #\n");
+    str = strtok_r(frag, " #\n", &tokens);
 
     /* Sequence Name */
     if (!strncmp(line, "#", 1)) {
       i += 1;
       seqsName[i].append(str, strlen(str));
-      str = strtok(NULL, " #\n");
+      str = strtok_r(NULL, " #\n", &tokens);
     }
 
     /* Sequence itself */
     while(str != NULL) {
       sequences[i].append(str, strlen(str));
-      str = strtok(NULL, " \n");
+      str = strtok_r(NULL, " \n", &tokens);
     }
 
     /* Deallocate dynamic memory */
     if (frag != NULL)
       delete [] frag;
 
-    if (line != NULL)
-      delete [] line;
-
     /* Read a new line in a safe way */
-    line = utils::readLine(file);
+    line = file.readLine();
   }
 
   /* Close input file */
   file.close();
 
-  /* Deallocate dynamic memory */
-  if (line != NULL)
-    delete [] line;
-
   /* Check the matrix's content */
   return fillMatrices(true);
 }
 
-bool alignment::loadMegaInterleavedAlignment(char *alignmentFile) {
+bool alignment::loadMegaInterleavedAlignment(lineReader &file, char *alignmentFile) {
   /* MEGA interleaved file format parser */
 
-  char *frag = NULL, *str = NULL, *line = NULL;
+  char *frag = NULL, *str = NULL, *line = NULL, *tokens = NULL;
   int i, firstBlock = true;
-  ifstream file;
-
-  /* Check the file and its content */
-  file.open(alignmentFile, ifstream::in);
-  if(!utils::checkFile(file))
-    return false;
 
   /* Filename is stored as a title for MEGA input alignment.
    * If it is detected later a label "TITLE" in input file, this information
@@ -1132,7 +1065,7 @@ bool alignment::loadMegaInterleavedAlignment(char *alignmentFile) {
 
   /* Skip first valid line */
   do {
-    line = utils::readLine(file);
+    line = file.readLine();
   } while ((line == NULL) && (!file.eof()));
 
   /* If the file end is reached without a valid line, warn about it */
@@ -1142,12 +1075,8 @@ bool alignment::loadMegaInterleavedAlignment(char *alignmentFile) {
   /* Try to get input alignment information */
   while(!file.eof()) {
 
-    /* Destroy previously allocated memory */
-    if (line != NULL)
-      delete [] line;
-
     /* Read a new line in a safe way */
-    line = utils::readLine(file);
+    line = file.readLine();
     if (line == NULL)
       continue;
 
@@ -1161,7 +1090,7 @@ bool alignment::loadMegaInterleavedAlignment(char *alignmentFile) {
 
     /* Split input line copy into pieces and analize it
      * looking for specific labels */
-    str = strtok(frag, "!: ");
+    str = strtok_r(frag, "!: ", &tokens);
     for(i = 0; i < (int) strlen(str); i++)
       str[i] = toupper(str[i]);
 
@@ -1190,12 +1119,8 @@ bool alignment::loadMegaInterleavedAlignment(char *alignmentFile) {
     if(!strncmp(line, "#", 1))
       sequenNumber++;
 
-    /* Deallocate dynamic memory */
-    if(line != NULL)
-      delete [] line;
-
     /* Read lines in a safe way */
-    line = utils::readLine(file);
+    line = file.readLine();
 
     /* If a blank line is detected means first block of sequences is over */
     /* Then, break counting sequences loop */
@@ -1204,25 +1129,20 @@ bool alignment::loadMegaInterleavedAlignment(char *alignmentFile) {
   }
 
   /* Finish to preprocess the input file. */
-  file.clear();
-  file.seekg(0);
+  file.rewind();
 
   /* Allocate memory */
   seqsName  = new string[sequenNumber];
   sequences = new string[sequenNumber];
 
   /* Skip first line */
-  line = utils::readLine(file);
+  line = file.readLine();
 
   /* Skip lines until first # flag is reached */
   while(!file.eof()) {
 
-    /* Deallocate previously used dynamic memory */
-    if (line != NULL)
-      delete [] line;
-
     /* Read line in a safer way */
-    line = utils::readLine(file);
+    line = file.readLine();
 
     /* Determine whether a # flag has been found in current string */
     if (line != NULL)
@@ -1238,20 +1158,19 @@ bool alignment::loadMegaInterleavedAlignment(char *alignmentFile) {
 
     if (line == NULL) {
     /* Read line in a safer way */
-    line = utils::readLine(file);
+    line = file.readLine();
     continue;
     }
 
     if (!strncmp(line, "!", 1)) {
-      /* Deallocate memory and read a new line */
-      delete [] line;
-      line = utils::readLine(file);
+      /* Read a new line */
+      line = file.readLine();
       continue;
     }
 
     /* Trim lines from any kind of comments and split it */
     frag = utils::trimLine(line);
-    str = strtok(frag, " #\n");
+    str = strtok_r(frag, " #\n", &tokens);
 
     /* Check whether a line fragment is valid or not */
     if (str == NULL)
@@ -1262,21 +1181,18 @@ bool alignment::loadMegaInterleavedAlignment(char *alignmentFile) {
       seqsName[i].append(str, strlen(str));
 
     /* Store sequence */
-    str = strtok(NULL, " \n");
+    str = strtok_r(NULL, " \n", &tokens);
     while(str != NULL) {
       sequences[i].append(str, strlen(str));
-      str = strtok(NULL, " \n");
+      str = strtok_r(NULL, " \n", &tokens);
     }
 
     /* Deallocate previously used dynamic memory */
     if (frag != NULL)
       delete [] frag;
 
-    if (line != NULL)
-      delete [] line;
-
     /* Read line in a safer way */
-    line = utils::readLine(file);
+    line = file.readLine();
 
     i = (i + 1) % sequenNumber;
     if (i == 0)
@@ -1286,27 +1202,17 @@ bool alignment::loadMegaInterleavedAlignment(char *alignmentFile) {
   /* Close input file */
   file.close();
 
-  /* Deallocate local memory */
-  if (line != NULL)
-    delete [] line;
-
   /* Check the matrix's content */
   return fillMatrices(true);
 }
 
-bool alignment::loadNBRF_PirAlignment(char *alignmentFile) {
+bool alignment::loadNBRF_PirAlignment(lineReader &file, char *alignmentFile) {
   /* NBRF/PIR file format parser */
 
   bool seqIdLine, seqLines;
-  char *str, *line = NULL; 
-  ifstream file;
+  char *str, *line = NULL, *tokens = NULL;
   int i;
 
-  /* Check the file and its content */
-  file.open(alignmentFile, ifstream::in);
-  if(!utils::checkFile(file))
-    return false;
-
   /* Store input file name for posterior uses in other formats */
   filename.append("!Title ");
   filename.append(alignmentFile);
@@ -1316,17 +1222,13 @@ bool alignment::loadNBRF_PirAlignment(char *alignmentFile) {
   sequenNumber = 0;
   while(!file.eof()) {
 
-    /* Deallocate previously used dinamic memory */
-    if (line != NULL)
-      delete [] line;
-
     /* Read lines in a safe way */
-    line = utils::readLine(file);
+    line = file.readLine();
     if (line == NULL)
       continue;
 
     /* It the line starts by ">" means that a new sequence has been found */
-    str = strtok(line, DELIMITERS);
+    str = strtok_r(line, DELIMITERS, &tokens);
     if (str == NULL)
       continue;
 
@@ -1336,8 +1238,7 @@ bool alignment::loadNBRF_PirAlignment(char *alignmentFile) {
   }
 
   /* Finish to preprocess the input file. */
-  file.clear();
-  file.seekg(0);
+  file.rewind();
 
   /* Allocate memory for the input alignmet */
   sequences = new string[sequenNumber];
@@ -1352,12 +1253,8 @@ bool alignment::loadNBRF_PirAlignment(char *alignmentFile) {
   /* Read the entire input file */
   while(!file.eof()) {
 
-    /* Deallocate local memory */
-    if (line != NULL)
-      delete [] line;
-
     /* Read lines in a safe way */
-    line = utils::readLine(file);
+    line = file.readLine();
     if (line == NULL)
       continue;
 
@@ -1369,11 +1266,11 @@ bool alignment::loadNBRF_PirAlignment(char *alignmentFile) {
       i += 1;
 
       /* Store information about sequence datatype */
-      str = strtok(line, ">;");
+      str = strtok_r(line, ">;", &tokens);
       seqsInfo[i].append(str, strlen(str));
 
       /* and the sequence identifier itself */
-      str = strtok(NULL, ">;");
+      str = strtok_r(NULL, ">;", &tokens);
       seqsName[i].append(str, strlen(str));
     }
 
@@ -1395,10 +1292,10 @@ bool alignment::loadNBRF_PirAlignment(char *alignmentFile) {
       }
 
       /* Process line */
-      str = strtok(line, OTHDELIMITERS);
+      str = strtok_r(line, OTHDELIMITERS, &tokens);
       while (str != NULL) {
         sequences[i].append(str, strlen(str));
-        str = strtok(NULL, OTHDELIMITERS);
+        str = strtok_r(NULL, OTHDELIMITERS, &tokens);
       }
 
       /* In case the end symbol '*' has been detected, remove it */
@@ -1410,10 +1307,6 @@ bool alignment::loadNBRF_PirAlignment(char *alignmentFile) {
   /* Close the input file */
   file.close();
 
-  /* Deallocate dinamic memory */
-  if (line != NULL)
-    delete [] line;
-
   /* Check the matrix's content */
   return fillMatrices(true);
 }
@@ -1864,16 +1757,13 @@ bool alignment::alignmentSummaryHTML(char *destFile, int residues, int seqs, \
   /* Generate an HTML file with a visual summary about which sequences/columns
    * have been selected and which have not */
 
-  int i, j, k, kj, upper, minHTML, maxLongName, *gapsValues;
-  string tmpColumn;
+  int i, j, k, upper, minHTML, maxLongName, *gapsValues;
+  string *columns;
   float *simValues;
   bool *res, *seq;
   ofstream file;
   char type;
 
-  /* Allocate some local memory */
-  tmpColumn.reserve(sequenNumber);
-
   /* Check whether sequences in the alignment are aligned or not.
    * Warn about it if there are not aligned. */
   if (!isAligned) {
@@ -1881,6 +1771,9 @@ bool alignment::alignmentSummaryHTML(char *destFile, int residues, int seqs, \
     return false;
   }
 
+  /* Residues colours depend on the whole column they belong to */
+  columns = getResidueColumns();
+
   /* Open output file and check that file pointer is valid */
   file.open(destFile);
   if(!file)
@@ -2014,10 +1907,8 @@ bool alignment::alignmentSummaryHTML(char *destFile, int residues, int seqs, \
 
       /* Print residues corresponding to current sequences block */
       for(k = j; ((k < residNumber) && (k < upper)); k++) {
-        for(kj = 0, tmpColumn.clear(); kj < sequenNumber; kj++)
-          tmpColumn += sequences[kj][k];
         /* Determine residue color based on residues across the alig column */
-        type = utils::determineColor(sequences[i][k], tmpColumn);
+        type = utils::determineColor(sequences[i][k], columns[k]);
         if (type == 'w')
           file << sequences[i][k];
         else
@@ -2136,13 +2027,10 @@ bool alignment::alignmentSummaryHTML(char *destFile, int residues, int seqs, \
 
 bool alignment::alignmentColourHTML(ostream &file) {
 
-  int i, j, kj, upper, k = 0, maxLongName = 0;
-  string tmpColumn;
+  int i, j, upper, k = 0, maxLongName = 0;
+  string *columns;
   char type;
 
-  /* Allocate some local memory */
-  tmpColumn.reserve(sequenNumber);
-
   /* Check whether sequences in the alignment are aligned or not.
    * Warn about it if there are not aligned. */
   if (!isAligned) {
@@ -2150,6 +2038,9 @@ bool alignment::alignmentColourHTML(ostream &file) {
     return false;
   }
 
+  /* Residues colours depend on the whole column they belong to */
+  columns = getResidueColumns();
+
   /* Compute maximum sequences name length */
   maxLongName = 0;
   for(i = 0; i < sequenNumber; i++)
@@ -2195,10 +2086,8 @@ bool alignment::alignmentColourHTML(ostream &file) {
 
       /* Print residues corresponding to current sequences block */
       for(k = j; ((k < residNumber) && (k < upper)); k++) {
-        for(kj = 0, tmpColumn.clear(); kj < sequenNumber; kj++)
-          tmpColumn += sequences[kj][k];
         /* Determine residue color based on residues across the alig column */
-        type = utils::determineColor(sequences[i][k], tmpColumn);
+        type = utils::determineColor(sequences[i][k], columns[k]);
         if (type == 'w')
           file << sequences[i][k];
         else
@@ -36,6 +36,11 @@ sequencesMatrix::sequencesMatrix(void) {
   seqsName = NULL;
   matrix = NULL;
 
+  residuesColumn = NULL;
+  seqsLength = NULL;
+
+  names = NULL;
+
 }
 
 sequencesMatrix::sequencesMatrix(string *alignmentMatrix, string *alignmentSeqsName, int sequences, int residues) {
@@ -50,6 +55,8 @@ sequencesMatrix::sequencesMatrix(string *alignmentMatrix, string *alignmentSeqsN
   seqsName = new string[seqsNumber];
   for(i = 0; i < seqsNumber; i++)
     seqsName[i] = alignmentSeqsName[i];
+
+  names = new namesIndex(seqsName, seqsNumber);
   /* ***** ***** ***** ***** ***** ***** ***** ***** */
 
   /* ***** ***** ***** ***** ***** ***** ***** ***** */
@@ -69,6 +76,12 @@ sequencesMatrix::sequencesMatrix(string *alignmentMatrix, string *alignmentSeqsN
     }
   }
   /* ***** ***** ***** ***** ***** ***** ***** ***** */
+
+  /* ***** ***** ***** ***** ***** ***** ***** ***** */
+  residuesColumn = NULL;
+  seqsLength = NULL;
+  buildResiduesIndex();
+  /* ***** ***** ***** ***** ***** ***** ***** ***** */
 }
 
 sequencesMatrix &sequencesMatrix::operator=(const sequencesMatrix &old) {
@@ -84,6 +97,8 @@ sequencesMatrix &sequencesMatrix::operator=(const sequencesMatrix &old) {
     seqsName = new string[seqsNumber];
     for(i = 0; i < seqsNumber; i++)
       seqsName[i] = old.seqsName[i];
+
+    names = new namesIndex(seqsName, seqsNumber);
     /* ***** ***** ***** ***** ***** ***** ***** ***** */
 
 	/* ***** ***** ***** ***** ***** ***** ***** ***** */
@@ -91,9 +106,15 @@ sequencesMatrix &sequencesMatrix::operator=(const sequencesMatrix &old) {
     for(i = 0; i < seqsNumber; i++) {
       matrix[i] = new int[resNumber];
       for(j = 0; j < resNumber; j++)
-        matrix[i][j] = matrix[i][j];
+        matrix[i][j] = old.matrix[i][j];
     }
 	/* ***** ***** ***** ***** ***** ***** ***** ***** */
+
+    /* ***** ***** ***** ***** ***** ***** ***** ***** */
+    residuesColumn = NULL;
+    seqsLength = NULL;
+    buildResiduesIndex();
+    /* ***** ***** ***** ***** ***** ***** ***** ***** */
   }
   return *this;
 }
@@ -103,18 +124,61 @@ sequencesMatrix::~sequencesMatrix(void) {
 
   if(matrix != NULL) {
     for(i = 0; i < seqsNumber; i++)
-      delete matrix[i];
+      delete [] matrix[i];
     delete [] matrix;
   }
 
   if(seqsName != NULL)
     delete [] seqsName;
 
+  if(names != NULL)
+    delete names;
+
+  deleteResiduesIndex();
+
   seqsNumber = 0;
   resNumber = 0;
 
   matrix = NULL;
   seqsName = NULL;
+  names = NULL;
+}
+
+void sequencesMatrix::buildResiduesIndex(void) {
+  int i, j;
+
+  residuesColumn = new int*[seqsNumber];
+  seqsLength = new int[seqsNumber];
+
+  /* The last residue number of each row is its residues number */
+  for(i = 0; i < seqsNumber; i++) {
+    for(j = resNumber - 1, seqsLength[i] = 0; j >= 0; j--)
+      if(matrix[i][j] != 0) {
+        seqsLength[i] = matrix[i][j];
+        break;
+      }
+
+    residuesColumn[i] = new int[seqsLength[i] + 1];
+    for(j = 0; j < resNumber; j++)
+      if(matrix[i][j] != 0)
+        residuesColumn[i][matrix[i][j]] = j;
+  }
+}
+
+void sequencesMatrix::deleteResiduesIndex(void) {
+  int i;
+
+  if(residuesColumn != NULL) {
+    for(i = 0; i < seqsNumber; i++)
+      delete [] residuesColumn[i];
+    delete [] residuesColumn;
+  }
+
+  if(seqsLength != NULL)
+    delete [] seqsLength;
+
+  residuesColumn = NULL;
+  seqsLength = NULL;
 }
 
 void sequencesMatrix::printMatrix(void) {
@@ -147,10 +211,15 @@ void sequencesMatrix::getColumn(int column, int *columnSeqMatrix) {
 void sequencesMatrix::getColumn(int value, int row, int *columnSeqMatrix) {
   int i, j;
 
-  for(i = 0; i < resNumber; i++)
-    if(matrix[row][i] == value) break;
+  /* Residue numbers are found in the residues index. Any
+   * other value is looked for along the row */
+  if(value > 0)
+    i = getResidueColumn(value, row);
+  else
+    for(i = 0; i < resNumber; i++)
+      if(matrix[row][i] == value) break;
 
-  if(i < resNumber)
+  if((i >= 0) && (i < resNumber))
     for(j = 0; j < seqsNumber; j++)
       columnSeqMatrix[j] = matrix[j][i];
 
@@ -159,6 +228,13 @@ void sequencesMatrix::getColumn(int value, int row, int *columnSeqMatrix) {
       columnSeqMatrix[j] = -1;
 }
 
+int sequencesMatrix::getResidueColumn(int value, int row) {
+
+  if((value > 0) && (value <= seqsLength[row]))
+    return residuesColumn[row][value];
+  return -1;
+}
+
 void sequencesMatrix::setOrder(int *order) {
   int i, j, **resg;
 
@@ -176,19 +252,21 @@ void sequencesMatrix::setOrder(int *order) {
     delete [] resg[i];
   }
   delete [] resg;
+
+  /* Rows have been reordered, so the index has to be rebuilt */
+  deleteResiduesIndex();
+  buildResiduesIndex();
 }
 
 bool sequencesMatrix::getSequence(string seqName, int *sequence) {
   int i, pos;
 
   /* ***** ***** ***** ***** ***** ***** ***** ***** */
-  for(pos = 0; pos < seqsNumber; pos++)
-	if(seqsName[pos].compare(seqName) == 0)
-	  break;
+  pos = names -> find(seqName);
   /* ***** ***** ***** ***** ***** ***** ***** ***** */
 
   /* ***** ***** ***** ***** ***** ***** ***** ***** */
-  if(pos == seqsNumber)
+  if(pos == -1)
 	return false;
   /* ***** ***** ***** ***** ***** ***** ***** ***** */
 
@@ -33,6 +33,7 @@
 #include <iomanip>
 
 #include "utils.h"
+#include "namesIndex.h"
 
 using namespace std;
 
@@ -51,9 +52,31 @@ class sequencesMatrix {
   /* Sequences Matrix */
   int **matrix;
 
+  /* Column of every residue, indexed by residue number, for each sequence */
+  int **residuesColumn;
+
+  /* Residues number for each sequence */
+  int *seqsLength;
+
   /* Sequences Name */
   string *seqsName;
 
+  /* Sequences positions sorted by name */
+  namesIndex *names;
+
+  /** \brief Residues index building method.
+   *
+   * Method that builds, for each sequence, the inverse index of the sequences matrix. It stores the column where
+   * every residue number is at, so looking for a residue does not need to scan its row.
+   */
+  void buildResiduesIndex(void);
+
+  /** \brief Residues index freeing method.
+   *
+   * Method that frees, if exists, the inverse index of the sequences matrix.
+   */
+  void deleteResiduesIndex(void);
+
   public:
 
   /* Constructors */
@@ -100,10 +123,18 @@ class sequencesMatrix {
    * \param numResidueseqMatrix Vector where storage a column's sequences matrix.
    *
    * Method that looks to value in a row and storages a column's, corresponding to row,
-   * sequences matrix in a vector.
+   * sequences matrix in a vector. Residue numbers are looked for in the residues index,
+   * in constant time.
    */
   void getColumn(int, int, int *);
 
+  /** \brief Residue column method.
+   * \param value Residue number to look for.
+   * \param row Sequence where to look for the residue.
+   * \return Column where the residue is at or -1 if the sequence has not such a residue.
+   */
+  int getResidueColumn(int, int);
+
   void setOrder(int *);
 
   void removeColumns(int, int, int *, int *);
@@ -0,0 +1,305 @@
+/* ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** *****
+   ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** *****
+
+    trimAl v1.5.0: a tool for automated alignment trimming in large-scale
+                 phylogenetics analyses.
+
+    readAl v1.5.0: a tool for automated alignment conversion among different
+                 formats.
+
+    2009-2020
+        Fernandez-Rodriguez V.  (victor.fernandez@bsc.es)
+        Capella-Gutierrez S.    (salvador.capella@bsc.es)
+        Gabaldon, T.            (tgabaldon@bsc.es)
+
+    This file is part of trimAl/readAl.
+
+    trimAl/readAl are free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, the last available version.
+
+    trimAl/readAl are distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with trimAl/readAl. If not, see <http://www.gnu.org/licenses/>.
+
+***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** *****
+***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** */
+
+#include "simdKernels.h"
+
+#ifdef SIMD_KERNELS
+#include <immintrin.h>
+#endif
+
+/* Scalar kernels. They are the reference for the vectorized ones, which use
+ * them as well for the residues left after the last whole vector */
+static int scalarMatches(const char *seqA, const char *seqB, int length) {
+  int i, count;
+
+  for(i = 0, count = 0; i < length; i++)
+    if(seqA[i] == seqB[i])
+      count++;
+  return count;
+}
+
+static void scalarIdentities(const char *seqA, const char *seqB, int length, char indet, int *identical, int *joint) {
+  bool validA, validB;
+  int i;
+
+  for(i = 0; i < length; i++) {
+    validA = (seqA[i] != '-') && (seqA[i] != indet);
+    validB = (seqB[i] != '-') && (seqB[i] != indet);
+    if(validA || validB) {
+      (*joint)++;
+      if(seqA[i] == seqB[i])
+        (*identical)++;
+    }
+  }
+}
+
+static void scalarSpuriousHits(const char *seqA, const char *seqB, int length, char indet, int *hits) {
+  int i;
+
+  for(i = 0; i < length; i++)
+    if((seqA[i] == seqB[i]) || ((seqA[i] != '-') && (seqA[i] != indet) && (seqB[i] != '-') && (seqB[i] != indet)))
+      hits[i]++;
+}
+
+#ifdef SIMD_KERNELS
+
+/* SSE4.2 kernels: 16 residues per vector */
+__attribute__((target("sse4.2,popcnt")))
+static int sse42Matches(const char *seqA, const char *seqB, int length) {
+  __m128i a, b;
+  int i, count;
+
+  for(i = 0, count = 0; i + 16 <= length; i += 16) {
+    a = _mm_loadu_si128((const __m128i *) (seqA + i));
+    b = _mm_loadu_si128((const __m128i *) (seqB + i));
+    count += __builtin_popcount(_mm_movemask_epi8(_mm_cmpeq_epi8(a, b)));
+  }
+  return count + scalarMatches(seqA + i, seqB + i, length - i);
+}
+
+__attribute__((target("sse4.2,popcnt")))
+static void sse42Identities(const char *seqA, const char *seqB, int length, char indet, int *identical, int *joint) {
+  __m128i a, b, gap, ind;
+  unsigned int equal, validA, validB;
+  int i;
+
+  gap = _mm_set1_epi8('-');
+  ind = _mm_set1_epi8(indet);
+
+  for(i = 0; i + 16 <= length; i += 16) {
+    a = _mm_loadu_si128((const __m128i *) (seqA + i));
+    b = _mm_loadu_si128((const __m128i *) (seqB + i));
+    equal = _mm_movemask_epi8(_mm_cmpeq_epi8(a, b));
+    validA = ~_mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(a, gap), _mm_cmpeq_epi8(a, ind))) & 0xFFFF;
+    validB = ~_mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(b, gap), _mm_cmpeq_epi8(b, ind))) & 0xFFFF;
+    *identical += __builtin_popcount(equal & validA);
+    *joint += __builtin_popcount(validA | validB);
+  }
+  scalarIdentities(seqA + i, seqB + i, length - i, indet, identical, joint);
+}
+
+__attribute__((target("sse4.2,popcnt")))
+static void sse42SpuriousHits(const char *seqA, const char *seqB, int length, char indet, int *hits) {
+  __m128i a, b, gap, ind, invalid, hit, *counts;
+  int i;
+
+  gap = _mm_set1_epi8('-');
+  ind = _mm_set1_epi8(indet);
+
+  for(i = 0; i + 16 <= length; i += 16) {
+    a = _mm_loadu_si128((const __m128i *) (seqA + i));
+    b = _mm_loadu_si128((const __m128i *) (seqB + i));
+    invalid = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(a, gap), _mm_cmpeq_epi8(a, ind)),
+                           _mm_or_si128(_mm_cmpeq_epi8(b, gap), _mm_cmpeq_epi8(b, ind)));
+    hit = _mm_or_si128(_mm_cmpeq_epi8(a, b), _mm_andnot_si128(invalid, _mm_cmpeq_epi8(a, a)));
+
+    /* Hits are -1 bytes, so they are subtracted once widened to 32 bits */
+    counts = (__m128i *) (hits + i);
+    _mm_storeu_si128(counts, _mm_sub_epi32(_mm_loadu_si128(counts), _mm_cvtepi8_epi32(hit)));
+    _mm_storeu_si128(counts + 1, _mm_sub_epi32(_mm_loadu_si128(counts + 1), _mm_cvtepi8_epi32(_mm_srli_si128(hit, 4))));
+    _mm_storeu_si128(counts + 2, _mm_sub_epi32(_mm_loadu_si128(counts + 2), _mm_cvtepi8_epi32(_mm_srli_si128(hit, 8))));
+    _mm_storeu_si128(counts + 3, _mm_sub_epi32(_mm_loadu_si128(counts + 3), _mm_cvtepi8_epi32(_mm_srli_si128(hit, 12))));
+  }
+  scalarSpuriousHits(seqA + i, seqB + i, length - i, indet, hits + i);
+}
+
+/* AVX2 kernels: 32 residues per vector */
+__attribute__((target("avx2,popcnt")))
+static int avx2Matches(const char *seqA, const char *seqB, int length) {
+  __m256i a, b;
+  int i, count;
+
+  for(i = 0, count = 0; i + 32 <= length; i += 32) {
+    a = _mm256_loadu_si256((const __m256i *) (seqA + i));
+    b = _mm256_loadu_si256((const __m256i *) (seqB + i));
+    count += __builtin_popcount((unsigned int) _mm256_movemask_epi8(_mm256_cmpeq_epi8(a, b)));
+  }
+  return count + scalarMatches(seqA + i, seqB + i, length - i);
+}
+
+__attribute__((target("avx2,popcnt")))
+static void avx2Identities(const char *seqA, const char *seqB, int length, char indet, int *identical, int *joint) {
+  __m256i a, b, gap, ind;
+  unsigned int equal, validA, validB;
+  int i;
+
+  gap = _mm256_set1_epi8('-');
+  ind = _mm256_set1_epi8(indet);
+
+  for(i = 0; i + 32 <= length; i += 32) {
+    a = _mm256_loadu_si256((const __m256i *) (seqA + i));
+    b = _mm256_loadu_si256((const __m256i *) (seqB + i));
+    equal = _mm256_movemask_epi8(_mm256_cmpeq_epi8(a, b));
+    validA = ~_mm256_movemask_epi8(_mm256_or_si256(_mm256_cmpeq_epi8(a, gap), _mm256_cmpeq_epi8(a, ind)));
+    validB = ~_mm256_movemask_epi8(_mm256_or_si256(_mm256_cmpeq_epi8(b, gap), _mm256_cmpeq_epi8(b, ind)));
+    *identical += __builtin_popcount(equal & validA);
+    *joint += __builtin_popcount(validA | validB);
+  }
+  scalarIdentities(seqA + i, seqB + i, length - i, indet, identical, joint);
+}
+
+__attribute__((target("avx2,popcnt")))
+static void avx2SpuriousHits(const char *seqA, const char *seqB, int length, char indet, int *hits) {
+  __m256i a, b, gap, ind, invalid, hit, *counts;
+  __m128i low, high;
+  int i;
+
+  gap = _mm256_set1_epi8('-');
+  ind = _mm256_set1_epi8(indet);
+
+  for(i = 0; i + 32 <= length; i += 32) {
+    a = _mm256_loadu_si256((const __m256i *) (seqA + i));
+    b = _mm256_loadu_si256((const __m256i *) (seqB + i));
+    invalid = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(a, gap), _mm256_cmpeq_epi8(a, ind)),
+                              _mm256_or_si256(_mm256_cmpeq_epi8(b, gap), _mm256_cmpeq_epi8(b, ind)));
+    hit = _mm256_or_si256(_mm256_cmpeq_epi8(a, b), _mm256_andnot_si256(invalid, _mm256_cmpeq_epi8(a, a)));
+
+    /* Hits are -1 bytes, so they are subtracted once widened to 32 bits */
+    low = _mm256_castsi256_si128(hit);
+    high = _mm256_extracti128_si256(hit, 1);
+    counts = (__m256i *) (hits + i);
+    _mm256_storeu_si256(counts, _mm256_sub_epi32(_mm256_loadu_si256(counts), _mm256_cvtepi8_epi32(low)));
+    _mm256_storeu_si256(counts + 1, _mm256_sub_epi32(_mm256_loadu_si256(counts + 1), _mm256_cvtepi8_epi32(_mm_srli_si128(low, 8))));
+    _mm256_storeu_si256(counts + 2, _mm256_sub_epi32(_mm256_loadu_si256(counts + 2), _mm256_cvtepi8_epi32(high)));
+    _mm256_storeu_si256(counts + 3, _mm256_sub_epi32(_mm256_loadu_si256(counts + 3), _mm256_cvtepi8_epi32(_mm_srli_si128(high, 8))));
+  }
+  scalarSpuriousHits(seqA + i, seqB + i, length - i, indet, hits + i);
+}
+
+/* AVX-512 kernels: 64 residues per vector, compared into bitmasks */
+__attribute__((target("avx512f,avx512bw,popcnt")))
+static int avx512Matches(const char *seqA, const char *seqB, int length) {
+  __m512i a, b;
+  int i, count;
+
+  for(i = 0, count = 0; i + 64 <= length; i += 64) {
+    a = _mm512_loadu_si512((const void *) (seqA + i));
+    b = _mm512_loadu_si512((const void *) (seqB + i));
+    count += __builtin_popcountll(_mm512_cmpeq_epi8_mask(a, b));
+  }
+  return count + scalarMatches(seqA + i, seqB + i, length - i);
+}
+
+__attribute__((target("avx512f,avx512bw,popcnt")))
+static void avx512Identities(const char *seqA, const char *seqB, int length, char indet, int *identical, int *joint) {
+  __m512i a, b, gap, ind;
+  unsigned long long equal, validA, validB;
+  int i;
+
+  gap = _mm512_set1_epi8('-');
+  ind = _mm512_set1_epi8(indet);
+
+  for(i = 0; i + 64 <= length; i += 64) {
+    a = _mm512_loadu_si512((const void *) (seqA + i));
+    b = _mm512_loadu_si512((const void *) (seqB + i));
+    equal = _mm512_cmpeq_epi8_mask(a, b);
+    validA = ~(_mm512_cmpeq_epi8_mask(a, gap) | _mm512_cmpeq_epi8_mask(a, ind));
+    validB = ~(_mm512_cmpeq_epi8_mask(b, gap) | _mm512_cmpeq_epi8_mask(b, ind));
+    *identical += __builtin_popcountll(equal & validA);
+    *joint += __builtin_popcountll(validA | validB);
+  }
+  scalarIdentities(seqA + i, seqB + i, length - i, indet, identical, joint);
+}
+
+__attribute__((target("avx512f,avx512bw,popcnt")))
+static void avx512SpuriousHits(const char *seqA, const char *seqB, int length, char indet, int *hits) {
+  __m512i a, b, gap, ind, one, counts;
+  unsigned long long hit;
+  int i, j;
+
+  gap = _mm512_set1_epi8('-');
+  ind = _mm512_set1_epi8(indet);
+  one = _mm512_set1_epi32(1);
+
+  for(i = 0; i + 64 <= length; i += 64) {
+    a = _mm512_loadu_si512((const void *) (seqA + i));
+    b = _mm512_loadu_si512((const void *) (seqB + i));
+    hit = _mm512_cmpeq_epi8_mask(a, b) | ~(_mm512_cmpeq_epi8_mask(a, gap) | _mm512_cmpeq_epi8_mask(a, ind) |
+                                           _mm512_cmpeq_epi8_mask(b, gap) | _mm512_cmpeq_epi8_mask(b, ind));
+
+    /* Add one to the counters of the positions flagged in each 16 bits */
+    for(j = 0; j < 4; j++) {
+      counts = _mm512_loadu_si512((const void *) (hits + i + 16 * j));
+      counts = _mm512_mask_add_epi32(counts, (__mmask16) (hit >> (16 * j)), counts, one);
+      _mm512_storeu_si512((void *) (hits + i + 16 * j), counts);
+    }
+  }
+  scalarSpuriousHits(seqA + i, seqB + i, length - i, indet, hits + i);
+}
+
+#endif
+
+/* Kernels in use, scalar ones until the CPU features have been checked */
+static int (*matchesKernel)(const char *, const char *, int) = scalarMatches;
+static void (*identitiesKernel)(const char *, const char *, int, char, int *, int *) = scalarIdentities;
+static void (*spuriousHitsKernel)(const char *, const char *, int, char, int *) = scalarSpuriousHits;
+
+static bool selectKernels(void) {
+
+#ifdef SIMD_KERNELS
+  __builtin_cpu_init();
+
+  if(__builtin_cpu_supports("avx512bw") && __builtin_cpu_supports("popcnt")) {
+    matchesKernel = avx512Matches;
+    identitiesKernel = avx512Identities;
+    spuriousHitsKernel = avx512SpuriousHits;
+  }
+  else if(__builtin_cpu_supports("avx2") && __builtin_cpu_supports("popcnt")) {
+    matchesKernel = avx2Matches;
+    identitiesKernel = avx2Identities;
+    spuriousHitsKernel = avx2SpuriousHits;
+  }
+  else if(__builtin_cpu_supports("sse4.2") && __builtin_cpu_supports("popcnt")) {
+    matchesKernel = sse42Matches;
+    identitiesKernel = sse42Identities;
+    spuriousHitsKernel = sse42SpuriousHits;
+  }
+#endif
+
+  return true;
+}
+
+/* Select the kernels at startup */
+static bool kernelsSelected = selectKernels();
+
+int simdKernels::countMatches(const char *seqA, const char *seqB, int length) {
+  return matchesKernel(seqA, seqB, length);
+}
+
+void simdKernels::countIdentities(const char *seqA, const char *seqB, int length, char indet, int *identical, int *joint) {
+  *identical = 0;
+  *joint = 0;
+  identitiesKernel(seqA, seqB, length, indet, identical, joint);
+}
+
+void simdKernels::addSpuriousHits(const char *seqA, const char *seqB, int length, char indet, int *hits) {
+  spuriousHitsKernel(seqA, seqB, length, indet, hits);
+}
@@ -0,0 +1,85 @@
+/* ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** *****
+   ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** *****
+
+    trimAl v1.5.0: a tool for automated alignment trimming in large-scale
+                 phylogenetics analyses.
+
+    readAl v1.5.0: a tool for automated alignment conversion among different
+                 formats.
+
+    2009-2020
+        Fernandez-Rodriguez V.  (victor.fernandez@bsc.es)
+        Capella-Gutierrez S.    (salvador.capella@bsc.es)
+        Gabaldon, T.            (tgabaldon@bsc.es)
+
+    This file is part of trimAl/readAl.
+
+    trimAl/readAl are free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, the last available version.
+
+    trimAl/readAl are distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with trimAl/readAl. If not, see <http://www.gnu.org/licenses/>.
+
+***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** *****
+***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** */
+
+#ifndef SIMDKERNELS_H
+#define SIMDKERNELS_H
+
+/* Vectorized kernels are only built for x86 targets with GCC compatible
+ * compilers. Define NO_SIMD to always use the scalar ones */
+#if !defined(NO_SIMD) && defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define SIMD_KERNELS
+#endif
+
+/** \brief Class containing the residues comparison kernels.
+ *
+ * Every kernel compares two aligned rows of residues. The scalar versions are
+ * the reference implementation, while SSE4.2, AVX2 and AVX-512 versions
+ * compare 16, 32 or 64 residues per instruction. The best version supported
+ * by the running CPU is selected at startup, and all of them give exactly
+ * the same counts.
+ */
+
+class simdKernels {
+
+  public:
+
+  /** \brief Identical positions counting method.
+   * \param seqA First row of residues.
+   * \param seqB Second row of residues.
+   * \param length Number of residues to compare.
+   * \return Number of positions with the same symbol, gaps included.
+   */
+  static int countMatches(const char *seqA, const char *seqB, int length);
+
+  /** \brief Identities counting method.
+   * \param seqA First row of residues.
+   * \param seqB Second row of residues.
+   * \param length Number of residues to compare.
+   * \param indet Indetermination symbol.
+   * \param identical Number of positions with the same valid residue.
+   * \param joint Number of positions with a valid residue in any row.
+   *
+   * Valid residues are those which are neither gaps nor indeterminations.
+   */
+  static void countIdentities(const char *seqA, const char *seqB, int length, char indet, int *identical, int *joint);
+
+  /** \brief Spurious hits accumulation method.
+   * \param seqA First row of residues.
+   * \param seqB Second row of residues.
+   * \param length Number of residues to compare.
+   * \param indet Indetermination symbol.
+   * \param hits Vector where a hit is added for every position where both
+   * rows have the same symbol or both have a valid residue.
+   */
+  static void addSpuriousHits(const char *seqA, const char *seqB, int length, char indet, int *hits);
+};
+
+#endif
@@ -60,6 +60,8 @@ similarityMatrix::similarityMatrix(){
   vhash        = NULL;
   simMat       = NULL;
   distMat      = NULL;
+
+  buildDistanceTable();
 }
 
 
@@ -128,6 +130,34 @@ void similarityMatrix::memoryDeletion(){
   vhash        = NULL;
   simMat       = NULL;
   distMat      = NULL;
+
+  buildDistanceTable();
+}
+
+
+/*+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+| void similarityMatrix::buildDistanceTable()               |
+|      This method fills the dense distances table from the |
+|      current matrix. Pairs with any undefined symbol get  |
+|      -1, as getDistance returns for them                  |
++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
+
+void similarityMatrix::buildDistanceTable(){
+  int i, j, numa, numb;
+
+  /* Letters are coded by their position in the alphabet */
+  for(i = 0; i < 256; i++) {
+    j = toupper(i);
+    symbolCode[i] = ((j >= 'A') && (j <= 'Z')) ? j - 'A' : DISTANCECODES - 1;
+  }
+
+  for(i = 0; i < DISTANCECODES; i++) {
+    for(j = 0; j < DISTANCECODES; j++) {
+      numa = ((vhash != NULL) && (i < 'Z' - 'A' + 1)) ? vhash[i] : -1;
+      numb = ((vhash != NULL) && (j < 'Z' - 'A' + 1)) ? vhash[j] : -1;
+      distTable[i * DISTANCECODES + j] = ((numa == -1) || (numb == -1)) ? -1 : distMat[numa][numb];
+    }
+  }
 }
 
 
@@ -252,6 +282,8 @@ bool similarityMatrix::loadSimMatrix(char *fn){
   }
 
   file.close();
+
+  buildDistanceTable();
   return true;
 }
 
@@ -285,6 +317,8 @@ void similarityMatrix::defaultAASimMatrix(void) {
       }
     }
   }
+
+  buildDistanceTable();
 }
 
 void similarityMatrix::defaultNTSimMatrix(void) {
@@ -316,6 +350,8 @@ void similarityMatrix::defaultNTSimMatrix(void) {
       }
     }
   }
+
+  buildDistanceTable();
 }
 
 void similarityMatrix::defaultNTDegeneratedSimMatrix(void) {
@@ -346,6 +382,8 @@ void similarityMatrix::defaultNTDegeneratedSimMatrix(void) {
       }
     }
   }
+
+  buildDistanceTable();
 }
 
 void similarityMatrix::alternativeSimilarityMatrices(int matrix_code, \
@@ -411,6 +449,8 @@ void similarityMatrix::alternativeSimilarityMatrices(int matrix_code, \
       }
     }
   }
+
+  buildDistanceTable();
 }
 
 /*++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
@@ -436,30 +476,35 @@ void similarityMatrix::printMatrix(){
 |      the similarity matrix file.                                          |
 +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
 float similarityMatrix::getDistance(char a, char b){
-  int numa, numb; char chA, chB;
 
-  chA = (char)toupper((int) a);
-  chB = (char)toupper((int) b);
+  /* Check both symbols, reporting the first wrong one */
+  if(!checkSymbol(a) || !checkSymbol(b))
+    return -1;
 
-  /* Search the first character position */
-  if((chA >= 'A') && (chA <= 'Z')) numa = vhash[chA - 'A'];
-  else { cerr << "Error: the symbol '" << a << "' is incorrect" << endl; return -1; }
+  /* Return the distance value between a and b */
+  return distance(a, b);
+}
 
-  /* Search the second character position */
-  if((chB >= 'A') && (chB <= 'Z')) numb = vhash[chB - 'A'];
-  else { cerr << "Error: the symbol '" << b << "' is incorrect" << endl; return -1; }
 
-  /* We check if the two character postions are valid positions */
-  if(numa == -1) {
-    cerr << "Error: the symbol '" << a << "' accesing the matrix is not defined in this object" << endl;
-    return -1;
+/*+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+| bool similarityMatrix::checkSymbol(char)                                  |
+|      This method checks if the given character can be used to access the  |
+|      matrix. If not, the error is reported and the method returns false.  |
++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
+bool similarityMatrix::checkSymbol(char a){
+  int code;
+
+  code = symbolCode[(unsigned char) a];
+
+  if(code == DISTANCECODES - 1) {
+    cerr << "Error: the symbol '" << a << "' is incorrect" << endl;
+    return false;
   }
 
-  if(numb == -1) {
-    cerr << "Error: the symbol '" << b << "' accesing the matrix is not defined in this object" << endl;
-    return -1;
+  if((vhash == NULL) || (vhash[code] == -1)) {
+    cerr << "Error: the symbol '" << a << "' accesing the matrix is not defined in this object" << endl;
+    return false;
   }
 
-  /* Return the distance value between a and b */
-  return distMat[numa][numb];
+  return true;
 }
@@ -46,9 +46,15 @@ class similarityMatrix{
   float **distMat;
   int numPositions;
 
+  /* Dense distances table, indexed by the codes of both symbols. Letters are
+   * coded regardless of their case, and any other symbol gets the last code */
+  unsigned char symbolCode[256];
+  float distTable[DISTANCECODES * DISTANCECODES];
+
  private:
   void memoryAllocation(int);
   void memoryDeletion();
+  void buildDistanceTable();
 
  public:
   similarityMatrix();
@@ -67,6 +73,15 @@ class similarityMatrix{
 
   float getDistance(char, char);
 
+  bool checkSymbol(char);
+
+  /* Distance between two symbols without any check, for the inner loops.
+   * Symbols should have been validated with checkSymbol, since undefined
+   * ones just get -1 */
+  inline float distance(char a, char b) {
+    return distTable[symbolCode[(unsigned char) a] * DISTANCECODES + symbolCode[(unsigned char) b]];
+  }
+
   void printMatrix();
 };
 #endif
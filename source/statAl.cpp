@@ -29,37 +29,49 @@
 #include <iostream>
 #include <iomanip>
 
+#include <sstream>
+
 #include <stdlib.h>
 #include <string.h>
+#include <pthread.h>
+
+#ifndef _WIN32
+#include <glob.h>
+#endif
+
+#include <algorithm>
+#include <vector>
 
 #include "compareFiles.h"
 #include "compareFiles.h"
 #include "alignment.h"
+#include "threadPool.h"
 #include "defines.h"
 #include "utils.h"
 
+/* Data shared by all the alignments summarized in batch mode. Each alignment
+ * fills its own row of the table, which is printed once all of them are done */
+struct statalBatch {
+  pthread_mutex_t lock;
+  similarityMatrix *matrices[RNADeg + 1];
+  char *matrix;
+  int alternative_matrix;
+  vector<string> inputs, rows;
+  vector<char *> arguments;
+  char separator;
+  int failed;
+};
+
+static int summaryBatch(int argc, char *argv[]);
+static int statAlignment(int argc, char *argv[], statalBatch *batch, int entry);
+static similarityMatrix *buildSimilarityMatrix(char *matrix, int alternative_matrix, int alignDataType);
+
 void show_menu(void);
 void show_examples(void);
 
 int main(int argc, char *argv[]){
 
-  /* Input values */
-  char *inFile = NULL, *forceFile = NULL, *setAlignments = NULL, *matrix = NULL;
-  int windowSize = -1, gapWindow = -1, simWindow = -1, conWindow = -1,
-    alternative_matrix = -1;
-  bool stats_gaps_columns = 0, stats_gaps_dist = 0, stats_simil_columns = 0,
-    stats_simil_dist = 0, stats_seqs_ident = 0, stats_col_ident_gen = 0,
-    stats_file_columns = 0, stats_file_dist = 0;
-  alignment *origAlig = NULL, **compAlig  = NULL;
-
-  /* Internal variables */
-  int i = 1, numFiles = 0, maxResidues = 0, referFile = 0, alignDataType = -1;
-  similarityMatrix *similMatrix = NULL;
-  char **filesToCompare = NULL;
-  bool appearErrors = false;
-  float *compareVect = NULL;
-  ifstream algsPaths;
-  string line;
+  int i = 1;
 
   /* ***** ***** ***** ***** ***** Help functions ***** ***** ***** ***** *** */
   /* Show help and exit either help flag is set or not arguments are provided */
@@ -78,6 +90,36 @@ int main(int argc, char *argv[]){
     return 0;
   }
 
+  /* Summarize several alignments in a single table */
+  for(i = 1; i < argc; i++)
+    if((!strcmp(argv[i], "-batch")) || (!strcmp(argv[i], "-batchglob")))
+      return summaryBatch(argc, argv);
+
+  return statAlignment(argc, argv, NULL, -1);
+}
+
+/* Compute the stats asked for by the command line for an alignment. In batch
+ * mode, they are summarized in the alignment row instead of being printed */
+static int statAlignment(int argc, char *argv[], statalBatch *batch, int entry) {
+
+  /* Input values */
+  char *inFile = NULL, *forceFile = NULL, *setAlignments = NULL, *matrix = NULL;
+  int windowSize = -1, gapWindow = -1, simWindow = -1, conWindow = -1,
+    alternative_matrix = -1, threads = -1;
+  bool stats_gaps_columns = 0, stats_gaps_dist = 0, stats_simil_columns = 0,
+    stats_simil_dist = 0, stats_seqs_ident = 0, stats_col_ident_gen = 0,
+    stats_file_columns = 0, stats_file_dist = 0;
+  alignment *origAlig = NULL, **compAlig  = NULL;
+
+  /* Internal variables */
+  int i = 1, numFiles = 0, maxResidues = 0, referFile = 0, alignDataType = -1;
+  similarityMatrix *similMatrix = NULL;
+  char **filesToCompare = NULL;
+  bool appearErrors = false;
+  float *compareVect = NULL;
+  ifstream algsPaths;
+  string line;
+
   /* Allocate local memory for input alignment */
   origAlig = new alignment;
 
@@ -227,6 +269,22 @@ int main(int argc, char *argv[]){
       }
     }
 
+    /* Threads sharing the pairwise sequences matrices computation */
+    else if(!strcmp(argv[i], "-threads") && (i+1 != argc) && (threads == -1)) {
+      if(utils::isNumber(argv[i+1])) {
+        threads = atoi(argv[++i]);
+      }
+      else {
+        cerr << endl << "ERROR: Threads number should be a number\n\n.";
+        appearErrors = true;
+      }
+      if(threads < 1) {
+        cerr << endl << "ERROR: Threads number should be equal or greater "
+          << "than 1. Check your command-line parameter" << endl << endl;
+        appearErrors = true;
+      }
+    }
+
     else {
       cerr << endl << "ERROR: Parameter \"" << argv[i] << "\" not valid\n\n.";
       appearErrors = true;
@@ -348,14 +406,18 @@ int main(int argc, char *argv[]){
        * consistent one and choose it as the reference one */
       compareVect = new float[maxResidues];
       referFile = compareFiles::algorithm(compAlig, filesToCompare, compareVect,
-        numFiles, true);
-      origAlig -> loadAlignment(filesToCompare[referFile]);
+        numFiles, true, threads);
+      /* The comparison fails when the alignments can not be compared */
+      if(referFile == -1)
+        appearErrors = true;
+      else
+        origAlig -> loadAlignment(filesToCompare[referFile]);
     }
     else if((!appearErrors) && (forceFile != NULL)) {
       /* Compute consistency vector for the aligment set as the reference one */
       compareVect = new float[origAlig -> getNumAminos()];
       appearErrors = !(compareFiles::forceComparison(compAlig, numFiles,
-        origAlig, compareVect));
+        origAlig, compareVect, threads));
     }
     /* Apply any possible windows for future stats */
     conWindow = (conWindow != -1) ? conWindow : windowSize;
@@ -393,13 +455,29 @@ int main(int argc, char *argv[]){
     simWindow = (windowSize != -1) ? windowSize : (simWindow != -1) ?
       simWindow : 0;
     origAlig -> setWindowsSize(gapWindow, simWindow);
+
+    /* Threads used to compute the pairwise sequences matrices */
+    if(threads != -1)
+      origAlig -> setThreadsNumber(threads);
   }
   /* ***** ***** ***** ***** * Load Similarity Matrix ***** ***** ***** ***** */
   if(!appearErrors) {
     if((stats_simil_columns) || (stats_simil_dist)) {
 
+      /* In batch mode, every matrix is built once and shared by all the
+       * alignments */
+      if(batch != NULL) {
+        pthread_mutex_lock(&batch -> lock);
+        alignDataType = origAlig -> getTypeAlignment();
+        if(batch -> matrices[alignDataType] == NULL)
+          batch -> matrices[alignDataType] = buildSimilarityMatrix(batch -> matrix,
+            batch -> alternative_matrix, alignDataType);
+        similMatrix = batch -> matrices[alignDataType];
+        pthread_mutex_unlock(&batch -> lock);
+      }
+
       /* If any of the predefined matrices are going to be used, initialize it */
-      if (matrix == NULL) {
+      else if (matrix == NULL) {
         similMatrix = new similarityMatrix();
         alignDataType = origAlig -> getTypeAlignment();
 
@@ -424,7 +502,52 @@ int main(int argc, char *argv[]){
     }
   }
   /* ***** ***** ***** ***** ** Compute/Show stats ***** ***** ***** ***** ** */
-  if(!appearErrors) {
+  if((!appearErrors) && (batch != NULL)) {
+    float values[4];
+    ostringstream row;
+
+    /* Alignments names are quoted in CSV tables when they need it */
+    line = batch -> inputs[entry];
+    if((batch -> separator == ',') && (line.find_first_of(",\"") != string::npos)) {
+      for(i = (int) line.find('"'); i != (int) string::npos; i = (int) line.find('"', i + 2))
+        line.insert(i, 1, '"');
+      line = "\"" + line + "\"";
+    }
+    row << line << batch -> separator << origAlig -> getNumSpecies()
+      << batch -> separator << origAlig -> getNumAminos();
+    row.precision(6);
+    row << fixed;
+
+    if(stats_gaps_dist) {
+      origAlig -> getGapsSummary(&values[0], &values[1], &values[2]);
+      row << batch -> separator << values[0] << batch -> separator << values[1]
+        << batch -> separator << values[2];
+    }
+    if(stats_simil_dist) {
+      if(origAlig -> getConservationSummary(&values[0], &values[1], &values[2]))
+        row << batch -> separator << values[0] << batch -> separator << values[1]
+          << batch -> separator << values[2];
+      else
+        appearErrors = true;
+    }
+    if(stats_seqs_ident) {
+      origAlig -> getSeqIdentitySummary(&values[0], &values[1], &values[2]);
+      row << batch -> separator << values[0] << batch -> separator << values[1]
+        << batch -> separator << values[2];
+    }
+    if(stats_col_ident_gen) {
+      if(origAlig -> getColumnsIdentitySummary(&values[0], &values[1], &values[2], &values[3]))
+        row << batch -> separator << values[0] << batch -> separator << values[1]
+          << batch -> separator << values[2] << batch -> separator << values[3];
+      else
+        row << batch -> separator << "NA" << batch -> separator << "NA"
+          << batch -> separator << "NA" << batch -> separator << "NA";
+    }
+
+    if(!appearErrors)
+      batch -> rows[entry] = row.str();
+  }
+  else if(!appearErrors) {
     if(stats_gaps_columns) {
       cout << endl << "## Gaps scores per column" << endl;
       origAlig -> printStatisticsGapsColumns();
@@ -464,7 +587,8 @@ int main(int argc, char *argv[]){
   delete origAlig;
   delete[] compAlig;
 
-  delete similMatrix;
+  if(batch == NULL)
+    delete similMatrix;
 
   delete[] filesToCompare;
   delete[] compareVect;
@@ -476,6 +600,234 @@ int main(int argc, char *argv[]){
   return (appearErrors == true ? -1 : 0);
 }
 
+/* Build the similarity matrix given by the user or, otherwise, the default
+ * one for the alignment data type */
+static similarityMatrix *buildSimilarityMatrix(char *matrix, int alternative_matrix, int alignDataType) {
+
+  similarityMatrix *similMatrix = new similarityMatrix();
+
+  if(matrix != NULL)
+    similMatrix -> loadSimMatrix(matrix);
+  else if(alternative_matrix != -1)
+    similMatrix -> alternativeSimilarityMatrices(alternative_matrix, alignDataType);
+  else if(alignDataType == AAType)
+    similMatrix -> defaultAASimMatrix();
+  else if((alignDataType == DNAType) || (alignDataType == RNAType))
+    similMatrix -> defaultNTSimMatrix();
+  else if((alignDataType == DNADeg) || (alignDataType == RNADeg))
+    similMatrix -> defaultNTDegeneratedSimMatrix();
+
+  return similMatrix;
+}
+
+/* Summarize one of the alignments from a batch, reporting it when it fails */
+static void summaryBatchEntry(void *data, int entry) {
+
+  statalBatch *batch = (statalBatch *) data;
+  vector<char *> arguments(batch -> arguments);
+
+  arguments.push_back((char *) "-in");
+  arguments.push_back((char *) batch -> inputs[entry].c_str());
+
+  if(statAlignment((int) arguments.size(), &arguments[0], batch, entry) != 0) {
+    pthread_mutex_lock(&batch -> lock);
+    batch -> failed++;
+    cerr << "ERROR: Alignment \"" << batch -> inputs[entry] << "\" has not "
+      << "been summarized." << endl << endl;
+    pthread_mutex_unlock(&batch -> lock);
+  }
+}
+
+/* Summarize every alignment from a batch file, or matching a pattern, in a
+ * table with a row per alignment and a column per summary value. Alignments
+ * are shared among -threads threads */
+static int summaryBatch(int argc, char *argv[]) {
+
+  const char *unavailable[] = {"-i", "-in", "-compareset", "-forceselect",
+    "-sgc", "-ssc", "-sfc", "-sft", "-cw", NULL};
+  char *batchFile = NULL, *pattern = NULL;
+  bool appearErrors = false, stats = false;
+  int i, j, threads = -1;
+  size_t first, last;
+  ostringstream header;
+  similarityMatrix check;
+  statalBatch batch;
+  ifstream manifest;
+  string line;
+
+  batch.matrix = NULL;
+  batch.alternative_matrix = -1;
+  batch.separator = '\t';
+  batch.arguments.push_back(argv[0]);
+
+  header << "Alignment" << '\t' << "Sequences" << '\t' << "Columns";
+
+  /* Split the batch options from the stats ones, shared by every
+   * alignment */
+  for(i = 1; (i < argc) && (!appearErrors); i++) {
+    if(!strcmp(argv[i], "-batch") && (i+1 != argc) && (batchFile == NULL))
+      batchFile = argv[++i];
+
+    else if(!strcmp(argv[i], "-batchglob") && (i+1 != argc) && (pattern == NULL))
+      pattern = argv[++i];
+
+    else if(!strcmp(argv[i], "-csv") && (batch.separator == '\t'))
+      batch.separator = ',';
+
+    else if(!strcmp(argv[i], "-threads") && (i+1 != argc) && (threads == -1)) {
+      if(utils::isNumber(argv[i+1]) && (atoi(argv[i+1]) > 0))
+        threads = atoi(argv[++i]);
+      else {
+        cerr << endl << "ERROR: Threads number should be equal or greater "
+          << "than 1. Check your command-line parameter" << endl << endl;
+        appearErrors = true;
+      }
+    }
+
+    /* The similarity matrix is checked once and then built for each data
+     * type found in the alignments */
+    else if(!strcmp(argv[i], "-matrix") && (i+1 != argc) &&
+      (batch.matrix == NULL)) {
+      batch.matrix = argv[++i];
+      if(!check.loadSimMatrix(batch.matrix)) {
+        cerr << endl << "ERROR: Similarity Matrix not loaded: \"" << batch.matrix
+          << "\" Check input file content." << endl << endl;
+        appearErrors = true;
+      }
+    }
+
+    else if(!strcmp(argv[i], "--alternative_matrix") && (i+1 != argc) &&
+      (batch.alternative_matrix == -1)) {
+      if(!strcmp(argv[++i], "degenerated_nt_identity"))
+        batch.alternative_matrix = 1;
+      else {
+        cerr << endl << "ERROR: Alternative not recognized \"" << argv[i]
+          << "\"" << endl << endl;
+        appearErrors = true;
+      }
+    }
+
+    else {
+      for(j = 0; unavailable[j] != NULL; j++)
+        if(!strcmp(argv[i], unavailable[j])) {
+          cerr << endl << "ERROR: Option \"" << argv[i] << "\" is not "
+            << "available in batch mode." << endl << endl;
+          appearErrors = true;
+        }
+      batch.arguments.push_back(argv[i]);
+    }
+  }
+
+  /* Columns keep the same order than the values in each row */
+  for(i = 1; i < argc; i++)
+    if(!strcmp(argv[i], "-sgt"))
+      header << '\t' << "GapFreeColumns" << '\t' << "AverageGaps" << '\t'
+        << "MaxGaps";
+  for(i = 1; i < argc; i++)
+    if(!strcmp(argv[i], "-sst"))
+      header << '\t' << "MinSimilarity" << '\t' << "AverageSimilarity"
+        << '\t' << "MaxSimilarity";
+  for(i = 1; i < argc; i++)
+    if(!strcmp(argv[i], "-sident"))
+      header << '\t' << "MaxIdentity" << '\t' << "AverageIdentity" << '\t'
+        << "AverageMostSimilarIdentity";
+  for(i = 1; i < argc; i++)
+    if(!strcmp(argv[i], "-scolidentt"))
+      header << '\t' << "maxColIdentity" << '\t' << "minColIdentity" << '\t'
+        << "avgColIdentity" << '\t' << "stdColIdentity";
+
+  line = header.str();
+  stats = (line.find("Gap") != string::npos) || (line.find("Identity") !=
+    string::npos) || (line.find("Similarity") != string::npos);
+
+  /* Final verifications to detect any possible mistake in the input options */
+  if((!appearErrors) && (!stats)) {
+    cerr << endl << "ERROR: An option has to be chosen." << endl << endl;
+    appearErrors = true;
+  }
+
+  if((!appearErrors) && (batchFile != NULL) && (pattern != NULL)) {
+    cerr << endl << "ERROR: Choose either a batch file or a pattern to look "
+      << "for the alignments." << endl << endl;
+    appearErrors = true;
+  }
+
+  /* Each line from the batch file has an input alignment. Empty lines and
+   * lines starting by '#' are skipped */
+  if((!appearErrors) && (batchFile != NULL)) {
+    manifest.open(batchFile, ifstream::in);
+    if(!manifest) {
+      cerr << endl << "ERROR: Check the batch file \"" << batchFile << "\"."
+        << endl << endl;
+      appearErrors = true;
+    }
+
+    while((!appearErrors) && (getline(manifest, line))) {
+      first = line.find_first_not_of(" \t\r");
+      if((first == string::npos) || (line[first] == '#'))
+        continue;
+      last = line.find_last_not_of(" \t\r");
+      batch.inputs.push_back(line.substr(first, last - first + 1));
+    }
+    manifest.close();
+  }
+
+  if((!appearErrors) && (pattern != NULL)) {
+#ifndef _WIN32
+    glob_t matches;
+
+    if(glob(pattern, 0, NULL, &matches) == 0)
+      for(i = 0; i < (int) matches.gl_pathc; i++)
+        batch.inputs.push_back(matches.gl_pathv[i]);
+    globfree(&matches);
+#else
+    cerr << endl << "ERROR: Patterns are not available in this platform. Use "
+      << "a batch file instead." << endl << endl;
+    appearErrors = true;
+#endif
+  }
+
+  if((!appearErrors) && (batch.inputs.size() == 0)) {
+    cerr << endl << "ERROR: There are not alignments to summarize in batch "
+      << "mode." << endl << endl;
+    appearErrors = true;
+  }
+
+  if(appearErrors)
+    return -1;
+
+  /* Summarize the alignments sharing them among threads */
+  pthread_mutex_init(&batch.lock, NULL);
+  for(i = 0; i <= RNADeg; i++)
+    batch.matrices[i] = NULL;
+  batch.rows.resize(batch.inputs.size());
+  batch.failed = 0;
+
+  threadPool::computeItems((int) batch.inputs.size(), threads,
+    summaryBatchEntry, &batch);
+
+  for(i = 0; i <= RNADeg; i++)
+    delete batch.matrices[i];
+  pthread_mutex_destroy(&batch.lock);
+
+  /* Print the table keeping the alignments order. Failed alignments do not
+   * have any row */
+  line = header.str();
+  if(batch.separator != '\t')
+    replace(line.begin(), line.end(), '\t', batch.separator);
+  cout << line << endl;
+  for(i = 0; i < (int) batch.rows.size(); i++)
+    if(batch.rows[i].size() != 0)
+      cout << batch.rows[i] << endl;
+
+  if(batch.failed != 0) {
+    cerr << "ERROR: " << batch.failed << " of " << batch.inputs.size()
+      << " alignments have not been summarized." << endl << endl;
+    return -1;
+  }
+  return 0;
+}
+
 void show_menu(void) {
 
   cout << endl
@@ -504,7 +856,8 @@ void show_menu(void) {
 
   cout << "    -i -in <inputfile>       "
     << "Input file in several formats (clustal, fasta, nexus, phylip, etc)."
-    << endl << endl;
+    << endl << "                             "
+    << "It can be gzip or zstd compressed. Use '-' for stdin." << endl << endl;
 
   cout << "    -compareset <inputfile>     "
     << "Input list of paths for the alignments to compare." << endl;
@@ -555,6 +908,27 @@ void show_menu(void) {
   cout << "    -cw <n>                     "
     << "(half) Window size only applies to statistics based on Consistency."
     << endl << endl;
+
+  cout << "    -threads <n>                "
+    << "Number of threads used to compute the pairwise sequences matrices "
+    << "and to compare alignments (default 1)." << endl
+    << "                                "
+    << "In batch mode, number of alignments summarized at the same time."
+    << endl << endl;
+
+  cout << "    -batch <inputfile>          "
+    << "Summarize the stats for every alignment listed in the file, one per "
+    << "line." << endl
+    << "                                "
+    << "Only -sgt, -sst, -sident and -scolidentt are available. A table is "
+    << "printed" << endl
+    << "                                "
+    << "with a row per alignment and a column per summary value." << endl;
+  cout << "    -batchglob <pattern>        "
+    << "Summarize the alignments matching the pattern, e.g. 'families/*.fa', "
+    << "instead." << endl;
+  cout << "    -csv                        "
+    << "Separate the table columns by commas instead of tabs." << endl << endl;
 }
 
 void show_examples(void) {
@@ -573,4 +947,8 @@ void show_examples(void) {
 
   cout << "4) Change the windows size for computing similarity score per column"
        << endl << "   statal -in <inputfile> -sw 3 -ssc" << endl << endl;
+
+  cout << "5) Get a table with the gaps and identity summaries for several "
+       << "alignments" << endl
+       << "   statal -batch <listfile> -sgt -sident -threads 4" << endl << endl;
 }
@@ -29,14 +29,14 @@
 #include "statisticsConservation.h"
 
 /*++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
-|  statisticsConservation::statisticsConservation(char **, int, int)                                                   |
+|  statisticsConservation::statisticsConservation(int, int, int)                                                       |
 |                                                                                                                      |
 |       Class constructor. This method uses the inputs parameters to put the information in the new object that        |
 |       has been created.                                                                                              |
 |                                                                                                                      |
 ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
 
-statisticsConservation::statisticsConservation(string *alignmentMatrix, int species, int aminos, int dataType_) {
+statisticsConservation::statisticsConservation(int species, int aminos, int dataType_) {
 
   /* Initializate values to its corresponds values */
   columns = aminos;
@@ -54,17 +54,8 @@ statisticsConservation::statisticsConservation(string *alignmentMatrix, int spec
   MDK_Window = new float[columns];
   utils::initlVect(MDK_Window, columns, 0);
 
-  matrixIdentity = new float*[sequences];
-  for(int i = 0; i < sequences; i++){
-    matrixIdentity[i] = new float[sequences];
-    utils::initlVect(matrixIdentity[i], sequences, 0);
-  }
-
   /* Initializate the similarity matrix to NULL. */
   simMatrix = NULL;
-
-  /* Calculation methods call */
-  calculateMatrixIdentity(alignmentMatrix);
 }
 
 /*++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
@@ -86,7 +77,6 @@ statisticsConservation::statisticsConservation(void) {
   MDK = NULL;
   MDK_Window = NULL;
 
-  matrixIdentity = NULL;
   simMatrix = NULL;
 }
 
@@ -99,116 +89,186 @@ statisticsConservation::statisticsConservation(void) {
 
 statisticsConservation::~statisticsConservation(void) {
 
-  int i;
-
   /* Deallocate memory, if it have been allocated previously. */
   if(Q != NULL) {
     delete[] Q;
     delete[] MDK;
     delete[] MDK_Window;
-
-    for(i = 0; i < sequences; i++)
-      delete[] matrixIdentity[i];
-    delete[] matrixIdentity;
   }
 }
 
 /*++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
-|  void statisticsConservation::calculateMatrixIdentity(char **, int, int)                                             |
+|  char statisticsConservation::getIndetermination(void)                                                               |
 |                                                                                                                      |
-|       This method computes the matrix identity between all the sequences in the alignment.                           |
+|       This method returns the indetermination symbol that, as well as gaps, is not taken into account to compute     |
+|       the conservation's values. Identities between sequences must be computed using the same symbol.                |
 |                                                                                                                      |
 ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
 
-void statisticsConservation::calculateMatrixIdentity(string *alignmentMatrix) {
-
-  char indet;
-  int i, j, k, sum, length;
+char statisticsConservation::getIndetermination(void) {
 
   /* Depending on alignment type, indetermination symbol will be one or other */
-  indet = (dataType == AAType) ? 'X' : 'N';
+  return (dataType == AAType) ? 'X' : 'N';
+}
 
-  /* For each sequences' pair */
-  for(i = 0; i < sequences; i++) {
-    for(j = i + 1; j < sequences; j++) {
+/*++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+|  int statisticsConservation::bucketColumn(const char *, char, unsigned char *, int, float **)                        |
+|                                                                                                                      |
+|       This method groups the residues of a column by their symbol. Every residue gets the number of its group, or    |
+|       noClass for gaps and indeterminations, and the distances between the groups are taken once from the            |
+|       similarity matrix instead of once for every sequences' pair. The method returns how many groups there are.     |
+|                                                                                                                      |
+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
 
-      /* For each position in the alignment of that pair than we are processing */
-      for(k = 0, sum = 0, length = 0; k < columns; k++) {
+/* Group of the gaps and indeterminations */
+static const unsigned char noClass = 255;
 
-        /* If we find a element that is not a gap or an X aminoacid in the first sequence of the pair */
-        if((alignmentMatrix[i][k] != '-') && (alignmentMatrix[i][k] != indet)) {
+int statisticsConservation::bucketColumn(const char *column, char indet, unsigned char *classes, int stride,
+                                         float **distances) {
 
-          /* If we also find a valid element in the second sequence  */
-          if((alignmentMatrix[j][k] != '-') && (alignmentMatrix[j][k] != indet))
+  int symbolClass[256], j, a, b, number;
+  char symbols[256];
 
-            /* If the two valid elements are the same increase the sum */
-            if(alignmentMatrix[j][k] ==  alignmentMatrix[i][k])
-              sum++;
+  for(j = 0; j < 256; j++)
+    symbolClass[j] = -1;
 
-          /* Increase the length of the sequence free of gaps and X elements */
-          length++;
-        }
-
-        /* If the first processed element is invalid and in the second we find a valid element increase the length of
-           the sequence free of gaps and X elements */
-        else if((alignmentMatrix[j][k] != '-') && (alignmentMatrix[j][k] != indet))
-          length++;
-      }
+  /* Gaps and indeterminations are not taken into account, so there will be less than noClass groups */
+  for(j = 0, number = 0; j < sequences; j++) {
+    if((column[j] == '-') || (column[j] == indet)) {
+      classes[j * stride] = noClass;
+      continue;
+    }
 
-      /* Calculate the value of matrixidn for columns j and i */
-      matrixIdentity[j][i] = (100.0 - ((float) sum/ length) * 100.0);
-      matrixIdentity[i][j] = matrixIdentity[j][i];
+    a = symbolClass[(unsigned char) column[j]];
+    if(a == -1) {
+      a = number++;
+      symbolClass[(unsigned char) column[j]] = a;
+      symbols[a] = column[j];
     }
+
+    classes[j * stride] = (unsigned char) a;
   }
+
+  /* Symbols have been already checked, so distances are taken straight from the matrix */
+  *distances = new float[number * number + 1];
+  for(a = 0; a < number; a++)
+    for(b = 0; b < number; b++)
+      (*distances)[a * number + b] = simMatrix -> distance(symbols[a], symbols[b]);
+
+  return number;
 }
 
 /*++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
-|  bool statisticsConservation::calculateVectors(char **, int *)                                                       |
+|  bool statisticsConservation::calculateVectors(string *, int *, pairwiseIdentities *)                                |
 |                                                                                                                      |
-|       This method computes the distance between pairs for each column in the alignment.                              |
+|       This method computes the distance between pairs for each column in the alignment. Pairs are weighted by the    |
+|       identity between both sequences, which is shared with the rest of the alignment's statistics. Columns are      |
+|       processed in blocks, with their residues grouped by symbol, so every weight is read once for the whole block   |
+|       and the distances come from a small table per column. Sums of every column are accumulated in the same order   |
+|       than comparing the sequences' pairs one by one, so the values do not change.                                   |
 |                                                                                                                      |
 ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
 
-bool statisticsConservation::calculateVectors(string *alignmentMatrix, int *gaps) {
+bool statisticsConservation::calculateVectors(string *columnsMatrix, int *gaps, pairwiseIdentities *identities) {
 
+  float num[SIMILARITYBLOCK], den[SIMILARITYBLOCK], *distances[SIMILARITYBLOCK], *rows[SIMILARITYBLOCK];
+  int symbols[SIMILARITYBLOCK], i, j, k, c, block;
+  unsigned char *classes, *classesJ, *classesK;
+  const float *identity;
+  float *weights, *weight;
+  bool valid, found[256];
   char indet;
-  int i, j, k;
-  float num, den;
+  long pos;
 
   /* Depending on alignment type, indetermination symbol will be one or other */
-  indet = (dataType == AAType) ? 'X' : 'N';
+  indet = getIndetermination();
 
   /* A conservation matrix must be defined. If not, return false */
   if(simMatrix == NULL)
     return false;
 
+  /* Check once every residue symbol in the alignment against the similarity matrix, which reports the wrong ones */
+  for(j = 0; j < 256; j++)
+    found[j] = false;
+  for(i = 0; i < columns; i++)
+    for(j = 0; j < sequences; j++)
+      found[(unsigned char) columnsMatrix[i][j]] = true;
+  found[(unsigned char) '-'] = false;
+  found[(unsigned char) indet] = false;
+  for(j = 0; j < 256; j++)
+    if(found[j])
+      simMatrix -> checkSymbol((char) j);
+
+  /* Turn the identity of each sequences' pair into its weight just once. Weights are stored as the identities are,
+     row by row in the upper triangle of the matrix. The more different both sequences are, the more weight their
+     distance has. */
+  weights = new float[(long) sequences * (sequences - 1) / 2 + 1];
+  for(j = 0, pos = 0; j < sequences; j++) {
+    identity = identities -> getRow(j);
+    for(k = j + 1; k < sequences; k++, pos++)
+      weights[pos] = (100.0 - identity[k] * 100.0);
+  }
+
+  /* Groups of the residues of each column in the block, stored sequence by sequence */
+  classes = new unsigned char[(long) sequences * SIMILARITYBLOCK];
+
   /* For each column calculate the Q value and the MD value using an equation */
-  for(i = 0; i < columns; i++) {
-    /* For each AAs/Nucleotides' pair in the column we compute its distance */
-    for(j = 0, num = 0, den = 0; j < sequences; j++) {
+  for(i = 0; i < columns; i += SIMILARITYBLOCK) {
+    block = utils::min(SIMILARITYBLOCK, columns - i);
+
+    for(c = 0; c < block; c++) {
+      symbols[c] = bucketColumn(columnsMatrix[i + c].data(), indet, classes + c, block, &distances[c]);
+      num[c] = 0;
+      den[c] = 0;
+    }
+
+    /* For each AAs/Nucleotides' pair in the columns we compute its distance */
+    for(j = 0; j < sequences; j++) {
+      classesJ = classes + (long) j * block;
+
       /* We don't compute the distant if the first element is a indeterminate (X) or a gap (-) element. */
-      if((alignmentMatrix[j][i] != '-') && (alignmentMatrix[j][i] != indet))
-        for(k = j + 1; k < sequences; k++)
+      for(c = 0, valid = false; c < block; c++) {
+        rows[c] = NULL;
+        if(classesJ[c] != noClass) {
+          rows[c] = distances[c] + classesJ[c] * symbols[c];
+          valid = true;
+        }
+      }
+      if(!valid)
+        continue;
+
+      weight = weights + utils::triangleOffset(j, sequences);
+      for(k = j + 1; k < sequences; k++) {
+        classesK = classes + (long) k * block;
+        for(c = 0; c < block; c++)
           /* We don't compute the distant between the pair if the second element is a indeterminate or a gap element */
-          if((alignmentMatrix[k][i] != '-') && (alignmentMatrix[k][i] != indet)) {
+          if((rows[c] != NULL) && (classesK[c] != noClass)) {
             /* We use the identity value for the two pairs and its distance based on similarity matrix's value. */
-            num += matrixIdentity[j][k] * simMatrix -> getDistance(alignmentMatrix[j][i], alignmentMatrix[k][i]);;
-            den += matrixIdentity[j][k];
+            num[c] += weight[k] * rows[c][classesK[c]];
+            den[c] += weight[k];
           }
+      }
     }
-    /* If we are procesing a column with only one AA/nucleotide, the denominator is 0 and we don't execute the division
-       and we set the Q[i] value to 0. */
-    Q[i] = (den == 0) ? 0 : num / den;
-    MDK[i] = (float) exp(-Q[i]);
 
-    /* If the column has 80% or more gaps then we set its conservation value to 0 */
-    if(gaps != NULL)
-      if(((float) gaps[i] / sequences) >= 0.8) MDK[i] = 0;
+    for(c = 0; c < block; c++) {
+      delete[] distances[c];
+
+      /* If we are procesing a column with only one AA/nucleotide, the denominator is 0 and we don't execute the
+         division and we set the Q value to 0. */
+      Q[i + c] = (den[c] == 0) ? 0 : num[c] / den[c];
+      MDK[i + c] = (float) exp(-Q[i + c]);
+
+      /* If the column has 80% or more gaps then we set its conservation value to 0 */
+      if(gaps != NULL)
+        if(((float) gaps[i + c] / sequences) >= 0.8) MDK[i + c] = 0;
 
-    /* If the MDK value is more than 1, we normalized this value to 1. */
-    if(MDK[i] > 1) MDK[i] = 1;
+      /* If the MDK value is more than 1, we normalized this value to 1. */
+      if(MDK[i + c] > 1) MDK[i + c] = 1;
+    }
   }
 
+  delete[] classes;
+  delete[] weights;
   return true;
 }
 
@@ -222,8 +282,6 @@ bool statisticsConservation::calculateVectors(string *alignmentMatrix, int *gaps
 
 bool statisticsConservation::applyWindow(int _halfWindow) {
 
-  int i, j, window;
-
   /* If one of this conditions is true, we return FALSE:                         */
   /*    .- If already exists a previously calculated vector for this window size */
   /*    .- If mediumWinSize value is greater than 1/4 of alignment length        */
@@ -231,19 +289,9 @@ bool statisticsConservation::applyWindow(int _halfWindow) {
      return false;
 
   halfWindow = _halfWindow;
-  window = 2 * halfWindow + 1;
-
-  /* Do the average window calculations */
-  for(i = 0; i < columns; i++) {
-    for(j = i - halfWindow; j <= i + halfWindow; j++) {
-      if(j < 0) MDK_Window[i] += MDK[-j];
-      else if(j >= columns) MDK_Window[i] += MDK[((2 * columns - j) - 2)];
-      else MDK_Window[i] += MDK[j];
-    }
 
-    /* Calculate the similiraty value for the i column */
-    MDK_Window[i] = MDK_Window[i] / (float) window;
-  }
+  /* Do the average window calculations to get the similarity value of every column */
+  utils::windowAverages(MDK, columns, halfWindow, MDK_Window);
   return true;
 }
 
@@ -428,3 +476,29 @@ void statisticsConservation::printConservationAcl(void) {
   /* Deallocate the reserved memory. */
   delete [] vectAux;
 }
+
+/*++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+|  void statisticsConservation::getConservationSummary(float *minimum, float *average, float *maximum)                 |
+|                                                                                                                      |
+|       This method returns the minimum, average and maximum conservation's values for the alignment's columns, after  |
+|       applying any window. They summarize the distribution printed by printConservationAcl.                          |
+|                                                                                                                      |
+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
+
+void statisticsConservation::getConservationSummary(float *minimum, float *average, float *maximum) {
+
+  float *values;
+  double sum = 0;
+  int i;
+
+  /* Select the conservation's value source */
+  values = (MDK_Window != NULL) ? MDK_Window : MDK;
+
+  *minimum = *maximum = values[0];
+  for(i = 0; i < columns; i++) {
+    sum += values[i];
+    *minimum = (values[i] < *minimum) ? values[i] : *minimum;
+    *maximum = (values[i] > *maximum) ? values[i] : *maximum;
+  }
+  *average = (float) (sum / columns);
+}
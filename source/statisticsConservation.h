@@ -35,6 +35,7 @@
 
 #include "similarityMatrix.h"
 #include "statisticsGaps.h"
+#include "pairwiseIdentities.h"
 #include "defines.h"
 #include "utils.h"
 
@@ -62,15 +63,12 @@ class statisticsConservation{
   float *MDK;
   float *MDK_Window;
 
-  /* Identity weight matrix between alignment rows */
-  float **matrixIdentity;
-
   /* Similarity matrix used to conservation calculations */
   similarityMatrix *simMatrix;
 
   /* Private methods */
-  /* Computes the matrix identity between alignment's columns. */
-  void calculateMatrixIdentity(string *alignmentMatrix);
+  /* Groups a column's residues by symbol and computes the distances between the groups. */
+  int bucketColumn(const char *column, char indet, unsigned char *classes, int stride, float **distances);
 
  public:
 
@@ -78,13 +76,16 @@ class statisticsConservation{
   statisticsConservation(void);
 
   /* Constructors using parameters */
-  statisticsConservation(string *, int, int, int);
+  statisticsConservation(int, int, int);
 
   /* Destroyer */
   ~statisticsConservation(void);
 
+  /* Returns the indetermination symbol ignored by the conservation's values. */
+  char getIndetermination(void);
+
   /* This methods allows us compute the alignment's conservation's values. */
-  bool calculateVectors(string *, int *);
+  bool calculateVectors(string *, int *, pairwiseIdentities *);
 
   /* Allows us compute the conservationWindow's values. */
   bool applyWindow(int);
@@ -110,5 +111,8 @@ class statisticsConservation{
   /* Computes and prints the accumulative statistics associated to the alignment. */
   void printConservationAcl(void);
 
+  /* Returns the minimum, average and maximum conservation's values. */
+  void getConservationSummary(float *, float *, float *);
+
 };
 #endif
@@ -29,17 +29,16 @@
 #include "statisticsGaps.h"
 
 /*++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
-|  statisticsGaps::statisticsGaps(char **, int, int)                                                                   |
+|  statisticsGaps::statisticsGaps(packedSequences *, int, int, int)                                                    |
 |                                                                                                                      |
 |       Class constructor. This method uses the inputs parameters to put the information in the new object that        |
-|       has been created.                                                                                              |
+|       has been created. Gaps and indeterminations are counted using the bitmasks of the encoded alignment.           |
 |                                                                                                                      |
 ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
 
-statisticsGaps::statisticsGaps(string *alignmentMatrix, int species, int aminos, int dataType_) {
+statisticsGaps::statisticsGaps(packedSequences *alignmentMatrix, int species, int aminos, int dataType_) {
 
-  int i, j;
-  char indet;
+  int i;
 
   columnLength = species;
   columns =      aminos;
@@ -47,11 +46,6 @@ statisticsGaps::statisticsGaps(string *alignmentMatrix, int species, int aminos,
   halfWindow =   0;
   dataType = dataType_;
 
-  if(dataType == AAType)
-    indet = 'X';
-  else
-    indet = 'N';
-
   /* Memory allocation for the vectors and its initialization */
   gapsInColumn =       new int[columns];
   utils::initlVect(gapsInColumn, columns, 0);
@@ -66,14 +60,10 @@ statisticsGaps::statisticsGaps(string *alignmentMatrix, int species, int aminos,
   utils::initlVect(numColumnsWithGaps, columnLength+1, 0);
 
   /* Count the gaps and indeterminations of each columns */
-  for(i = 0; i < columns; i++) {
-    for(j = 0; j < columnLength; j++) {
-      if(alignmentMatrix[j][i] == '-')
-        gapsInColumn[i]++;
-      else if(alignmentMatrix[j][i] == indet)
-        aminosXInColumn[i]++;
-    }
+  alignmentMatrix -> countGaps(gapsInColumn);
+  alignmentMatrix -> countIndeterminations(aminosXInColumn);
 
+  for(i = 0; i < columns; i++) {
     /* Increase the number of colums with the number of gaps of the last processed column */
     numColumnsWithGaps[gapsInColumn[i]]++;
     gapsWindow[i] = gapsInColumn[i];
@@ -131,7 +121,7 @@ statisticsGaps::~statisticsGaps(void) {
 
 bool statisticsGaps::applyWindow(int _halfWindow) {
 
-  int i, j, window;
+  int i, window;
 
   /* If one of this conditions is true, we return FALSE:                         */
   /*    .- If already exists a previously calculated vector for this window size */
@@ -149,18 +139,11 @@ bool statisticsGaps::applyWindow(int _halfWindow) {
   halfWindow = _halfWindow;
   window = (2 * halfWindow + 1);
 
+  /* Sum the total number of gaps for the window of every column */
+  utils::windowSums(gapsInColumn, columns, halfWindow, gapsWindow);
+
   /* We calculate some statistics for every column in the alignment,and the maximum gaps' number value */
   for(i = 0; i < columns; i++) {
-    /* Sum the total number of gaps for the considered window */
-    for(j = i - halfWindow, gapsWindow[i] = 0; j <= i + halfWindow; j++) {
-      if(j < 0)
-        gapsWindow[i] += gapsInColumn[-j];
-      else if(j >= columns)
-        gapsWindow[i] += gapsInColumn[((2 * columns - j) - 2)];
-      else
-        gapsWindow[i] += gapsInColumn[j];
-    }
-
     /* Calculate, and round to the nearest integer, the number of gaps for the i column */
     gapsWindow[i] = utils::roundInt(((double) gapsWindow[i]/window));
     /* Increase in 1 the number of colums with the same number of gaps than column i */
@@ -464,3 +447,27 @@ void statisticsGaps::printGapsAcl(void) {
     }
   }
 }
+
+/*++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+|  void statisticsGaps::getGapsSummary(float *gapFreeColumns, float *averageGaps, float *maxGaps)                      |
+|                                                                                                                      |
+|       This method returns the fraction of columns without gaps as well as the average and maximum fraction of gaps   |
+|       per column. They summarize the distribution printed by printGapsAcl, after applying any window.                |
+|                                                                                                                      |
+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++*/
+
+void statisticsGaps::getGapsSummary(float *gapFreeColumns, float *averageGaps, float *maxGaps) {
+
+  long gaps = 0;
+  int i, most = 0;
+
+  /* Count the gaps in the whole alignment and the largest number of gaps in any column, after applying any window. */
+  for(i = 0; i < columns; i++) {
+    gaps += gapsWindow[i];
+    most = (gapsWindow[i] > most) ? gapsWindow[i] : most;
+  }
+
+  *gapFreeColumns = (float) numColumnsWithGaps[0] / columns;
+  *averageGaps = (float) (gaps / ((double) columns * columnLength));
+  *maxGaps = (float) most / columnLength;
+}
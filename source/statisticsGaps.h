@@ -33,6 +33,7 @@
 
 #include "utils.h"
 #include "defines.h"
+#include "packedSequences.h"
 
 using namespace std;
 
@@ -61,8 +62,8 @@ class statisticsGaps {
   /* Class destroyer. */
   ~statisticsGaps(void);
 
-  /* Class constructor with parameters. */
-  statisticsGaps(string *, int, int, int);
+  /* Class constructor with parameters. Gaps are counted on the encoded alignment. */
+  statisticsGaps(packedSequences *, int, int, int);
 
   /* Methods allows us compute the gapWindows' values. */
   bool applyWindow(int);
@@ -85,5 +86,8 @@ class statisticsGaps {
   /* This methods prints the statistics for the alignment relates to gaps. */
   void printGapsAcl(void);
 
+  /* This methods returns the columns' fraction without gaps as well as the average and maximum gaps' fraction per column. */
+  void getGapsSummary(float *, float *, float *);
+
 };
 #endif
@@ -0,0 +1,135 @@
+/* ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** *****
+   ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** *****
+
+    trimAl v1.5.0: a tool for automated alignment trimming in large-scale
+                 phylogenetics analyses.
+
+    readAl v1.5.0: a tool for automated alignment conversion among different
+                 formats.
+
+    2009-2020
+        Fernandez-Rodriguez V.  (victor.fernandez@bsc.es)
+        Capella-Gutierrez S.    (salvador.capella@bsc.es)
+        Gabaldon, T.            (tgabaldon@bsc.es)
+
+    This file is part of trimAl/readAl.
+
+    trimAl/readAl are free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, the last available version.
+
+    trimAl/readAl are distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with trimAl/readAl. If not, see <http://www.gnu.org/licenses/>.
+
+***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** *****
+***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** */
+
+#include "threadPool.h"
+#include "defines.h"
+
+#include <pthread.h>
+
+/* Items pending to be computed and the function to compute them */
+struct pendingItems {
+  pthread_mutex_t lock;
+  int next, number;
+  threadPool::itemFunction compute;
+  void *data;
+};
+
+/* Tiles of the upper triangle and the function to compute them */
+struct pairsTiles {
+  int *rows, *columns, elements;
+  threadPool::tileFunction compute;
+  void *data;
+};
+
+static void *takeItems(void *arg) {
+  /* Take items until all of them have been computed */
+  pendingItems *items = (pendingItems *) arg;
+  int item;
+
+  while(true) {
+    pthread_mutex_lock(&items -> lock);
+    item = items -> next++;
+    pthread_mutex_unlock(&items -> lock);
+
+    if(item >= items -> number)
+      break;
+
+    items -> compute(items -> data, item);
+  }
+  return NULL;
+}
+
+static void computeTile(void *data, int tile) {
+  pairsTiles *tiles = (pairsTiles *) data;
+  int row, column;
+
+  row = tiles -> rows[tile];
+  column = tiles -> columns[tile];
+  tiles -> compute(tiles -> data, row, (row + PAIRSTILE < tiles -> elements) ? row + PAIRSTILE : tiles -> elements,
+                   column, (column + PAIRSTILE < tiles -> elements) ? column + PAIRSTILE : tiles -> elements);
+}
+
+void threadPool::computePairs(int elements, int threads, tileFunction compute, void *data) {
+
+  pairsTiles tiles;
+  int i, j, side, number;
+
+  /* List the tiles in the upper triangle, row by row */
+  side = (elements + PAIRSTILE - 1) / PAIRSTILE;
+  number = side * (side + 1) / 2;
+  tiles.rows = new int[number];
+  tiles.columns = new int[number];
+  for(i = 0, number = 0; i < side; i++)
+    for(j = i; j < side; j++, number++) {
+      tiles.rows[number] = i * PAIRSTILE;
+      tiles.columns[number] = j * PAIRSTILE;
+    }
+
+  tiles.elements = elements;
+  tiles.compute = compute;
+  tiles.data = data;
+
+  computeItems(number, threads, computeTile, &tiles);
+
+  delete [] tiles.rows;
+  delete [] tiles.columns;
+}
+
+void threadPool::computeItems(int items, int threads, itemFunction compute, void *data) {
+
+  pthread_t *workers;
+  pendingItems pending;
+  int i, started;
+
+  pending.next = 0;
+  pending.number = items;
+  pending.compute = compute;
+  pending.data = data;
+  pthread_mutex_init(&pending.lock, NULL);
+
+  /* The calling thread computes items as well, so a single thread never
+   * starts any other. If a thread can not be started, the remaining ones
+   * take its share */
+  if(threads < 1)
+    threads = 1;
+  workers = new pthread_t[threads];
+  for(i = 0, started = 0; i < threads - 1; i++)
+    if(pthread_create(&workers[started], NULL, takeItems, &pending) == 0)
+      started++;
+
+  takeItems(&pending);
+
+  for(i = 0; i < started; i++)
+    pthread_join(workers[i], NULL);
+
+  pthread_mutex_destroy(&pending.lock);
+  delete [] workers;
+}
@@ -0,0 +1,80 @@
+/* ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** *****
+   ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** *****
+
+    trimAl v1.5.0: a tool for automated alignment trimming in large-scale
+                 phylogenetics analyses.
+
+    readAl v1.5.0: a tool for automated alignment conversion among different
+                 formats.
+
+    2009-2020
+        Fernandez-Rodriguez V.  (victor.fernandez@bsc.es)
+        Capella-Gutierrez S.    (salvador.capella@bsc.es)
+        Gabaldon, T.            (tgabaldon@bsc.es)
+
+    This file is part of trimAl/readAl.
+
+    trimAl/readAl are free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, the last available version.
+
+    trimAl/readAl are distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with trimAl/readAl. If not, see <http://www.gnu.org/licenses/>.
+
+***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** *****
+***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** */
+
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+/** \brief Class to share pairwise computations among several threads.
+ *
+ * The upper triangle of a square matrix is split into tiles of PAIRSTILE
+ * rows by PAIRSTILE columns, small enough to keep the rows compared by a
+ * tile in cache. Threads take the tiles one by one until none is left.
+ * Every matrix cell is computed by a single tile, so results do not depend
+ * on the number of threads. Any other set of independent items can be
+ * shared among threads the same way.
+ */
+
+class threadPool {
+
+  public:
+
+  /** \brief Tile computing function.
+   *
+   * It receives the data shared by all the tiles and the tile ranges of
+   * rows [firstRow, lastRow) and columns [firstColumn, lastColumn). Only
+   * pairs with a column greater than its row have to be computed.
+   */
+  typedef void (*tileFunction)(void *data, int firstRow, int lastRow, int firstColumn, int lastColumn);
+
+  /** \brief Pairwise computation method.
+   * \param elements Number of matrix rows and columns.
+   * \param threads Number of threads to use.
+   * \param compute Function to call for each tile.
+   * \param data Data shared by all the tiles.
+   */
+  static void computePairs(int elements, int threads, tileFunction compute, void *data);
+
+  /** \brief Item computing function.
+   *
+   * It receives the data shared by all the items and the item to compute.
+   */
+  typedef void (*itemFunction)(void *data, int item);
+
+  /** \brief Items computation method.
+   * \param items Number of items, from 0 to items - 1.
+   * \param threads Number of threads to use.
+   * \param compute Function to call for each item.
+   * \param data Data shared by all the items.
+   */
+  static void computeItems(int items, int threads, itemFunction compute, void *data);
+};
+
+#endif
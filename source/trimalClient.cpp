@@ -0,0 +1,215 @@
+/* ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** *****
+   ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** *****
+
+    trimAl v1.5.0: a tool for automated alignment trimming in large-scale
+                 phylogenetics analyses.
+
+    2009-2020
+        Fernandez-Rodriguez V.  (victor.fernandez@bsc.es)
+        Capella-Gutierrez S.    (salvador.capella@bsc.es)
+        Gabaldon, T.            (tgabaldon@bsc.es)
+
+    This file is part of trimAl.
+
+    trimAl is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, the last available version.
+
+    trimAl is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with trimAl. If not, see <http://www.gnu.org/licenses/>.
+
+***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** *****
+***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** */
+
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <stdlib.h>
+#include <limits.h>
+#include <string.h>
+
+#include "compressedBuffer.h"
+#include "localChannel.h"
+#include "defines.h"
+
+using namespace std;
+
+void menu(void);
+
+/* Client for the trimAl server mode. It sends an alignment and the trimming
+ * options to a server listening on a local socket and writes back what the
+ * server answers, as trimAl itself would have done */
+int main(int argc, char *argv[]) {
+
+  char *socketPath = NULL, *infile = NULL, *outfile = NULL;
+  bool stop = false, errors = false;
+  vector<char *> options;
+  string data, output, messages;
+  compressedBuffer packedFile;
+  ostream target(NULL);
+  ifstream input;
+  ofstream file;
+  ostringstream content;
+  int i, channel, compression;
+  long code;
+
+  if((argc == 1) || ((argc == 2) && (!strcmp(argv[1], "-h")))) {
+    menu();
+    return 0;
+  }
+
+  /* The socket path, the input content and the output file are handled by
+   * the client. Every other option is sent to the server */
+  for(i = 1; i < argc; i++) {
+    if(!strcmp(argv[i], "-socket") && (i+1 != argc) && (socketPath == NULL))
+      socketPath = argv[++i];
+
+    else if(!strcmp(argv[i], "-out") && (i+1 != argc) && (outfile == NULL))
+      outfile = argv[++i];
+
+    else if(!strcmp(argv[i], "-stop") && (!stop))
+      stop = true;
+
+    else {
+      if(!strcmp(argv[i], "-in") && (i+1 != argc) && (infile == NULL))
+        infile = argv[i+1];
+      options.push_back(argv[i]);
+    }
+  }
+
+  if(socketPath == NULL) {
+    cerr << endl << "ERROR: The server socket has to be defined." << endl << endl;
+    errors = true;
+  }
+
+  else if((stop) && (options.size() != 0)) {
+    cerr << endl << "ERROR: No other option is allowed when the server is stopped." << endl << endl;
+    errors = true;
+  }
+
+  else if((!stop) && (infile == NULL)) {
+    cerr << endl << "ERROR: An input file has to be defined." << endl << endl;
+    errors = true;
+  }
+
+  /* The input content is sent as it is, so compressed files are inflated by
+   * the server. A single dash stands for the standard input */
+  if((!errors) && (infile != NULL)) {
+    if(!strcmp(infile, "-"))
+      content << cin.rdbuf();
+    else {
+      input.open(infile, ifstream::in | ifstream::binary);
+      if((!input) || (!(content << input.rdbuf()))) {
+        cerr << endl << "ERROR: Alignment not loaded: \"" << infile << "\" Check the file's content." << endl << endl;
+        errors = true;
+      }
+      input.close();
+    }
+    data = content.str();
+  }
+
+  if(errors)
+    return -1;
+
+  channel = localChannel::connectTo(socketPath);
+  if(channel == -1) {
+    cerr << endl << "ERROR: There is not any trimAl server listening on \"" << socketPath << "\"." << endl << endl;
+    return -1;
+  }
+
+  /* ***** ***** ***** ***** ***** ***** ***** ***** */
+  /* Send the request and wait for its answer */
+  errors = !localChannel::sendNumber(channel, (long) options.size());
+  for(i = 0; (i < (int) options.size()) && (!errors); i++)
+    errors = !localChannel::sendField(channel, options[i], (long) strlen(options[i]));
+  if(!errors)
+    errors = !localChannel::sendField(channel, data.data(), (long) data.size());
+
+  if(!errors)
+    errors = !(localChannel::receiveNumber(channel, &code) &&
+      localChannel::receiveField(channel, output, LONG_MAX) &&
+      localChannel::receiveField(channel, messages, LONG_MAX));
+  localChannel::close(channel);
+
+  if(errors) {
+    cerr << endl << "ERROR: The trimAl server has not answered the request." << endl << endl;
+    return -1;
+  }
+  /* ***** ***** ***** ***** ***** ***** ***** ***** */
+
+  /* ***** ***** ***** ***** ***** ***** ***** ***** */
+  /* Write the answer. The output file is compressed
+   * depending on its extension, as trimAl does */
+  cerr << messages;
+
+  if((outfile == NULL) || (!strcmp(outfile, "-")))
+    cout << output;
+
+  else if(output.size() != 0) {
+    compression = compressedBuffer::compressionByName(outfile);
+    if(compression != NOCOMPRESSION) {
+      if((!compressedBuffer::isSupported(compression)) || (!packedFile.open(outfile, compression)))
+        errors = true;
+      target.rdbuf(&packedFile);
+    }
+    else {
+      file.open(outfile, ofstream::out | ofstream::binary);
+      errors = !file;
+      target.rdbuf(file.rdbuf());
+    }
+
+    if(!errors) {
+      target << output;
+      if(compression != NOCOMPRESSION)
+        errors = !packedFile.close();
+      else {
+        file.close();
+        errors = file.fail();
+      }
+    }
+
+    if(errors) {
+      cerr << endl << "ERROR: Impossible to generate OUTPUT file." << endl << endl;
+      return -1;
+    }
+  }
+  /* ***** ***** ***** ***** ***** ***** ***** ***** */
+
+  return (int) code;
+}
+
+void menu(void) {
+
+  cout << endl
+    << "trimAl client v" << VERSION << ".rev" << REVISION << " build[" << BUILD
+    << "]. " << AUTHORS << endl << endl
+
+    << "Basic usage" << endl
+    << "\ttrimalclient -socket <socket> -in <inputfile> -out <outputfile> "
+    << "[trimAl options]." << endl
+    << "\ttrimalclient -socket <socket> -stop" << endl << endl
+
+    << "\t-h                   " << "Show this information." << endl << endl
+
+    << "\t-socket <socket>     " << "Socket where a server started by "
+    << "'trimal --serve <socket>' listens." << endl
+    << "\t-in <inputfile>      " << "Input alignment, sent to the server. Use "
+    << "'-' for STDIN." << endl
+    << "\t-out <outputfile>    " << "Output file name (default STDOUT). It is "
+    << "compressed when it ends with '.gz' or '.zst'." << endl
+    << "\t-stop                " << "Stop the server." << endl << endl
+
+    << "Any other option is sent to the server, which trims the alignment as "
+    << "trimAl would." << endl
+    << "Options writing other files, such as -htmlout, or reading them, such "
+    << "as -compareset," << endl
+    << "are not available." << endl << endl;
+}
@@ -0,0 +1,118 @@
+/* ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** *****
+   ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** *****
+
+    trimAl v1.5.0: a tool for automated alignment trimming in large-scale
+                 phylogenetics analyses.
+
+    2009-2020
+        Fernandez-Rodriguez V.  (victor.fernandez@bsc.es)
+        Capella-Gutierrez S.    (salvador.capella@bsc.es)
+        Gabaldon, T.            (tgabaldon@bsc.es)
+
+    This file is part of trimAl.
+
+    trimAl is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, the last available version.
+
+    trimAl is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with trimAl. If not, see <http://www.gnu.org/licenses/>.
+
+***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** *****
+***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** ***** */
+
+
+#ifndef TRIMALLIBRARY_H
+#define TRIMALLIBRARY_H
+
+#include <pthread.h>
+
+#include "alignment.h"
+#include "defines.h"
+
+using namespace std;
+
+/** \brief Class to trim alignments from other programs.
+ *
+ * It trims alignments taking the same options as the trimAl command line,
+ * which is built on it, but alignments may be given and taken back in
+ * memory, so neither temporary files nor new processes are needed. The
+ * default similarity matrices are built once and shared by every alignment
+ * trimmed through the same object, which can be used by several threads at
+ * the same time. Errors and warnings are written to the standard error, as
+ * the command line does.
+ */
+
+class trimalLibrary {
+
+  pthread_mutex_t lock;
+
+  /* Default similarity matrices for each data type, built when first needed */
+  similarityMatrix *matrices[RNADeg + 1];
+
+  /* Trim an alignment loaded from its -in file, from the given content or
+   * copied from the given alignment. The trimmed alignment is either saved,
+   * printed or given back */
+  int process(int argc, char *argv[], const char *data, long size, alignment *input, alignment **output, bool reportFailures);
+
+  /* Get the default similarity matrix for a data type */
+  similarityMatrix *getDefaultMatrix(int alignDataType);
+
+  public:
+
+  /** \brief Constructor.
+   *
+   * Matrices are not built until some alignment needs them.
+   */
+  trimalLibrary(void);
+
+  /** \brief Destructor.
+   *
+   * Destruction method that frees previously allocated memory.
+   */
+  ~trimalLibrary(void);
+
+  /** \brief Command line running method.
+   * \param argc Number of arguments.
+   * \param argv Arguments, the first one being the program name.
+   * \return Exit code of the trimAl command line with these arguments.
+   */
+  int run(int argc, char *argv[]);
+
+  /** \brief Alignment trimming method.
+   * \param argc Number of arguments.
+   * \param argv Arguments, the first one being the program name.
+   * \return \e true if the alignment has been trimmed, \e false if there were errors.
+   *
+   * Unlike the command line, any error, e.g. an output file which could not
+   * be written, is reported.
+   */
+  bool trim(int argc, char *argv[]);
+
+  /** \brief In-memory alignment trimming method.
+   * \param argc Number of arguments.
+   * \param argv Arguments, the first one being the program name.
+   * \param data Content of the alignment named by the -in option.
+   * \param size Alignment content size.
+   * \return \e true if the alignment has been trimmed, \e false if there were errors.
+   */
+  bool trim(int argc, char *argv[], const char *data, long size);
+
+  /** \brief Alignment object trimming method.
+   * \param input Alignment to be trimmed. It is not modified.
+   * \param argc Number of arguments.
+   * \param argv Arguments, the first one being the program name. Neither -in nor -out should be used.
+   * \return Trimmed alignment, to be deleted by the caller, or NULL if there were errors.
+   *
+   * Statistics and the column numbering, if asked for, are printed to the
+   * standard output.
+   */
+  alignment *trimAlignment(alignment *input, int argc, char *argv[]);
+};
+
+#endif
@@ -156,6 +156,80 @@ double utils::min(double x, double y) {
   else      return y;
 }
 
+/*+++++++++++++++++++++++++++++++++++++++++++
+| long utils::triangleOffset(int, int)      |
+|      This method returns the offset of    |
+|      a row in a packed upper triangle.    |
++++++++++++++++++++++++++++++++++++++++++++*/
+
+long utils::triangleOffset(int row, int elements) {
+
+  /* Elements of the previous rows, minus the ones skipped in this row */
+  return (long) row * (2 * (long) elements - row - 1) / 2 - row - 1;
+}
+
+/*+++++++++++++++++++++++++++++++++++++++++++
+| void utils::windowSums(int *, int, int,   |
+|                        int *)             |
+|      This method computes the sum of the  |
+|      mirrored window of every position    |
+|      from the vector prefix sums.         |
++++++++++++++++++++++++++++++++++++++++++++*/
+
+void utils::windowSums(const int *values, int columns, int halfWindow, int *sums) {
+
+  long *prefix;
+  long sum;
+  int i;
+
+  /* prefix[i] stores the sum of the values before the i position */
+  prefix = new long[columns + 1];
+  for(i = 0, prefix[0] = 0; i < columns; i++)
+    prefix[i + 1] = prefix[i] + values[i];
+
+  for(i = 0; i < columns; i++) {
+    /* Positions of the window inside the vector */
+    sum = prefix[min(i + halfWindow, columns - 1) + 1] - prefix[max(i - halfWindow, 0)];
+
+    /* Positions before the vector start are mirrored from 1 to halfWindow - i */
+    if(i < halfWindow)
+      sum += prefix[halfWindow - i + 1] - prefix[1];
+
+    /* Positions after the vector end are mirrored backwards from columns - 2 */
+    if(i + halfWindow >= columns)
+      sum += prefix[columns - 1] - prefix[2 * columns - i - halfWindow - 2];
+
+    sums[i] = (int) sum;
+  }
+
+  delete [] prefix;
+}
+
+/*+++++++++++++++++++++++++++++++++++++++++++
+| void utils::windowAverages(float *, int,  |
+|                            int, float *)  |
+|      This method computes the average of  |
+|      the mirrored window of every         |
+|      position.                            |
++++++++++++++++++++++++++++++++++++++++++++*/
+
+void utils::windowAverages(const float *values, int columns, int halfWindow, float *averages) {
+
+  int i, j, window;
+
+  window = 2 * halfWindow + 1;
+
+  for(i = 0; i < columns; i++) {
+    for(j = i - halfWindow, averages[i] = 0; j <= i + halfWindow; j++) {
+      if(j < 0) averages[i] += values[-j];
+      else if(j >= columns) averages[i] += values[((2 * columns - j) - 2)];
+      else averages[i] += values[j];
+    }
+
+    averages[i] = averages[i] / (float) window;
+  }
+}
+
 /*+++++++++++++++++++++++++++++++++++++++++++
 | bool utils::isNumber(char *)              |
 |      This method checks if the given      |
@@ -416,7 +490,7 @@ char* utils::readLine(ifstream &file) {
   int state;
   char c = ' ';
   string nline;
-  static char *line = NULL;
+  char *line = NULL;
 
   /* Check it the end of the file has been reached or not */
   if(file.eof())
@@ -458,7 +532,7 @@ char* utils::trimLine(string nline) {
    * mismatch for these flags is found */
 
   int pos, next;
-  static char *line;
+  char *line;
 
   /* Set-up lower and upper limit to look for comments inside of input string */
   pos = -1;
@@ -640,7 +714,7 @@ int utils::checkTypeAlignment(int seqNumber, int residNumber, string *sequences)
 int* utils::readNumbers_StartEnd(string line) {
 
   int comma, nElems = 0;
-  static int *numbers;
+  int *numbers;
 
  comma = -1;
   while((comma = line.find(",", comma + 1)) != (int) string::npos)
@@ -662,7 +736,7 @@ int* utils::readNumbers_StartEnd(string line) {
 int* utils::readNumbers(string line) {
 
   int i, comma, separ, init, nElems = 0;
-  static int *numbers;
+  int *numbers;
 
   /* ***** ***** ***** ***** ***** ***** ***** ***** */
  comma = -1;
@@ -719,7 +793,7 @@ int* utils::readNumbers(string line) {
 }
 
 
-char utils::determineColor(char res, string column) {
+char utils::determineColor(char res, const string &column) {
 
   /* ***** ***** ***** ***** ***** ***** ***** ***** ***** */
   if(toupper(res) == 'G')
@@ -832,7 +906,7 @@ char utils::determineColor(char res, string column) {
 }
 
 
-bool utils::lookForPattern(string column, string dataset, float level) {
+bool utils::lookForPattern(const string &column, const string &dataset, float level) {
 
   float count = 0;
   int i, j;
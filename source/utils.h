@@ -119,6 +119,39 @@ class utils {
 
   static double min(double x, double y);
 
+  /** \brief Packed upper triangle row offset.
+   * \param row The matrix row.
+   * \param elements The number of rows, and columns, of the matrix.
+   * \return Offset to add to a column, greater than the row, to get its position.
+   *
+   * This method returns where the elements of a matrix row are found when its upper triangle, without the diagonal,
+   * is packed row by row in a single vector.
+   */
+  static long triangleOffset(int row, int elements);
+
+  /** \brief Integer window sums method.
+   * \param values The vector of values.
+   * \param columns The size of the vector.
+   * \param halfWindow The half window size, not greater than a quarter of the vector size.
+   * \param sums The vector where the window sum of every position will be stored.
+   *
+   * This method sums, for every position, the values of the window centered on it. Windows are mirrored at both ends
+   * of the vector. Sums are taken from the vector prefix sums, so their cost does not depend on the window size.
+   */
+  static void windowSums(const int *values, int columns, int halfWindow, int *sums);
+
+  /** \brief Float window averages method.
+   * \param values The vector of values.
+   * \param columns The size of the vector.
+   * \param halfWindow The half window size, not greater than a quarter of the vector size.
+   * \param averages The vector where the window average of every position will be stored.
+   *
+   * This method averages, for every position, the values of the window centered on it. Windows are mirrored at both
+   * ends of the vector. Values are added one by one, from the first position of the window to the last one, since
+   * a different order could change the rounding of the averages.
+   */
+  static void windowAverages(const float *values, int columns, int halfWindow, float *averages);
+
   // static bool getArg(int argc, char *argv[], int *var, char *argument, char *abrevArg);
   /** \brief String-is-number checking.
    * \param num The string we want to check.
@@ -201,9 +234,9 @@ class utils {
 
   static void swap(int **, int **);
 
-  static char determineColor(char res, string column);
+  static char determineColor(char res, const string &column);
 
-  static bool lookForPattern(string, string, float);
+  static bool lookForPattern(const string &, const string &, float);
 
 };
 #endif